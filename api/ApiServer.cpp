@@ -18,9 +18,15 @@
 #include "../core/TaskRegistry.h"
 #include "../utils/Logger.h"
 #include "../utils/Metrics.h"
+#include "../utils/ResultCache.h"
+#include "../utils/RuntimeEstimator.h"
+#include "../utils/TraceRecorder.h"
 #include "../utils/Config.h"
 #include "../core/TaskDefinition.h"
 #include "../src/core/Task.h"
+#include "../src/scheduler/SchedulerFactory.h"
+#include "../src/scheduler/CircuitBreaker.h"
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <ctime>
@@ -32,11 +38,275 @@ using json = nlohmann::json;
 // Using a type alias to explicitly refer to the global Logger class
 using AppLogger = class Logger;
 
-ApiServer::ApiServer(std::shared_ptr<ThreadPool> pool, int port)
-    : threadPool(pool), port(port), running(false) {
+// Path IDs match \d+ but can still overflow int
+static bool parsePathId(const std::string& text, int& id) {
+    try {
+        id = std::stoi(text);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+// Per-queue depth, wait and throughput
+static json queueMetricsJson(const QueueRegistry& queues) {
+    json queuesJson = json::object();
+    for (const auto& entry : queues.list()) {
+        auto stats = entry.second->getStats();
+        queuesJson[entry.first] = {
+            {"threads", stats.workers},
+            {"busy", stats.busy},
+            {"depth", stats.queued},
+            {"delayed", stats.delayed},
+            {"submitted", stats.submitted},
+            {"completed", stats.completed},
+            {"failed", stats.failed},
+            {"coalesced", stats.coalesced},
+            {"cached", stats.cached},
+            {"cancelled", stats.cancelled},
+            {"avg_wait_ms", stats.avgWaitMs},
+            {"throughput_per_sec", stats.throughputPerSec}
+        };
+    }
+    return queuesJson;
+}
+
+static json resultCacheJson() {
+    auto stats = ResultCache::instance().getStats();
+    return {
+        {"hits", stats.hits},
+        {"misses", stats.misses},
+        {"hit_ratio", stats.hitRatio()},
+        {"entries", stats.entries},
+        {"bytes", stats.bytes},
+        {"evictions", stats.evictions},
+        {"rejections", stats.rejections}
+    };
+}
+
+static json percentilesJson(const HistogramSnapshot& h) {
+    return {
+        {"count", h.count},
+        {"mean_ms", h.mean() / 1000.0},
+        {"p50_ms", h.percentile(0.50) / 1000.0},
+        {"p90_ms", h.percentile(0.90) / 1000.0},
+        {"p99_ms", h.percentile(0.99) / 1000.0},
+        {"p999_ms", h.percentile(0.999) / 1000.0},
+        {"max_ms", h.max / 1000.0}
+    };
+}
+
+static json latencySliceJson(const LatencyHistograms& slice) {
+    return {
+        {"wait", percentilesJson(slice.wait)},
+        {"exec", percentilesJson(slice.exec)},
+        {"end_to_end", percentilesJson(slice.endToEnd)}
+    };
+}
+
+// Wait, exec and end-to-end percentiles, overall and per priority / type
+static json latencyJson() {
+    LatencyReport report = Metrics::instance().getLatencyReport();
+    json byPriority = json::object();
+    for (const auto& [priority, slice] : report.byPriority) {
+        byPriority[priority] = latencySliceJson(slice);
+    }
+    json byType = json::object();
+    for (const auto& [type, slice] : report.byType) {
+        byType[type] = latencySliceJson(slice);
+    }
+    json latency = latencySliceJson(report.overall);
+    latency["by_priority"] = byPriority;
+    latency["by_type"] = byType;
+    return latency;
+}
+
+static json windowRatesJson(const WindowRates& rates) {
+    return {
+        {"1m", rates.oneMinute},
+        {"5m", rates.fiveMinutes},
+        {"15m", rates.fifteenMinutes}
+    };
+}
+
+// Per-second rates over the trailing 1/5/15 minutes, and the share of
+// finished tasks that failed in each window
+static json ratesJson() {
+    ThroughputRates rates = Metrics::instance().getRates();
+    auto errorRatio = [](double failed, double completed) {
+        return failed + completed > 0.0 ? failed / (failed + completed) : 0.0;
+    };
+    return {
+        {"submitted", windowRatesJson(rates.submitted)},
+        {"started", windowRatesJson(rates.started)},
+        {"completed", windowRatesJson(rates.completed)},
+        {"failed", windowRatesJson(rates.failed)},
+        {"retried", windowRatesJson(rates.retried)},
+        {"error_ratio", {
+            {"1m", errorRatio(rates.failed.oneMinute, rates.completed.oneMinute)},
+            {"5m", errorRatio(rates.failed.fiveMinutes, rates.completed.fiveMinutes)},
+            {"15m", errorRatio(rates.failed.fifteenMinutes, rates.completed.fifteenMinutes)}
+        }}
+    };
+}
+
+// Outcomes and latency per (type, tenant, priority), with the key budget
+static json keyBreakdownJson() {
+    KeyBreakdown breakdown = Metrics::instance().getKeyBreakdown();
+    json keysJson = json::array();
+    for (const auto& key : breakdown.keys) {
+        std::string priority = "MEDIUM";
+        if (key.priority == TaskPriority::HIGH) priority = "HIGH";
+        else if (key.priority == TaskPriority::LOW) priority = "LOW";
+
+        json keyJson = latencySliceJson(key.latency);
+        keyJson["type"] = key.type;
+        keyJson["tenant"] = key.tenant;
+        keyJson["priority"] = priority;
+        keyJson["count"] = key.latency.exec.count;
+        keyJson["completed"] = key.completed;
+        keyJson["failed"] = key.failed;
+        keyJson["retries"] = key.retries;
+        keysJson.push_back(keyJson);
+    }
+    return {
+        {"max_keys", breakdown.maxKeys},
+        {"distinct_keys", breakdown.distinctKeys},
+        {"overflowed", breakdown.overflowed},
+        {"keys", keysJson}
+    };
+}
+
+static const char* traceOutcomeName(TraceOutcome outcome) {
+    switch (outcome) {
+        case TraceOutcome::FAILED: return "failed";
+        case TraceOutcome::RETRIED: return "retried";
+        default: return "completed";
+    }
+}
+
+// Chrome Trace Event JSON for Perfetto / chrome://tracing: a track per
+// worker with one slice per attempt, and each attempt's queue wait (enqueue
+// -> start) as an async span, so occupancy and gaps show side by side
+static json traceJson(std::chrono::seconds window) {
+    json events = json::array();
+    events.push_back({{"name", "process_name"}, {"ph", "M"}, {"pid", 1},
+                      {"args", {{"name", "taskweave"}}}});
+    for (const auto& thread : TraceRecorder::instance().collect(window)) {
+        events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", thread.tid},
+                          {"args", {{"name", "worker " + std::to_string(thread.tid)}}}});
+        for (const auto& event : thread.events) {
+            std::string type = event.key && !event.key->type.empty() ? event.key->type : "task";
+            std::string priority = "MEDIUM";
+            if (event.priority == TaskPriority::HIGH) priority = "HIGH";
+            else if (event.priority == TaskPriority::LOW) priority = "LOW";
+
+            json args = {
+                {"id", event.taskId},
+                {"attempt", event.attempt},
+                {"priority", priority},
+                {"outcome", traceOutcomeName(event.outcome)}
+            };
+            if (event.key && !event.key->tenant.empty()) {
+                args["tenant"] = event.key->tenant;
+            }
+            events.push_back({{"name", type}, {"cat", "task"}, {"ph", "X"}, {"pid", 1},
+                              {"tid", thread.tid}, {"ts", event.startUs},
+                              {"dur", std::max<std::int64_t>(0, event.endUs - event.startUs)},
+                              {"args", args}});
+
+            const std::string waitId = std::to_string(event.taskId) + "." + std::to_string(event.attempt);
+            events.push_back({{"name", "wait"}, {"cat", "queue"}, {"ph", "b"}, {"id", waitId},
+                              {"pid", 1}, {"tid", thread.tid}, {"ts", event.enqueueUs},
+                              {"args", {{"id", event.taskId}, {"type", type}}}});
+            events.push_back({{"name", "wait"}, {"cat", "queue"}, {"ph", "e"}, {"id", waitId},
+                              {"pid", 1}, {"tid", thread.tid}, {"ts", event.startUs}});
+            if (event.outcome == TraceOutcome::RETRIED) {
+                events.push_back({{"name", "retry"}, {"cat", "task"}, {"ph", "i"}, {"s", "t"},
+                                  {"pid", 1}, {"tid", thread.tid}, {"ts", event.endUs},
+                                  {"args", {{"id", event.taskId}}}});
+            }
+        }
+    }
+    return {{"traceEvents", events}, {"displayTimeUnit", "ms"}};
+}
+
+// Memory-resident tasks, spills to the database and where lookups landed
+static json registryJson() {
+    auto stats = TaskRegistry::instance().getStats();
+    return {
+        {"hot", stats.hot},
+        {"spilled", stats.spilled},
+        {"dropped", stats.dropped},
+        {"hot_hits", stats.hotHits},
+        {"hot_misses", stats.hotMisses},
+        {"hot_hit_ratio", stats.hotHitRatio()},
+        {"cold_hits", stats.coldHits},
+        {"cold_misses", stats.coldMisses},
+        {"cold_hit_ratio", stats.coldHitRatio()}
+    };
+}
+
+// Breaker state per task type, with the latest transition
+static json circuitBreakersJson() {
+    json breakersJson = json::object();
+    auto now = std::chrono::steady_clock::now();
+    for (const auto& [type, stats] : CircuitBreakerRegistry::instance().getStats()) {
+        json entry = {
+            {"state", toString(stats.state)},
+            {"failure_rate", stats.failureRate},
+            {"window_calls", stats.windowCalls},
+            {"opened", stats.opened},
+            {"closed", stats.closed}
+        };
+        if (!stats.lastTransition.empty()) {
+            entry["last_transition"] = stats.lastTransition;
+            entry["last_transition_ms_ago"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+                now - stats.lastTransitionAt).count();
+        }
+        breakersJson[type] = entry;
+    }
+    return breakersJson;
+}
+
+static json recurringJobToJson(const RecurringJob& job) {
+    auto stats = job.getStats();
+    auto untilNext = std::chrono::duration_cast<std::chrono::milliseconds>(
+        job.getNextDue() - std::chrono::steady_clock::now()).count();
+
+    return {
+        {"id", job.getId()},
+        {"type", job.getDefinition().type},
+        {"schedule", job.describeSchedule()},
+        {"overlap", job.getDefinition().overlap},
+        {"catch_up", job.getDefinition().catchUp},
+        {"next_run_in_ms", untilNext > 0 ? untilNext : 0},
+        {"released", stats.released},
+        {"completed", stats.completed},
+        {"failed", stats.failed},
+        {"dropped", stats.dropped},
+        {"in_flight", stats.inFlight},
+        {"queued", stats.queued},
+        {"skipped_overlap", stats.skippedOverlap},
+        {"missed", stats.missed},
+        {"avg_wait_ms", stats.ran > 0 ? stats.totalWaitMs / stats.ran : 0.0},
+        {"max_wait_ms", stats.maxWaitMs},
+        {"avg_exec_ms", stats.ran > 0 ? stats.totalExecMs / stats.ran : 0.0},
+        {"max_exec_ms", stats.maxExecMs}
+    };
+}
+
+ApiServer::ApiServer(std::shared_ptr<QueueRegistry> queues, int port,
+                     std::shared_ptr<RecurringJobManager> recurring)
+    : queues(queues), threadPool(queues->getDefault()), recurringJobs(recurring),
+      port(port), running(false) {
     Config& cfg = Config::instance();
     maxRequestSize = cfg.getMaxRequestSize();
     corsOrigin = cfg.getCorsOrigin();
+    serverAssignedIds = cfg.isServerAssignedIds();
+    for (const auto& entry : queues->list()) {
+        appliedSchedulers[entry.first] = SchedulerFactory::describe(cfg, cfg.getQueueScheduler(entry.first));
+    }
     server = std::make_unique<httplib::Server>();
 }
 
@@ -44,9 +314,84 @@ ApiServer::~ApiServer() {
     stop();
 }
 
+void ApiServer::reloadConfig() {
+    std::lock_guard<std::mutex> lock(adminMtx);
+    AppLogger::info("Reloading configuration");
+    Config& cfg = Config::instance();
+    cfg.reload();
+    ResultCache::instance().configure(static_cast<size_t>(cfg.getResultCacheCapacity()),
+                                      std::chrono::milliseconds(cfg.getResultCacheTtlMs()),
+                                      cfg.getResultCacheTypes());
+    CircuitBreakerRegistry::instance().configure(cfg.getCircuitBreaker());
+    RuntimeEstimator::instance().configure(cfg.getEstimatorAlpha(), cfg.isEstimatorPerParams());
+    TaskRegistry::instance().setRetention(static_cast<size_t>(cfg.getRegistryMaxFinished()));
+    TaskRegistry::instance().setSnapshotInterval(std::chrono::milliseconds(cfg.getSnapshotIntervalMs()));
+    Metrics::instance().setMaxKeys(static_cast<size_t>(cfg.getMetricsMaxKeys()));
+    TraceRecorder::instance().configure(cfg.isTraceEnabled(),
+                                        static_cast<size_t>(cfg.getTraceEventsPerThread()));
+    serverAssignedIds = cfg.isServerAssignedIds();
+    applyConfig();
+}
+
+void ApiServer::applyConfig() {
+    Config& cfg = Config::instance();
+    
+    std::vector<std::string> names{QueueRegistry::DEFAULT_QUEUE};
+    for (const auto& entry : cfg.getQueues()) {
+        names.push_back(entry.first);
+    }
+    
+    for (const auto& name : names) {
+        std::string policy = cfg.getQueueScheduler(name);
+        size_t threads = static_cast<size_t>(cfg.getQueueThreads(name));
+        std::string wanted = SchedulerFactory::describe(cfg, policy);
+        
+        auto pool = queues->get(name);
+        if (!pool) {
+            queues->add(name, std::make_shared<ThreadPool>(threads, SchedulerFactory::create(cfg, policy)));
+            appliedSchedulers[name] = wanted;
+            AppLogger::info("Queue '" + name + "' added: " + wanted);
+            continue;
+        }
+        
+        // Rebuild the scheduler only if its settings changed, so stateful
+        // policies (MLFQ history, CoDel, concurrency slots) are kept otherwise
+        if (wanted != appliedSchedulers[name]) {
+            pool->setScheduler(SchedulerFactory::create(cfg, policy));
+            AppLogger::info("Queue '" + name + "' scheduler switched: " +
+                            appliedSchedulers[name] + " -> " + wanted);
+            appliedSchedulers[name] = wanted;
+        }
+        if (threads != pool->getSize()) {
+            AppLogger::info("Queue '" + name + "' resized: " + std::to_string(pool->getSize()) +
+                            " -> " + std::to_string(threads));
+            pool->resize(threads);
+        }
+    }
+}
+
+std::string ApiServer::schedulerStateJson(const std::string& status) {
+    json queuesJson = json::object();
+    for (const auto& entry : queues->list()) {
+        queuesJson[entry.first] = {
+            {"scheduler", appliedSchedulers[entry.first]},
+            {"threads", entry.second->getSize()}
+        };
+    }
+    json stateJson = {
+        {"scheduler", appliedSchedulers[QueueRegistry::DEFAULT_QUEUE]},
+        {"threads", threadPool->getSize()},
+        {"queues", queuesJson}
+    };
+    if (!status.empty()) {
+        stateJson["status"] = status;
+    }
+    return stateJson.dump();
+}
+
 void ApiServer::setCorsHeaders(httplib::Response& res) {
     res.set_header("Access-Control-Allow-Origin", corsOrigin);
-    res.set_header("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
+    res.set_header("Access-Control-Allow-Methods", "GET, POST, PATCH, DELETE, OPTIONS");
     res.set_header("Access-Control-Allow-Headers", "Content-Type");
 }
 
@@ -108,65 +453,82 @@ void ApiServer::setupRoutes() {
         res.set_content(healthJson.dump(), "application/json");
     });
     
-    // Metrics endpoint
-    server->Get("/metrics", [this](const httplib::Request& /* req */, httplib::Response& res) {
-        auto tasks = TaskRegistry::instance().getAllTasks();
-        
-        int total = tasks.size();
-        int running = 0, completed = 0, failed = 0, pending = 0;
-        for (const auto& task : tasks) {
-            int state = static_cast<int>(task->getState());
-            if (state == 0) pending++;
-            else if (state == 2) running++;
-            else if (state == 3) completed++;
-            else if (state == 4) failed++;
-        }
+    // Metrics endpoint; state counts are O(1) reads of the registry's index
+    auto metricsHandler = [this](const httplib::Request& /* req */, httplib::Response& res) {
+        TaskRegistry& registry = TaskRegistry::instance();
         
         json metricsJson = {
-            {"total_tasks", total},
-            {"pending", pending},
-            {"running", running},
-            {"completed", completed},
-            {"failed", failed},
-            {"uptime_seconds", std::time(nullptr)},
-            {"thread_pool_size", threadPool->getSize()}
+            {"total_tasks", registry.size()},
+            {"pending", registry.countByState(TaskState::CREATED) +
+                        registry.countByState(TaskState::READY) +
+                        registry.countByState(TaskState::RETRYING)},
+            {"running", registry.countByState(TaskState::RUNNING)},
+            {"completed", registry.countByState(TaskState::COMPLETED)},
+            {"failed", registry.countByState(TaskState::FAILED)},
+            {"rejected", registry.countByState(TaskState::REJECTED)},
+            {"cancelled", registry.countByState(TaskState::CANCELLED)},
+            {"uptime_seconds", std::chrono::duration_cast<std::chrono::seconds>(
+                                   std::chrono::steady_clock::now() - startedAt).count()},
+            {"thread_pool_size", threadPool->getSize()},
+            {"queues", queueMetricsJson(*queues)},
+            {"rates", ratesJson()},
+            {"latency", latencyJson()},
+            {"result_cache", resultCacheJson()},
+            {"registry", registryJson()},
+            {"circuit_breakers", circuitBreakersJson()}
         };
         setCorsHeaders(res);
         res.set_content(metricsJson.dump(), "application/json");
+    };
+    server->Get("/metrics", metricsHandler);
+    server->Get("/api/metrics", metricsHandler);
+
+    // Per-key breakdown of counts, failures, retries and latency
+    server->Get("/metrics/breakdown", [this](const httplib::Request& /* req */, httplib::Response& res) {
+        setCorsHeaders(res);
+        res.set_content(keyBreakdownJson().dump(), "application/json");
     });
-    
-    server->Get("/api/metrics", [this](const httplib::Request& /* req */, httplib::Response& res) {
-        auto tasks = TaskRegistry::instance().getAllTasks();
-        
-        int total = tasks.size();
-        int running = 0, completed = 0, failed = 0, pending = 0;
-        for (const auto& task : tasks) {
-            int state = static_cast<int>(task->getState());
-            if (state == 0) pending++;
-            else if (state == 2) running++;
-            else if (state == 3) completed++;
-            else if (state == 4) failed++;
-        }
-        
-        json metricsJson = {
-            {"total_tasks", total},
-            {"pending", pending},
-            {"running", running},
-            {"completed", completed},
-            {"failed", failed},
-            {"uptime_seconds", std::time(nullptr)},
-            {"thread_pool_size", threadPool->getSize()}
-        };
+
+    // Chrome trace of the task attempts that ended in the last ?seconds=N
+    server->Get("/debug/trace", [this](const httplib::Request& req, httplib::Response& res) {
         setCorsHeaders(res);
-        res.set_content(metricsJson.dump(), "application/json");
+        if (!TraceRecorder::instance().isEnabled()) {
+            res.status = 409;
+            json errorJson = {{"error", "Tracing is disabled (set trace_enabled=true)"}};
+            res.set_content(errorJson.dump(), "application/json");
+            return;
+        }
+        int seconds = 10;
+        if (req.has_param("seconds")) {
+            try {
+                seconds = std::stoi(req.get_param_value("seconds"));
+            } catch (const std::exception&) {
+                seconds = 0;
+            }
+        }
+        if (seconds <= 0) {
+            res.status = 400;
+            json errorJson = {{"error", "seconds must be a positive integer"}};
+            res.set_content(errorJson.dump(), "application/json");
+            return;
+        }
+        res.set_content(traceJson(std::chrono::seconds(seconds)).dump(), "application/json");
+    });
+
+    // Prometheus text exposition of the same counters, gauges and latency
+    // histograms; scrapes are serialized so the exporter's buffer is reused,
+    // and the response takes one copy of it
+    server->Get("/metrics/prometheus", [this](const httplib::Request& /* req */, httplib::Response& res) {
+        std::lock_guard<std::mutex> lock(prometheusMtx);
+        res.set_content(prometheus.render(*queues), PrometheusExporter::CONTENT_TYPE);
     });
     
     // Get all tasks
     server->Get("/tasks", [this](const httplib::Request& /* req */, httplib::Response& res) {
-        auto tasks = TaskRegistry::instance().getAllTasks();
+        auto snapshot = TaskRegistry::instance().getSnapshot();
         json tasksArray = json::array();
         
-        for (const auto& task : tasks) {
+        for (const auto& task : snapshot->tasks) {
             // Get priority string
             std::string priority = "MEDIUM";
             if (task->getPriority() == TaskPriority::HIGH) priority = "HIGH";
@@ -182,6 +544,9 @@ void ApiServer::setupRoutes() {
                 {"type", "print"},
                 {"created_at", "2024-01-01 00:00:00"}
             };
+            if (task->getExternalId() != 0) {
+                taskJson["external_id"] = task->getExternalId();
+            }
             tasksArray.push_back(taskJson);
         }
         
@@ -195,6 +560,7 @@ void ApiServer::setupRoutes() {
         try {
             int taskId = std::stoi(req.matches[1]);
             auto task = TaskRegistry::instance().getTask(taskId);
+            TaskRecord record;
             if (task) {
                 json taskJson = {
                     {"id", task->getId()},
@@ -202,6 +568,21 @@ void ApiServer::setupRoutes() {
                     {"retry_count", task->getRetryCount()},
                     {"max_retries", task->getMaxRetries()}
                 };
+                if (task->getExternalId() != 0) {
+                    taskJson["external_id"] = task->getExternalId();
+                }
+                setCorsHeaders(res);
+                res.set_content(taskJson.dump(), "application/json");
+            } else if (TaskRegistry::instance().getArchivedTask(taskId, record)) {
+                // Finished long enough ago to have left memory
+                json taskJson = {
+                    {"id", record.id},
+                    {"state", record.state},
+                    {"retry_count", record.retry_count},
+                    {"max_retries", record.max_retries},
+                    {"completed_at", record.completed_at},
+                    {"archived", true}
+                };
                 setCorsHeaders(res);
                 res.set_content(taskJson.dump(), "application/json");
             } else {
@@ -218,6 +599,97 @@ void ApiServer::setupRoutes() {
         }
     });
     
+    // Cancel a task that is still queued
+    server->Delete(R"(/tasks/(\d+))", [this](const httplib::Request& req, httplib::Response& res) {
+        setCorsHeaders(res);
+        int taskId;
+        if (!parsePathId(req.matches[1], taskId)) {
+            res.status = 400;
+            json errorJson = {{"error", "Invalid task ID"}};
+            res.set_content(errorJson.dump(), "application/json");
+            return;
+        }
+        auto task = TaskRegistry::instance().getTask(taskId);
+        TaskRecord record;
+        if (!task && !TaskRegistry::instance().getArchivedTask(taskId, record)) {
+            res.status = 404;
+            json errorJson = {{"error", "Task not found"}};
+            res.set_content(errorJson.dump(), "application/json");
+            return;
+        }
+        
+        bool cancelled = false;
+        for (const auto& entry : queues->list()) {
+            cancelled = entry.second->cancel(taskId) || cancelled;
+        }
+        if (!cancelled) {
+            res.status = 409;
+            json errorJson = {{"error", "Task is not queued, or its scheduler cannot cancel tasks"}};
+            res.set_content(errorJson.dump(), "application/json");
+            return;
+        }
+        
+        json successJson = {{"status", "cancelled"}, {"task_id", taskId}};
+        res.set_content(successJson.dump(), "application/json");
+        AppLogger::info("Task " + std::to_string(taskId) + " cancelled");
+    });
+    
+    // Change the priority of a task that is still queued: {"priority": "HIGH"}
+    server->Patch(R"(/tasks/(\d+))", [this](const httplib::Request& req, httplib::Response& res) {
+        setCorsHeaders(res);
+        int taskId;
+        if (!parsePathId(req.matches[1], taskId)) {
+            res.status = 400;
+            json errorJson = {{"error", "Invalid task ID"}};
+            res.set_content(errorJson.dump(), "application/json");
+            return;
+        }
+        
+        std::string value;
+        TaskPriority priority;
+        try {
+            json body = json::parse(req.body);
+            value = body.at("priority").get<std::string>();
+            if (value == "HIGH") priority = TaskPriority::HIGH;
+            else if (value == "MEDIUM") priority = TaskPriority::MEDIUM;
+            else if (value == "LOW") priority = TaskPriority::LOW;
+            else throw std::invalid_argument(value);
+        } catch (const std::exception&) {
+            res.status = 400;
+            json errorJson = {{"error", "Body must be {\"priority\": \"HIGH\" | \"MEDIUM\" | \"LOW\"}"}};
+            res.set_content(errorJson.dump(), "application/json");
+            return;
+        }
+        
+        auto task = TaskRegistry::instance().getTask(taskId);
+        TaskRecord record;
+        if (!task && !TaskRegistry::instance().getArchivedTask(taskId, record)) {
+            res.status = 404;
+            json errorJson = {{"error", "Task not found"}};
+            res.set_content(errorJson.dump(), "application/json");
+            return;
+        }
+        
+        bool updated = false;
+        for (const auto& entry : queues->list()) {
+            updated = entry.second->reprioritize(taskId, priority) || updated;
+        }
+        if (!updated) {
+            res.status = 409;
+            json errorJson = {{"error", "Task is not queued, or its scheduler cannot reorder tasks"}};
+            res.set_content(errorJson.dump(), "application/json");
+            return;
+        }
+        
+        json successJson = {
+            {"status", "reprioritized"},
+            {"task_id", taskId},
+            {"priority", value}
+        };
+        res.set_content(successJson.dump(), "application/json");
+        AppLogger::info("Task " + std::to_string(taskId) + " reprioritized");
+    });
+    
     // Submit task
     server->Post("/tasks", [this](const httplib::Request& req, httplib::Response& res) {
         // Check request size
@@ -231,13 +703,59 @@ void ApiServer::setupRoutes() {
         
         try {
             AppLogger::info("Received POST /tasks with body: " + req.body);
-            auto defs = TaskLoader::loadFromJsonString(req.body);
+            const bool serverIds = serverAssignedIds.load();
+            auto defs = TaskLoader::loadFromJsonString(req.body, serverIds);
             
             if (!defs.empty()) {
                 auto def = defs[0];
+                if (serverIds) {
+                    // The client's ID, if any, becomes an external key
+                    def.externalId = def.id;
+                    def.id = TaskRegistry::instance().allocateId();
+                }
+                
+                // Recurring definitions become jobs; each occurrence is a fresh task
+                if (def.isRecurring()) {
+                    std::string error;
+                    if (!recurringJobs) {
+                        error = "Recurring tasks are not enabled";
+                    } else if (recurringJobs->add(def, error)) {
+                        json successJson = {
+                            {"status", "scheduled"},
+                            {"task_id", def.id}
+                        };
+                        if (def.externalId != 0) {
+                            successJson["external_id"] = def.externalId;
+                        }
+                        setCorsHeaders(res);
+                        res.set_content(successJson.dump(), "application/json");
+                        return;
+                    }
+                    AppLogger::warn("Recurring task " + std::to_string(def.id) + " rejected: " + error);
+                    setCorsHeaders(res);
+                    res.status = (recurringJobs && recurringJobs->get(def.id)) ? 409 : 400;
+                    json errorJson = {{"error", error}};
+                    res.set_content(errorJson.dump(), "application/json");
+                    return;
+                }
                 
-                // Validate task ID is not already registered
-                if (TaskRegistry::instance().getTask(def.id) != nullptr) {
+                auto pool = queues->get(def.queue);
+                if (!pool) {
+                    setCorsHeaders(res);
+                    res.status = 400;
+                    json errorJson = {{"error", "Unknown queue: " + def.queue}};
+                    res.set_content(errorJson.dump(), "application/json");
+                    return;
+                }
+                
+                // Claim the ID before submitting: concurrent duplicates get 409
+                Task task = TaskLoader::createTask(def);
+                while (serverIds && !TaskRegistry::instance().registerTask(task)) {
+                    // A client-chosen ID took this one: draw the next
+                    def.id = TaskRegistry::instance().allocateId();
+                    task = TaskLoader::createTask(def);
+                }
+                if (!serverIds && !TaskRegistry::instance().registerTask(task)) {
                     AppLogger::warn("Task ID " + std::to_string(def.id) + " already exists");
                     setCorsHeaders(res);
                     res.status = 409;
@@ -246,14 +764,33 @@ void ApiServer::setupRoutes() {
                     return;
                 }
                 
-                Task task = TaskLoader::createTask(def);
-                TaskRegistry::instance().registerTask(task);
-                threadPool->submit(task);
+                int runningId = pool->submit(task);
+                if (runningId != def.id) {
+                    // Identical task already pending: attach to it; this ID never runs
+                    TaskRegistry::instance().removeTask(def.id);
+                    json coalescedJson = {
+                        {"status", "coalesced"},
+                        {"task_id", def.id},
+                        {"coalesced_into", runningId},
+                        {"queue", def.queue}
+                    };
+                    if (def.externalId != 0) {
+                        coalescedJson["external_id"] = def.externalId;
+                    }
+                    setCorsHeaders(res);
+                    res.set_content(coalescedJson.dump(), "application/json");
+                    AppLogger::info("Task " + std::to_string(def.id) + " coalesced into " + std::to_string(runningId));
+                    return;
+                }
                 
                 json successJson = {
                     {"status", "submitted"},
-                    {"task_id", def.id}
+                    {"task_id", def.id},
+                    {"queue", def.queue}
                 };
+                if (def.externalId != 0) {
+                    successJson["external_id"] = def.externalId;
+                }
                 setCorsHeaders(res);
                 res.set_content(successJson.dump(), "application/json");
                 AppLogger::info("Task " + std::to_string(def.id) + " submitted successfully");
@@ -285,8 +822,105 @@ void ApiServer::setupRoutes() {
         }
     });
     
-    // 404 handler for unmatched routes
+    // List recurring jobs with their occurrence stats
+    server->Get("/recurring", [this](const httplib::Request& /* req */, httplib::Response& res) {
+        json jobsArray = json::array();
+        if (recurringJobs) {
+            for (const auto& job : recurringJobs->list()) {
+                jobsArray.push_back(recurringJobToJson(*job));
+            }
+        }
+        json responseJson = {{"recurring", jobsArray}};
+        setCorsHeaders(res);
+        res.set_content(responseJson.dump(), "application/json");
+    });
+    
+    server->Get(R"(/recurring/(\d+))", [this](const httplib::Request& req, httplib::Response& res) {
+        setCorsHeaders(res);
+        int jobId = 0;
+        auto job = recurringJobs && parsePathId(req.matches[1], jobId) ? recurringJobs->get(jobId) : nullptr;
+        if (job) {
+            res.set_content(recurringJobToJson(*job).dump(), "application/json");
+        } else {
+            res.status = 404;
+            json errorJson = {{"error", "Recurring job not found"}};
+            res.set_content(errorJson.dump(), "application/json");
+        }
+    });
+    
+    // Stop a recurring job; occurrences already released still run
+    server->Delete(R"(/recurring/(\d+))", [this](const httplib::Request& req, httplib::Response& res) {
+        setCorsHeaders(res);
+        int jobId = 0;
+        if (recurringJobs && parsePathId(req.matches[1], jobId) && recurringJobs->remove(jobId)) {
+            json successJson = {{"status", "removed"}, {"task_id", jobId}};
+            res.set_content(successJson.dump(), "application/json");
+        } else {
+            res.status = 404;
+            json errorJson = {{"error", "Recurring job not found"}};
+            res.set_content(errorJson.dump(), "application/json");
+        }
+    });
+    
+    // Live scheduler / pool settings
+    server->Get("/admin/scheduler", [this](const httplib::Request& /* req */, httplib::Response& res) {
+        std::lock_guard<std::mutex> lock(adminMtx);
+        setCorsHeaders(res);
+        res.set_content(schedulerStateJson(), "application/json");
+    });
+    
+    // Swap the scheduler and/or resize the pool; queued tasks are migrated
+    server->Post("/admin/scheduler", [this](const httplib::Request& req, httplib::Response& res) {
+        setCorsHeaders(res);
+        try {
+            json body = json::parse(req.body);
+            if (body.contains("scheduler") &&
+                (!body["scheduler"].is_string() ||
+                 !Config::isKnownScheduler(body["scheduler"].get<std::string>()))) {
+                res.status = 400;
+                json errorJson = {{"error", "Unknown scheduler"}};
+                res.set_content(errorJson.dump(), "application/json");
+                return;
+            }
+            if (body.contains("threads") &&
+                (!body["threads"].is_number_integer() ||
+                 body["threads"].get<int>() < 1 || body["threads"].get<int>() > 128)) {
+                res.status = 400;
+                json errorJson = {{"error", "threads must be between 1 and 128"}};
+                res.set_content(errorJson.dump(), "application/json");
+                return;
+            }
+            
+            std::lock_guard<std::mutex> lock(adminMtx);
+            Config& cfg = Config::instance();
+            if (body.contains("scheduler")) {
+                cfg.setScheduler(body["scheduler"].get<std::string>());
+            }
+            if (body.contains("threads")) {
+                cfg.setThreads(body["threads"].get<int>());
+            }
+            applyConfig();
+            res.set_content(schedulerStateJson(), "application/json");
+        } catch (const json::exception& e) {
+            res.status = 400;
+            json errorJson = {{"error", "Invalid JSON format"}};
+            res.set_content(errorJson.dump(), "application/json");
+        }
+    });
+    
+    server->Post("/admin/reload", [this](const httplib::Request& /* req */, httplib::Response& res) {
+        reloadConfig();
+        std::lock_guard<std::mutex> lock(adminMtx);
+        setCorsHeaders(res);
+        res.set_content(schedulerStateJson("reloaded"), "application/json");
+    });
+    
+    // 404 handler for unmatched routes. httplib calls it for every error
+    // status, so errors a route already answered (400, 404, 409...) are kept.
     server->set_error_handler([](const httplib::Request& /* req */, httplib::Response& res) {
+        if (!res.body.empty()) {
+            return;
+        }
         res.status = 404;
         json errorJson = {{"error", "Not found"}};
         res.set_content(errorJson.dump(), "application/json");
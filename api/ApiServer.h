@@ -4,7 +4,13 @@
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include "PrometheusExporter.h"
 #include "../src/executor/ThreadPool.h"
+#include "../src/executor/RecurringJobs.h"
+#include "../src/executor/QueueRegistry.h"
 
 // Forward declarations
 namespace httplib {
@@ -15,22 +21,39 @@ namespace httplib {
 
 class ApiServer {
 public:
-    ApiServer(std::shared_ptr<ThreadPool> pool, int port);
+    ApiServer(std::shared_ptr<QueueRegistry> queues, int port,
+              std::shared_ptr<RecurringJobManager> recurring = nullptr);
     ~ApiServer();
     
     void start();
     void stop();
     
+    // Re-read configuration (SIGHUP / POST /admin/reload) and apply the
+    // scheduler and thread count of every queue to its running pool
+    void reloadConfig();
+    
 private:
+    // Caller must hold adminMtx
+    void applyConfig();
+    std::string schedulerStateJson(const std::string& status = "");
+
     void setupRoutes();
     void setCorsHeaders(httplib::Response& res);
     
-    std::shared_ptr<ThreadPool> threadPool;
+    std::shared_ptr<QueueRegistry> queues;
+    std::shared_ptr<ThreadPool> threadPool;  // the default queue
+    std::shared_ptr<RecurringJobManager> recurringJobs;
     std::unique_ptr<httplib::Server> server;
     int port;
     std::atomic<bool> running;
     std::thread serverThread;
     int maxRequestSize;
     std::string corsOrigin;
+    std::atomic<bool> serverAssignedIds{false};
+    std::mutex adminMtx;
+    std::map<std::string, std::string> appliedSchedulers;  // queue -> SchedulerFactory::describe
+    std::chrono::steady_clock::time_point startedAt = std::chrono::steady_clock::now();
+    std::mutex prometheusMtx;
+    PrometheusExporter prometheus{startedAt};  // reuses its buffer across scrapes
 };
 
@@ -0,0 +1,227 @@
+#include "PrometheusExporter.h"
+
+#include <charconv>
+
+#include "../core/TaskRegistry.h"
+
+const std::array<std::uint64_t, PrometheusExporter::BOUNDS> PrometheusExporter::BOUNDS_MICROS = {
+    500, 1000, 2500, 5000, 10000, 25000, 50000,
+    100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000
+};
+
+// BOUNDS_MICROS as le label values, in seconds
+static const char* const BOUND_LABELS[PrometheusExporter::BOUNDS] = {
+    "0.0005", "0.001", "0.0025", "0.005", "0.01", "0.025", "0.05",
+    "0.1", "0.25", "0.5", "1", "2.5", "5", "10"
+};
+
+static const char* const STATE_LABELS[TASK_STATE_COUNT] = {
+    "created", "ready", "running", "retrying", "completed", "failed", "rejected", "cancelled"
+};
+
+static const char* priorityLabel(TaskPriority priority) {
+    switch (priority) {
+        case TaskPriority::HIGH: return "HIGH";
+        case TaskPriority::LOW: return "LOW";
+        default: return "MEDIUM";
+    }
+}
+
+PrometheusExporter::PrometheusExporter(std::chrono::steady_clock::time_point startedAt)
+    : startedAt(startedAt) {}
+
+const std::string& PrometheusExporter::render(const QueueRegistry& queues) {
+    buffer.clear();  // keeps the capacity of the previous scrape
+
+    const auto uptime = std::chrono::steady_clock::now() - startedAt;
+    header("taskweave_uptime_seconds", "gauge", "Seconds since the API server started.");
+    openSample("taskweave_uptime_seconds");
+    closeSampleMicros(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(uptime).count()));
+
+    const MetricsCounters c = Metrics::instance().getCounters();
+    counter("taskweave_tasks_executed_total", "Tasks that reached a final state after running.", c.executed);
+    counter("taskweave_tasks_completed_total", "Tasks that completed successfully.", c.completed);
+    counter("taskweave_tasks_failed_total", "Tasks that failed after their last retry.", c.failed);
+    counter("taskweave_task_retries_total", "Retries across all finished tasks.", c.retries);
+    counter("taskweave_tasks_rejected_total", "Tasks shed by overload control.", c.rejected);
+    counter("taskweave_tasks_throttled_total", "Tasks parked by a rate limit.", c.throttled);
+    counter("taskweave_tasks_coalesced_total", "Submits coalesced into an identical pending task.", c.coalesced);
+    counter("taskweave_result_cache_hits_total", "Submits completed from the result cache.", c.cacheHits);
+    counter("taskweave_tasks_cancelled_total", "Queued tasks withdrawn before running.", c.cancelled);
+    counter("taskweave_deadline_misses_total", "Tasks that finished, or were dropped, past their deadline.", c.deadlineMisses);
+    counter("taskweave_deadline_demoted_total", "Late tasks demoted by the scheduler.", c.deadlineDemoted);
+    counter("taskweave_deadline_dropped_total", "Late tasks dropped by the scheduler.", c.deadlineDropped);
+
+    TaskRegistry& registry = TaskRegistry::instance();
+    header("taskweave_registry_tasks", "gauge", "Registered tasks by state.");
+    for (int s = 0; s < TASK_STATE_COUNT; ++s) {
+        openSample("taskweave_registry_tasks");
+        label("state", STATE_LABELS[s]);
+        closeSample(registry.countByState(static_cast<TaskState>(s)));
+    }
+
+    // One pass per family: samples of a family must be contiguous
+    auto perQueue = [&](const char* name, const char* type, const char* help, auto value) {
+        header(name, type, help);
+        queues.forEach([&](const std::string& queue, const ThreadPool& pool) {
+            openSample(name);
+            label("queue", queue.c_str());
+            closeSample(static_cast<std::uint64_t>(value(pool)));
+        });
+    };
+    perQueue("taskweave_queue_depth", "gauge", "Tasks held by the queue's scheduler.",
+             [](const ThreadPool& pool) { return pool.getScheduler()->size(); });
+    perQueue("taskweave_queue_delayed", "gauge", "Tasks waiting on the queue's timer wheel.",
+             [](const ThreadPool& pool) { return pool.getPendingTimers(); });
+    perQueue("taskweave_pool_workers", "gauge", "Target worker threads of the queue's pool.",
+             [](const ThreadPool& pool) { return pool.getSize(); });
+    perQueue("taskweave_pool_busy_workers", "gauge", "Workers currently running a task.",
+             [](const ThreadPool& pool) { return pool.getStats().busy; });
+    perQueue("taskweave_queue_submitted_total", "counter", "Tasks submitted to the queue.",
+             [](const ThreadPool& pool) { return pool.getStats().submitted; });
+    perQueue("taskweave_queue_completed_total", "counter", "Tasks completed by the queue's pool.",
+             [](const ThreadPool& pool) { return pool.getStats().completed; });
+    perQueue("taskweave_queue_failed_total", "counter", "Tasks failed after their last retry.",
+             [](const ThreadPool& pool) { return pool.getStats().failed; });
+
+    collectLatency();
+    renderHistogram(WAIT, "taskweave_task_wait_seconds",
+                    "Time from READY to start of the last attempt.");
+    renderHistogram(EXEC, "taskweave_task_exec_seconds",
+                    "Execution time of the last attempt.");
+    renderHistogram(END_TO_END, "taskweave_task_end_to_end_seconds",
+                    "Time from first READY to finish, across retries.");
+    return buffer;
+}
+
+void PrometheusExporter::collectLatency() {
+    for (auto& totals : series) {
+        totals.perBound = {};
+        totals.count = {};
+        totals.sum = {};
+    }
+    Metrics::instance().forEachSeries([this](const MetricsSeries& recorded, TaskPriority priority) {
+        const std::size_t slot = recorded.key->index * 3 + static_cast<std::size_t>(priority);
+        if (series.size() <= slot) {
+            // Only when a key is first seen; later scrapes reuse the slot
+            series.resize(slot + 1);
+        }
+        SeriesTotals& totals = series[slot];
+        totals.key = recorded.key;
+        totals.priority = priority;
+        const Histogram* histograms[KINDS] = {&recorded.wait, &recorded.exec, &recorded.endToEnd};
+        for (int k = 0; k < KINDS; ++k) {
+            histograms[k]->accumulate(BOUNDS_MICROS.data(), BOUNDS, totals.perBound[k].data(),
+                                      totals.count[k], totals.sum[k]);
+        }
+    });
+}
+
+void PrometheusExporter::renderHistogram(Kind kind, const char* name, const char* help) {
+    header(name, "histogram", help);
+    for (const auto& totals : series) {
+        if (!totals.key) {
+            continue;
+        }
+        const char* type = totals.key->type.empty() ? "untyped" : totals.key->type.c_str();
+        const char* tenant = totals.key->tenant.c_str();
+        std::uint64_t cumulative = 0;
+        for (std::size_t b = 0; b <= BOUNDS; ++b) {
+            cumulative += totals.perBound[kind][b];
+            openSample(name, "_bucket");
+            label("type", type);
+            label("tenant", tenant);
+            label("priority", priorityLabel(totals.priority));
+            label("le", b < BOUNDS ? BOUND_LABELS[b] : "+Inf");
+            closeSample(cumulative);
+        }
+        openSample(name, "_sum");
+        label("type", type);
+        label("tenant", tenant);
+        label("priority", priorityLabel(totals.priority));
+        closeSampleMicros(totals.sum[kind]);
+        openSample(name, "_count");
+        label("type", type);
+        label("tenant", tenant);
+        label("priority", priorityLabel(totals.priority));
+        closeSample(totals.count[kind]);
+    }
+}
+
+void PrometheusExporter::header(const char* name, const char* type, const char* help) {
+    buffer += "# HELP ";
+    buffer += name;
+    buffer += ' ';
+    buffer += help;
+    buffer += "\n# TYPE ";
+    buffer += name;
+    buffer += ' ';
+    buffer += type;
+    buffer += '\n';
+}
+
+void PrometheusExporter::openSample(const char* name, const char* suffix) {
+    buffer += name;
+    buffer += suffix;
+    firstLabel = true;
+}
+
+void PrometheusExporter::label(const char* key, const char* value) {
+    buffer += firstLabel ? '{' : ',';
+    firstLabel = false;
+    buffer += key;
+    buffer += "=\"";
+    appendEscaped(value);
+    buffer += '"';
+}
+
+void PrometheusExporter::closeSample(std::uint64_t value) {
+    if (!firstLabel) {
+        buffer += '}';
+    }
+    buffer += ' ';
+    appendUint(value);
+    buffer += '\n';
+}
+
+void PrometheusExporter::closeSampleMicros(std::uint64_t micros) {
+    if (!firstLabel) {
+        buffer += '}';
+    }
+    buffer += ' ';
+    // Fixed-point, so no float formatting or rounding on the scrape path
+    appendUint(micros / 1000000);
+    char fraction[7];
+    std::uint64_t rest = micros % 1000000;
+    for (int i = 5; i >= 0; --i) {
+        fraction[i] = static_cast<char>('0' + rest % 10);
+        rest /= 10;
+    }
+    buffer += '.';
+    buffer.append(fraction, 6);
+    buffer += '\n';
+}
+
+void PrometheusExporter::counter(const char* name, const char* help, std::uint64_t value) {
+    header(name, "counter", help);
+    openSample(name);
+    closeSample(value);
+}
+
+void PrometheusExporter::appendUint(std::uint64_t value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+}
+
+void PrometheusExporter::appendEscaped(const char* value) {
+    for (; *value; ++value) {
+        switch (*value) {
+            case '\\': buffer += "\\\\"; break;
+            case '"': buffer += "\\\""; break;
+            case '\n': buffer += "\\n"; break;
+            default: buffer += *value;
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../src/core/Task.h"
+#include "../src/executor/QueueRegistry.h"
+#include "../utils/Metrics.h"
+
+// Renders engine metrics in the Prometheus text exposition format (0.0.4):
+// task counters, registry/queue/pool gauges and latency histograms. Values
+// come straight from the atomics the engine already keeps; the text buffer
+// and histogram accumulators live across scrapes, so a steady-state render()
+// does not allocate (the HTTP handler still copies the text into its
+// response). Not thread-safe: serialize render() calls and consume the
+// returned text before the next one.
+class PrometheusExporter {
+public:
+    static constexpr const char* CONTENT_TYPE = "text/plain; version=0.0.4; charset=utf-8";
+
+    explicit PrometheusExporter(
+        std::chrono::steady_clock::time_point startedAt = std::chrono::steady_clock::now());
+
+    const std::string& render(const QueueRegistry& queues);
+
+    // Upper bounds of the histogram buckets, in microseconds
+    static constexpr std::size_t BOUNDS = 14;
+    static const std::array<std::uint64_t, BOUNDS> BOUNDS_MICROS;
+
+private:
+    enum Kind { WAIT, EXEC, END_TO_END, KINDS };
+
+    // Sum over every recording thread of one metrics key and priority
+    struct SeriesTotals {
+        const MetricsKey* key = nullptr;  // null: slot not recorded yet
+        TaskPriority priority = TaskPriority::MEDIUM;
+        std::array<std::array<std::uint64_t, BOUNDS + 1>, KINDS> perBound{};
+        std::array<std::uint64_t, KINDS> count{};
+        std::array<std::uint64_t, KINDS> sum{};  // microseconds
+    };
+
+    void collectLatency();
+    void renderHistogram(Kind kind, const char* name, const char* help);
+
+    void header(const char* name, const char* type, const char* help);
+    void openSample(const char* name, const char* suffix = "");
+    void label(const char* key, const char* value);
+    void closeSample(std::uint64_t value);
+    void closeSampleMicros(std::uint64_t micros);  // written as seconds
+    void counter(const char* name, const char* help, std::uint64_t value);
+
+    void appendUint(std::uint64_t value);
+    void appendEscaped(const char* value);
+
+    std::chrono::steady_clock::time_point startedAt;
+    std::string buffer;
+    std::vector<SeriesTotals> series;  // by MetricsKey::index * 3 + priority
+    bool firstLabel = true;
+};
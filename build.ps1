@@ -11,13 +11,34 @@ g++ -std=c++17 `
   src/main.cpp `
   src/core/Task.cpp `
   core/TaskLoader.cpp `
+  core/CronExpression.cpp `
   core/TaskRegistry.cpp `
   src/executor/ThreadPool.cpp `
+  src/executor/TimerWheel.cpp `
+  src/executor/DedupIndex.cpp `
+  src/executor/RecurringJobs.cpp `
+  src/executor/QueueRegistry.cpp `
   src/scheduler/PriorityScheduler.cpp `
   src/scheduler/RoundRobinScheduler.cpp `
+  src/scheduler/EDFScheduler.cpp `
+  src/scheduler/MLFQScheduler.cpp `
+  src/scheduler/SJFScheduler.cpp `
+  src/scheduler/CoDelScheduler.cpp `
+  src/scheduler/RateLimitScheduler.cpp `
+  src/scheduler/ConcurrencyLimitScheduler.cpp `
+  src/scheduler/CircuitBreaker.cpp `
+  src/scheduler/CircuitBreakerScheduler.cpp `
+  src/scheduler/SchedulerFactory.cpp `
   api/ApiServer.cpp `
+  api/PrometheusExporter.cpp `
   utils/Config.cpp `
   utils/Metrics.cpp `
+  utils/RuntimeEstimator.cpp `
+  utils/Histogram.cpp `
+  utils/RateWindow.cpp `
+  utils/TraceRecorder.cpp `
+  utils/ResultCache.cpp `
+  utils/Epoch.cpp `
   utils/Database.cpp `
   -o taskweave.exe `
   -pthread `
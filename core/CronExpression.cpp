@@ -0,0 +1,162 @@
+#include "CronExpression.h"
+
+#include <ctime>
+#include <sstream>
+#include <vector>
+
+// Thread-safe localtime
+static std::tm toLocalTime(std::time_t t) {
+    std::tm tm{};
+#ifdef _WIN32
+    localtime_s(&tm, &t);
+#else
+    localtime_r(&t, &tm);
+#endif
+    return tm;
+}
+
+static bool parseNumber(const std::string& text, int& value) {
+    if (text.empty() || text.size() > 4)
+        return false;
+    for (char c : text) {
+        if (c < '0' || c > '9')
+            return false;
+    }
+    value = std::stoi(text);
+    return true;
+}
+
+bool CronExpression::parseField(const std::string& field, int minValue, int maxValue,
+                                std::bitset<64>& out) {
+    std::stringstream ss(field);
+    std::string part;
+    bool any = false;
+
+    while (std::getline(ss, part, ',')) {
+        int step = 1;
+        auto slash = part.find('/');
+        if (slash != std::string::npos) {
+            if (!parseNumber(part.substr(slash + 1), step) || step < 1)
+                return false;
+            part = part.substr(0, slash);
+        }
+
+        int low = minValue;
+        int high = maxValue;
+        if (part != "*") {
+            auto dash = part.find('-');
+            if (dash != std::string::npos) {
+                if (!parseNumber(part.substr(0, dash), low) ||
+                    !parseNumber(part.substr(dash + 1), high))
+                    return false;
+            } else {
+                if (!parseNumber(part, low))
+                    return false;
+                // "a/n" means from a to the end of the range
+                high = (slash != std::string::npos) ? maxValue : low;
+            }
+        }
+
+        if (low < minValue || high > maxValue || low > high)
+            return false;
+
+        for (int v = low; v <= high; v += step) {
+            out.set(static_cast<std::size_t>(v));
+        }
+        any = true;
+    }
+    return any;
+}
+
+// A field listing every value of its range ("*", "*/1", "1-31") is no restriction
+static bool coversRange(const std::bitset<64>& bits, int minValue, int maxValue) {
+    for (int v = minValue; v <= maxValue; ++v) {
+        if (!bits.test(static_cast<std::size_t>(v)))
+            return false;
+    }
+    return true;
+}
+
+std::optional<CronExpression> CronExpression::parse(const std::string& expr) {
+    std::istringstream iss(expr);
+    std::vector<std::string> fields;
+    std::string field;
+    while (iss >> field) {
+        fields.push_back(field);
+    }
+    if (fields.size() != 5)
+        return std::nullopt;
+
+    CronExpression cron;
+    cron.source = expr;
+    if (!parseField(fields[0], 0, 59, cron.minutes) ||
+        !parseField(fields[1], 0, 23, cron.hours) ||
+        !parseField(fields[2], 1, 31, cron.daysOfMonth) ||
+        !parseField(fields[3], 1, 12, cron.months) ||
+        !parseField(fields[4], 0, 7, cron.daysOfWeek))
+        return std::nullopt;
+
+    // 7 is an alias for Sunday
+    if (cron.daysOfWeek.test(7))
+        cron.daysOfWeek.set(0);
+
+    cron.anyDayOfMonth = coversRange(cron.daysOfMonth, 1, 31);
+    cron.anyDayOfWeek = coversRange(cron.daysOfWeek, 0, 6);
+    return cron;
+}
+
+bool CronExpression::matchesDay(int dayOfMonth, int month, int dayOfWeek) const {
+    if (!months.test(static_cast<std::size_t>(month)))
+        return false;
+
+    bool domMatch = daysOfMonth.test(static_cast<std::size_t>(dayOfMonth));
+    bool dowMatch = daysOfWeek.test(static_cast<std::size_t>(dayOfWeek));
+    if (anyDayOfMonth && anyDayOfWeek)
+        return true;
+    if (anyDayOfMonth)
+        return dowMatch;
+    if (anyDayOfWeek)
+        return domMatch;
+    return domMatch || dowMatch;
+}
+
+std::optional<std::chrono::system_clock::time_point> CronExpression::next(
+    std::chrono::system_clock::time_point after) const {
+    std::time_t t = std::chrono::system_clock::to_time_t(after);
+    std::tm tm = toLocalTime(t);
+    tm.tm_sec = 0;
+    tm.tm_min += 1;
+    tm.tm_isdst = -1;
+    t = std::mktime(&tm);
+
+    // Walk forward, skipping whole days and hours that cannot match.
+    // Four years covers every valid day-of-month/month/day-of-week combination.
+    const std::time_t limit = t + 4LL * 366 * 24 * 60 * 60;
+    while (t <= limit) {
+        tm = toLocalTime(t);
+
+        if (!matchesDay(tm.tm_mday, tm.tm_mon + 1, tm.tm_wday)) {
+            tm.tm_mday += 1;
+            tm.tm_hour = 0;
+            tm.tm_min = 0;
+            tm.tm_isdst = -1;
+            t = std::mktime(&tm);
+            continue;
+        }
+        if (!hours.test(static_cast<std::size_t>(tm.tm_hour))) {
+            tm.tm_hour += 1;
+            tm.tm_min = 0;
+            tm.tm_isdst = -1;
+            t = std::mktime(&tm);
+            continue;
+        }
+        if (!minutes.test(static_cast<std::size_t>(tm.tm_min))) {
+            tm.tm_min += 1;
+            tm.tm_isdst = -1;
+            t = std::mktime(&tm);
+            continue;
+        }
+        return std::chrono::system_clock::from_time_t(t);
+    }
+    return std::nullopt;
+}
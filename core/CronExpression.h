@@ -0,0 +1,39 @@
+#pragma once
+
+#include <bitset>
+#include <chrono>
+#include <optional>
+#include <string>
+
+// Standard 5-field cron expression: minute hour day-of-month month day-of-week.
+// Each field accepts '*', numbers, ranges (a-b), steps (*/n, a-b/n) and lists.
+// Day-of-week is 0-7 (0 and 7 are Sunday). As in cron, when both day fields
+// are restricted a day matches if either matches; a field that covers its
+// whole range ("*/1") is not a restriction. Evaluated in local time.
+class CronExpression {
+public:
+    // Returns nullopt if the expression is invalid
+    static std::optional<CronExpression> parse(const std::string& expr);
+
+    // First matching minute strictly after `after`
+    std::optional<std::chrono::system_clock::time_point> next(
+        std::chrono::system_clock::time_point after) const;
+
+    const std::string& str() const { return source; }
+
+private:
+    CronExpression() = default;
+
+    static bool parseField(const std::string& field, int minValue, int maxValue,
+                           std::bitset<64>& out);
+    bool matchesDay(int dayOfMonth, int month, int dayOfWeek) const;
+
+    std::string source;
+    std::bitset<64> minutes;
+    std::bitset<64> hours;
+    std::bitset<64> daysOfMonth;
+    std::bitset<64> months;
+    std::bitset<64> daysOfWeek;
+    bool anyDayOfMonth = false;
+    bool anyDayOfWeek = false;
+};
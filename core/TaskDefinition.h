@@ -2,16 +2,58 @@
 
 #include <string>
 #include <map>
+#include <functional>
 #include "../src/core/Task.h"
 
 // Task definition from JSON
 struct TaskDefinition {
     int id = 0;
+    int externalId = 0;  // client's ID when the server assigns `id` (0 = none)
     std::string name;
     std::string priority = "MEDIUM";  // LOW, MEDIUM, HIGH
     int maxRetries = 0;
     std::string type;  // "sleep", "print", "custom"
     std::map<std::string, std::string> params;  // task-specific parameters
+    std::string queue = "default";  // named queue (pool) that runs the task
+    std::string tenant;  // optional, for per-tenant rate limits
+    std::string concurrencyKey;  // tasks sharing a key are limited to maxConcurrency at once
+    int maxConcurrency = 0;      // 0 = unlimited (defaults to 1 when a key is given)
+    int deadlineMs = 0;  // completion deadline relative to start eligibility (0 = none)
+    long long delayMs = 0;   // hold the task this long after submission (0 = run now)
+    long long runAtMs = 0;   // absolute start time, Unix epoch ms (overrides delayMs)
+    bool sheddable = true;  // may be rejected under overload (defaults to false for HIGH)
+    std::string dedupKey;   // coalesce with a pending task that has the same key
+    bool dedup = false;     // derive the dedup key from type + params
+    
+    // Recurrence ("schedule" object); a task with everyMs or cron is a recurring job
+    long long everyMs = 0;
+    std::string cron;
+    std::string overlap = "skip";   // skip, queue, concurrent
+    std::string catchUp = "none";   // none, all
+    
+    bool isRecurring() const {
+        return everyMs > 0 || !cron.empty();
+    }
+    
+    // Explicit dedup_key, else "<type>#<params hash>" when dedup is on
+    std::string getDedupKey() const {
+        if (!dedupKey.empty()) {
+            return dedupKey;
+        }
+        return dedup ? type + "#" + std::to_string(getParamsHash()) : std::string();
+    }
+    
+    // Stable hash of params (std::map iterates in key order)
+    std::size_t getParamsHash() const {
+        std::string canonical;
+        for (const auto& [key, value] : params) {
+            canonical += key;
+            canonical += '=';
+            canonical += value;
+            canonical += ';';
+        }
+        return canonical.empty() ? 0 : std::hash<std::string>()(canonical);
+    }
     
     // Convert to TaskPriority enum
     TaskPriority getPriorityEnum() const {
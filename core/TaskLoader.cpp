@@ -7,14 +7,15 @@
 #include <stdexcept>
 #include <thread>
 #include <chrono>
+#include <algorithm>
 
 using json = nlohmann::json;
 
 // Helper functions for JSON parsing (internal use only)
-static TaskDefinition parseTaskJson(const json& taskJson);
-static std::vector<TaskDefinition> loadFromJsonObject(const json& j);
+static TaskDefinition parseTaskJson(const json& taskJson, bool idOptional = false);
+static std::vector<TaskDefinition> loadFromJsonObject(const json& j, bool idOptional = false);
 
-TaskDefinition parseTaskJson(const json& taskJson) {
+TaskDefinition parseTaskJson(const json& taskJson, bool idOptional) {
     TaskDefinition def;
     
     // Extract and validate id
@@ -27,7 +28,9 @@ TaskDefinition parseTaskJson(const json& taskJson) {
             def.id = 0;
         }
     } else {
-        Logger::warn("Task missing required 'id' field or invalid type");
+        if (!idOptional || taskJson.contains("id")) {
+            Logger::warn("Task missing required 'id' field or invalid type");
+        }
         def.id = 0;
     }
     
@@ -72,6 +75,108 @@ TaskDefinition parseTaskJson(const json& taskJson) {
         def.type = taskJson["type"].get<std::string>();
     }
     
+    // Extract deadline_ms (optional)
+    if (taskJson.contains("deadline_ms") && taskJson["deadline_ms"].is_number_integer()) {
+        int deadlineMs = taskJson["deadline_ms"].get<int>();
+        if (deadlineMs > 0) {
+            def.deadlineMs = deadlineMs;
+        } else {
+            Logger::warn("Invalid deadline_ms: " + std::to_string(deadlineMs) + ". Must be positive; ignoring");
+        }
+    }
+    
+    // Extract delay_ms / run_at (optional)
+    if (taskJson.contains("delay_ms") && taskJson["delay_ms"].is_number_integer()) {
+        long long delayMs = taskJson["delay_ms"].get<long long>();
+        if (delayMs >= 0) {
+            def.delayMs = delayMs;
+        } else {
+            Logger::warn("Invalid delay_ms: " + std::to_string(delayMs) + ". Must be non-negative; ignoring");
+        }
+    }
+    if (taskJson.contains("run_at") && taskJson["run_at"].is_number_integer()) {
+        long long runAtMs = taskJson["run_at"].get<long long>();
+        if (runAtMs > 0) {
+            def.runAtMs = runAtMs;
+        } else {
+            Logger::warn("Invalid run_at: " + std::to_string(runAtMs) + ". Must be Unix epoch milliseconds; ignoring");
+        }
+    }
+    
+    // Extract schedule (optional): {"every": "30s"} / {"every_ms": 30000} / {"cron": "*/5 * * * *"}
+    if (taskJson.contains("schedule") && taskJson["schedule"].is_object()) {
+        const json& schedule = taskJson["schedule"];
+        if (schedule.contains("every_ms") && schedule["every_ms"].is_number_integer()) {
+            def.everyMs = schedule["every_ms"].get<long long>();
+        } else if (schedule.contains("every") && schedule["every"].is_string()) {
+            def.everyMs = TaskLoader::parseDurationMs(schedule["every"].get<std::string>());
+        }
+        if (def.everyMs < 0 || (def.everyMs > 0 && def.everyMs < 10)) {
+            Logger::warn("Invalid schedule interval for task " + std::to_string(def.id) + ". Must be at least 10ms; ignoring");
+            def.everyMs = 0;
+        }
+        if (schedule.contains("cron") && schedule["cron"].is_string()) {
+            def.cron = schedule["cron"].get<std::string>();
+        }
+        if (schedule.contains("overlap") && schedule["overlap"].is_string()) {
+            std::string overlap = schedule["overlap"].get<std::string>();
+            if (overlap == "skip" || overlap == "queue" || overlap == "concurrent") {
+                def.overlap = overlap;
+            } else {
+                Logger::warn("Invalid overlap policy: " + overlap + ". Using skip");
+            }
+        }
+        if (schedule.contains("catch_up") && schedule["catch_up"].is_string()) {
+            std::string catchUp = schedule["catch_up"].get<std::string>();
+            if (catchUp == "none" || catchUp == "all") {
+                def.catchUp = catchUp;
+            } else {
+                Logger::warn("Invalid catch_up policy: " + catchUp + ". Using none");
+            }
+        }
+    }
+    
+    // Extract queue (optional)
+    if (taskJson.contains("queue") && taskJson["queue"].is_string() &&
+        !taskJson["queue"].get<std::string>().empty()) {
+        def.queue = taskJson["queue"].get<std::string>();
+    }
+    
+    // Extract tenant (optional)
+    if (taskJson.contains("tenant") && taskJson["tenant"].is_string()) {
+        def.tenant = taskJson["tenant"].get<std::string>();
+    }
+    
+    // Extract concurrency limit (optional)
+    if (taskJson.contains("concurrency_key") && taskJson["concurrency_key"].is_string()) {
+        def.concurrencyKey = taskJson["concurrency_key"].get<std::string>();
+        def.maxConcurrency = 1;
+    }
+    if (!def.concurrencyKey.empty() && taskJson.contains("max_concurrency") &&
+        taskJson["max_concurrency"].is_number_integer()) {
+        int limit = taskJson["max_concurrency"].get<int>();
+        if (limit >= 1 && limit <= 10000) {
+            def.maxConcurrency = limit;
+        } else {
+            Logger::warn("Invalid max_concurrency: " + std::to_string(limit) + ". Must be between 1 and 10000; using 1");
+        }
+    }
+    
+    // Extract deduplication (optional)
+    if (taskJson.contains("dedup_key") && taskJson["dedup_key"].is_string()) {
+        def.dedupKey = taskJson["dedup_key"].get<std::string>();
+    }
+    if (taskJson.contains("dedup") && taskJson["dedup"].is_boolean()) {
+        def.dedup = taskJson["dedup"].get<bool>();
+    }
+    
+    // Extract sheddable (optional); HIGH priority work is protected by default
+    if (taskJson.contains("sheddable") && taskJson["sheddable"].is_boolean()) {
+        def.sheddable = taskJson["sheddable"].get<bool>();
+    } else {
+        def.sheddable = def.priority != "HIGH";
+    }
+    
     // Extract params
     if (taskJson.contains("params") && taskJson["params"].is_object()) {
         for (auto& [key, value] : taskJson["params"].items()) {
@@ -108,10 +213,10 @@ std::vector<TaskDefinition> TaskLoader::loadFromJson(const std::string& jsonPath
     }
 }
 
-std::vector<TaskDefinition> TaskLoader::loadFromJsonString(const std::string& jsonStr) {
+std::vector<TaskDefinition> TaskLoader::loadFromJsonString(const std::string& jsonStr, bool idOptional) {
     try {
         json j = json::parse(jsonStr);
-        return loadFromJsonObject(j);
+        return loadFromJsonObject(j, idOptional);
     } catch (const json::parse_error& e) {
         Logger::error("JSON parse error: " + std::string(e.what()));
         return {};
@@ -121,7 +226,7 @@ std::vector<TaskDefinition> TaskLoader::loadFromJsonString(const std::string& js
     }
 }
 
-std::vector<TaskDefinition> loadFromJsonObject(const json& j) {
+std::vector<TaskDefinition> loadFromJsonObject(const json& j, bool idOptional) {
     std::vector<TaskDefinition> tasks;
     
     // Check if "tasks" key exists
@@ -133,8 +238,8 @@ std::vector<TaskDefinition> loadFromJsonObject(const json& j) {
     // Parse each task object
     for (const auto& taskJson : j["tasks"]) {
         try {
-            TaskDefinition def = parseTaskJson(taskJson);
-            if (def.id > 0) {
+            TaskDefinition def = parseTaskJson(taskJson, idOptional);
+            if (def.id > 0 || idOptional) {
                 tasks.push_back(def);
             }
         } catch (const std::exception& e) {
@@ -145,7 +250,7 @@ std::vector<TaskDefinition> loadFromJsonObject(const json& j) {
     return tasks;
 }
 
-Task TaskLoader::createTask(const TaskDefinition& def) {
+std::function<void()> TaskLoader::createTaskFunction(const TaskDefinition& def) {
     std::function<void()> fn;
     
     if (def.type == "sleep") {
@@ -174,6 +279,59 @@ Task TaskLoader::createTask(const TaskDefinition& def) {
         };
     }
     
-    return Task(def.id, def.getPriorityEnum(), fn, def.maxRetries);
+    return fn;
+}
+
+Task TaskLoader::createTask(const TaskDefinition& def) {
+    return createTask(def, createTaskFunction(def));
+}
+
+Task TaskLoader::createTask(const TaskDefinition& def, std::function<void()> fn) {
+    Task task(def.id, def.getPriorityEnum(), std::move(fn), def.maxRetries);
+    task.setExternalId(def.externalId);
+    task.setType(def.type);
+    task.setParamsHash(def.getParamsHash());
+    task.setSheddable(def.sheddable);
+    task.setTenant(def.tenant);
+    task.setConcurrencyLimit(def.concurrencyKey, def.maxConcurrency);
+    task.setDedupKey(def.getDedupKey());
+    
+    // Translate the requested start time onto the steady clock
+    auto now = std::chrono::steady_clock::now();
+    auto startAt = now;
+    if (def.runAtMs > 0) {
+        auto epochNowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        startAt = now + std::chrono::milliseconds(std::max(0LL, def.runAtMs - epochNowMs));
+    } else if (def.delayMs > 0) {
+        startAt = now + std::chrono::milliseconds(def.delayMs);
+    }
+    if (startAt > now) {
+        task.setRunAt(startAt);
+    }
+    
+    if (def.deadlineMs > 0) {
+        task.setDeadline(startAt + std::chrono::milliseconds(def.deadlineMs));
+    }
+    return task;
 }
 
+long long TaskLoader::parseDurationMs(const std::string& text) {
+    std::size_t pos = 0;
+    long long value = 0;
+    try {
+        value = std::stoll(text, &pos);
+    } catch (const std::exception&) {
+        return -1;
+    }
+    if (value < 0) {
+        return -1;
+    }
+
+    std::string unit = text.substr(pos);
+    if (unit == "ms") return value;
+    if (unit.empty() || unit == "s") return value * 1000;
+    if (unit == "m") return value * 60 * 1000;
+    if (unit == "h") return value * 60 * 60 * 1000;
+    return -1;
+}
@@ -9,10 +9,21 @@ public:
     // Load tasks from JSON file
     static std::vector<TaskDefinition> loadFromJson(const std::string& jsonPath);
     
-    // Load tasks from JSON string (for API)
-    static std::vector<TaskDefinition> loadFromJsonString(const std::string& jsonStr);
+    // Load tasks from JSON string (for API). With idOptional, tasks without
+    // an "id" are kept with id 0 for the caller to assign one
+    static std::vector<TaskDefinition> loadFromJsonString(const std::string& jsonStr,
+                                                          bool idOptional = false);
     
     // Convert TaskDefinition to executable Task
     static Task createTask(const TaskDefinition& def);
+    
+    // Same, but running a prebuilt body (e.g. a wrapped createTaskFunction)
+    static Task createTask(const TaskDefinition& def, std::function<void()> fn);
+    
+    // Build only the work function for a definition's type and params
+    static std::function<void()> createTaskFunction(const TaskDefinition& def);
+    
+    // Parse durations like "500ms", "30s", "5m", "1h" (plain number = seconds); -1 if invalid
+    static long long parseDurationMs(const std::string& text);
 };
 
@@ -1,51 +1,693 @@
 #include "TaskRegistry.h"
+#include "../utils/Epoch.h"
+#include "../utils/Logger.h"
+
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+TaskRegistry::Entry TaskRegistry::tombstone{0, nullptr, nullptr};
 
 TaskRegistry& TaskRegistry::instance() {
     static TaskRegistry registry;
     return registry;
 }
 
-void TaskRegistry::registerTask(const Task& task) {
-    std::lock_guard<std::mutex> lock(mtx);
-    tasks[task.getId()] = std::make_shared<Task>(task);
+TaskRegistry::Table::Table(std::size_t capacity)
+    : mask(capacity - 1), buckets(new std::atomic<Entry*>[capacity]) {
+    for (std::size_t i = 0; i < capacity; ++i) {
+        buckets[i].store(nullptr, std::memory_order_relaxed);
+    }
 }
 
-std::shared_ptr<Task> TaskRegistry::getTask(int id) const {
-    std::lock_guard<std::mutex> lock(mtx);
-    auto it = tasks.find(id);
-    if (it != tasks.end()) {
-        return it->second;
+TaskRegistry::TaskRegistry() {
+    for (auto& shard : shards) {
+        shard.table.store(new Table(INITIAL_CAPACITY));
+    }
+    // Constructed first so it is destroyed after the retention thread stops
+    Database::instance();
+}
+
+TaskRegistry::~TaskRegistry() {
+    {
+        std::lock_guard<std::mutex> lock(retentionWakeMtx);
+        retentionStop = true;
+    }
+    retentionCv.notify_one();
+    if (retentionThread.joinable()) {
+        retentionThread.join();
+    }
+
+    for (auto& shard : shards) {
+        Table* table = shard.table.load();
+        for (std::size_t i = 0; i <= table->mask; ++i) {
+            Entry* entry = table->buckets[i].load();
+            if (entry && entry != &tombstone) {
+                delete entry;
+            }
+        }
+        delete table;
+    }
+    for (auto& ring : segments) {
+        Segment* segment = ring.load();
+        if (!segment) {
+            continue;
+        }
+        for (int i = 0; i < SEGMENT_SIZE; ++i) {
+            delete segment->slots[i].load();
+        }
+        delete segment;
+    }
+    delete published.load();
+}
+
+std::uint64_t TaskRegistry::hash(int id) {
+    // Fibonacci hashing spreads sequential IDs over shards and buckets
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(id)) * 0x9E3779B97F4A7C15ULL;
+}
+
+TaskRegistry::Shard& TaskRegistry::shardFor(std::uint64_t h) const {
+    return shards[h >> 60];
+}
+
+void TaskRegistry::grow(Shard& shard) {
+    Table* old = shard.table.load(std::memory_order_relaxed);
+    std::size_t live = shard.live.load(std::memory_order_relaxed);
+    std::size_t capacity = INITIAL_CAPACITY;
+    while (capacity < (live + 1) * 4) {
+        capacity *= 2;
+    }
+
+    Table* fresh = new Table(capacity);
+    for (std::size_t i = 0; i <= old->mask; ++i) {
+        Entry* entry = old->buckets[i].load(std::memory_order_relaxed);
+        if (!entry || entry == &tombstone) {
+            continue;
+        }
+        std::size_t slot = (hash(entry->id) >> 20) & fresh->mask;
+        while (fresh->buckets[slot].load(std::memory_order_relaxed)) {
+            slot = (slot + 1) & fresh->mask;
+        }
+        fresh->buckets[slot].store(entry, std::memory_order_relaxed);
+    }
+    shard.used = live;
+
+    // Entries move over as-is; only the old bucket array is retired
+    shard.table.store(fresh, std::memory_order_release);
+    Epoch::instance().retire([old]() { delete old; });
+}
+
+TaskRegistry::Segment::Segment(int firstId)
+    : firstId(firstId), slots(new std::atomic<Entry*>[SEGMENT_SIZE]) {
+    for (int i = 0; i < SEGMENT_SIZE; ++i) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+int TaskRegistry::allocateId() {
+    int id = nextId.fetch_add(1, std::memory_order_relaxed);
+    if (id < DENSE_BASE) {
+        throw std::overflow_error("Task ID space exhausted");  // wrapped past INT_MAX
+    }
+    return id;
+}
+
+std::size_t TaskRegistry::ringSlot(int id) {
+    return (static_cast<std::size_t>(id - DENSE_BASE) >> SEGMENT_BITS) % SEGMENT_RING;
+}
+
+int TaskRegistry::segmentStart(int id) {
+    return id - ((id - DENSE_BASE) & (SEGMENT_SIZE - 1));
+}
+
+TaskRegistry::Entry* TaskRegistry::findDense(int id) const {
+    if (id < DENSE_BASE) {
+        return nullptr;
+    }
+    const Segment* segment = segments[ringSlot(id)].load(std::memory_order_acquire);
+    if (!segment || segment->firstId != segmentStart(id)) {
+        return nullptr;
+    }
+    return segment->slots[(id - DENSE_BASE) & (SEGMENT_SIZE - 1)].load(std::memory_order_acquire);
+}
+
+bool TaskRegistry::insertDense(Entry* entry) {
+    const int id = entry->id;
+    if (id < DENSE_BASE) {
+        return false;
+    }
+    const std::size_t ring = ringSlot(id);
+    std::lock_guard<std::mutex> stripe(segmentLocks[ring % SEGMENT_STRIPES]);
+    Segment* segment = segments[ring].load(std::memory_order_relaxed);
+    if (!segment) {
+        segment = new Segment(segmentStart(id));
+        segments[ring].store(segment, std::memory_order_release);
+    } else if (segment->firstId != segmentStart(id)) {
+        return false;  // the ring wrapped onto a segment with tasks still in it
+    }
+    segment->slots[(id - DENSE_BASE) & (SEGMENT_SIZE - 1)].store(entry, std::memory_order_release);
+    ++segment->live;
+    denseLive.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+TaskRegistry::Entry* TaskRegistry::removeDense(int id) {
+    if (id < DENSE_BASE) {
+        return nullptr;
+    }
+    const std::size_t ring = ringSlot(id);
+    std::lock_guard<std::mutex> stripe(segmentLocks[ring % SEGMENT_STRIPES]);
+    Segment* segment = segments[ring].load(std::memory_order_relaxed);
+    if (!segment || segment->firstId != segmentStart(id)) {
+        return nullptr;
+    }
+    auto& slot = segment->slots[(id - DENSE_BASE) & (SEGMENT_SIZE - 1)];
+    Entry* entry = slot.load(std::memory_order_relaxed);
+    if (!entry) {
+        return nullptr;
+    }
+    slot.store(nullptr, std::memory_order_release);
+    --segment->live;
+    denseLive.fetch_sub(1, std::memory_order_relaxed);
+
+    // Empty and every ID in it handed out: free it (a late registration
+    // of one of its IDs simply allocates a fresh segment)
+    long long end = static_cast<long long>(segment->firstId) + SEGMENT_SIZE;
+    if (segment->live == 0 && end <= nextId.load(std::memory_order_relaxed)) {
+        segments[ring].store(nullptr, std::memory_order_release);
+        Epoch::instance().retire([segment]() { delete segment; });
+    }
+    return entry;
+}
+
+std::atomic<TaskRegistry::Entry*>* TaskRegistry::findHashed(Shard& shard, std::uint64_t h, int id) {
+    Table* table = shard.table.load(std::memory_order_relaxed);
+    std::size_t slot = (h >> 20) & table->mask;
+    while (Entry* entry = table->buckets[slot].load(std::memory_order_relaxed)) {
+        if (entry != &tombstone && entry->id == id) {
+            return &table->buckets[slot];
+        }
+        slot = (slot + 1) & table->mask;
     }
     return nullptr;
 }
 
+bool TaskRegistry::registerTask(const Task& task) {
+    const int id = task.getId();
+    const std::uint64_t h = hash(id);
+    Shard& shard = shardFor(h);
+    std::unique_lock<std::mutex> lock(shard.writeMtx);
+
+    // An ID lives in this shard's table or in its dense slot, and both only
+    // change under this lock
+    {
+        Epoch::Guard guard;
+        if (findHashed(shard, h, id) || findDense(id)) {
+            return false;
+        }
+    }
+
+    // A task registered before (then removed) keeps its node; the registry
+    // slot only ever holds a StateNode
+    auto handle = std::make_shared<Task>(task);
+    auto* node = static_cast<StateNode*>(
+        handle->attachStateHook(TaskHookSlot::REGISTRY, std::make_unique<StateNode>(&shard)));
+    {
+        std::lock_guard<std::mutex> index(shard.indexMtx);
+        node->task = handle;
+        link(shard, *node, handle->getState());
+    }
+
+    auto* entry = new Entry{id, std::move(handle), node};
+    shard.changes.fetch_add(1, std::memory_order_relaxed);
+    if (!insertDense(entry)) {
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        if ((shard.used + 1) * 2 > table->mask + 1) {
+            grow(shard);
+            table = shard.table.load(std::memory_order_relaxed);
+        }
+
+        // The ID is absent: take the first tombstone or empty bucket
+        std::size_t slot = (h >> 20) & table->mask;
+        Entry* current = table->buckets[slot].load(std::memory_order_relaxed);
+        while (current && current != &tombstone) {
+            slot = (slot + 1) & table->mask;
+            current = table->buckets[slot].load(std::memory_order_relaxed);
+        }
+        if (!current) {
+            ++shard.used;
+        }
+        table->buckets[slot].store(entry, std::memory_order_release);
+        shard.live.fetch_add(1, std::memory_order_relaxed);
+    }
+    lock.unlock();
+
+    // Amortized: a pass every quarter of the limit bounds the overshoot
+    std::size_t limit = maxFinished.load(std::memory_order_relaxed);
+    if (limit > 0) {
+        std::uint64_t every = limit / 4 > 0 ? limit / 4 : 1;
+        if ((registrations.fetch_add(1, std::memory_order_relaxed) + 1) % every == 0) {
+            signalRetention();
+        }
+    }
+    return true;
+}
+
+bool TaskRegistry::removeTask(int id) {
+    const std::uint64_t h = hash(id);
+    Shard& shard = shardFor(h);
+    std::lock_guard<std::mutex> lock(shard.writeMtx);
+
+    Entry* entry = nullptr;
+    if (std::atomic<Entry*>* bucket = findHashed(shard, h, id)) {
+        entry = bucket->load(std::memory_order_relaxed);
+        bucket->store(&tombstone, std::memory_order_release);
+        shard.live.fetch_sub(1, std::memory_order_relaxed);
+    } else {
+        entry = removeDense(id);
+    }
+    if (!entry) {
+        return false;
+    }
+    shard.changes.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> index(shard.indexMtx);
+        unlink(shard, *entry->node);
+    }
+    Epoch::instance().retire([entry]() { delete entry; });
+    return true;
+}
+
+std::shared_ptr<Task> TaskRegistry::getTask(int id) const {
+    const std::uint64_t h = hash(id);
+    const Shard& shard = shardFor(h);
+
+    Epoch::Guard guard;
+    Entry* found = findDense(id);
+    if (!found) {
+        const Table* table = shard.table.load(std::memory_order_acquire);
+        std::size_t slot = (h >> 20) & table->mask;
+        for (std::size_t probes = 0; probes <= table->mask; ++probes) {
+            Entry* entry = table->buckets[slot].load(std::memory_order_acquire);
+            if (!entry) {
+                break;
+            }
+            if (entry != &tombstone && entry->id == id) {
+                found = entry;
+                break;
+            }
+            slot = (slot + 1) & table->mask;
+        }
+    }
+    if (!found) {
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    shard.hits.fetch_add(1, std::memory_order_relaxed);
+    return found->task;
+}
+
+bool TaskRegistry::getArchivedTask(int id, TaskRecord& record) const {
+    record = Database::instance().getTask(id);
+    if (record.id == -1) {
+        coldMisses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    coldHits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename Visit>
+void TaskRegistry::forEach(Visit visit) const {
+    Epoch::Guard guard;
+    for (const auto& shard : shards) {
+        const Table* table = shard.table.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i <= table->mask; ++i) {
+            Entry* entry = table->buckets[i].load(std::memory_order_acquire);
+            if (entry && entry != &tombstone) {
+                visit(entry->task);
+            }
+        }
+    }
+    for (const auto& ring : segments) {
+        const Segment* segment = ring.load(std::memory_order_acquire);
+        if (!segment) {
+            continue;
+        }
+        for (int i = 0; i < SEGMENT_SIZE; ++i) {
+            if (Entry* entry = segment->slots[i].load(std::memory_order_acquire)) {
+                visit(entry->task);
+            }
+        }
+    }
+}
+
 std::vector<std::shared_ptr<Task>> TaskRegistry::getAllTasks() const {
-    std::lock_guard<std::mutex> lock(mtx);
     std::vector<std::shared_ptr<Task>> result;
-    for (const auto& pair : tasks) {
-        result.push_back(pair.second);
-    }
+    result.reserve(size());
+    forEach([&result](const std::shared_ptr<Task>& task) { result.push_back(task); });
+    std::sort(result.begin(), result.end(),
+              [](const auto& a, const auto& b) { return a->getId() < b->getId(); });
     return result;
 }
 
+void TaskRegistry::link(Shard& shard, StateNode& node, TaskState state) {
+    auto& head = shard.heads[static_cast<int>(state)];
+    node.prev = nullptr;
+    node.next = head;
+    if (head) {
+        head->prev = &node;
+    }
+    head = &node;
+    node.listed = state;
+    node.linked = true;
+    shard.counts[static_cast<int>(state)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void TaskRegistry::unlink(Shard& shard, StateNode& node) {
+    if (!node.linked) {
+        return;
+    }
+    if (node.prev) {
+        node.prev->next = node.next;
+    } else {
+        shard.heads[static_cast<int>(node.listed)] = node.next;
+    }
+    if (node.next) {
+        node.next->prev = node.prev;
+    }
+    node.prev = node.next = nullptr;
+    node.linked = false;
+    shard.counts[static_cast<int>(node.listed)].fetch_sub(1, std::memory_order_relaxed);
+}
+
+// Re-reads the state under the lock, so hooks of racing transitions that
+// run out of order still leave the task on the list for its final state
+void TaskRegistry::StateNode::onStateChange(const Task& changed) {
+    std::lock_guard<std::mutex> index(shard->indexMtx);
+    TaskState state = changed.getState();
+    if (!linked || state == listed) {
+        return;
+    }
+    unlink(*shard, *this);
+    link(*shard, *this, state);
+}
+
+std::uint64_t TaskRegistry::changeCount() const {
+    std::uint64_t total = 0;
+    for (const auto& shard : shards) {
+        total += shard.changes.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void TaskRegistry::setSnapshotInterval(std::chrono::milliseconds interval) {
+    snapshotIntervalNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count(),
+                             std::memory_order_relaxed);
+}
+
+std::shared_ptr<const RegistrySnapshot> TaskRegistry::getSnapshot() const {
+    const auto now = std::chrono::steady_clock::now();
+    const std::int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        now.time_since_epoch()).count();
+
+    Epoch::Guard guard;
+    PublishedSnapshot* current = published.load(std::memory_order_acquire);
+    if (current && nowNs - current->checkedAt.load(std::memory_order_relaxed) <
+                       snapshotIntervalNs.load(std::memory_order_relaxed)) {
+        return current->snapshot;
+    }
+
+    // Due for a check. Whoever gets the lock does it; the rest keep serving
+    // the current snapshot (only the very first caller has none to serve)
+    std::unique_lock<std::mutex> lock(snapshotMtx, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        if (current) {
+            return current->snapshot;
+        }
+        lock.lock();
+    }
+    current = published.load(std::memory_order_acquire);
+
+    // Read the version first: a change racing the scan forces the next rebuild
+    const std::uint64_t version = changeCount();
+    if (current && current->snapshot->version == version) {
+        current->checkedAt.store(nowNs, std::memory_order_relaxed);
+        return current->snapshot;
+    }
+
+    auto snapshot = std::make_shared<RegistrySnapshot>();
+    snapshot->version = version;
+    snapshot->takenAt = now;
+    snapshot->tasks = getAllTasks();
+
+    auto* fresh = new PublishedSnapshot{std::move(snapshot), {nowNs}};
+    published.store(fresh, std::memory_order_release);
+    if (current) {
+        Epoch::instance().retire([current]() { delete current; });
+    }
+    return fresh->snapshot;
+}
+
 std::vector<std::shared_ptr<Task>> TaskRegistry::getTasksByState(TaskState state) const {
-    std::lock_guard<std::mutex> lock(mtx);
     std::vector<std::shared_ptr<Task>> result;
-    for (const auto& pair : tasks) {
-        if (pair.second->getState() == state) {
-            result.push_back(pair.second);
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> index(shard.indexMtx);
+        for (StateNode* node = shard.heads[static_cast<int>(state)]; node; node = node->next) {
+            if (auto task = node->task.lock()) {
+                result.push_back(std::move(task));
+            }
         }
     }
+    std::sort(result.begin(), result.end(),
+              [](const auto& a, const auto& b) { return a->getId() < b->getId(); });
     return result;
 }
 
 void TaskRegistry::clear() {
-    std::lock_guard<std::mutex> lock(mtx);
-    tasks.clear();
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.writeMtx);
+        {
+            std::lock_guard<std::mutex> index(shard.indexMtx);
+            for (StateNode* head : shard.heads) {
+                while (head) {
+                    StateNode* next = head->next;
+                    unlink(shard, *head);
+                    head = next;
+                }
+            }
+        }
+        Table* old = shard.table.load(std::memory_order_relaxed);
+        shard.table.store(new Table(INITIAL_CAPACITY), std::memory_order_release);
+        shard.used = 0;
+        shard.live.store(0, std::memory_order_relaxed);
+        shard.changes.fetch_add(1, std::memory_order_relaxed);
+        shard.hits.store(0, std::memory_order_relaxed);
+        shard.misses.store(0, std::memory_order_relaxed);
+        Epoch::instance().retire([old]() {
+            for (std::size_t i = 0; i <= old->mask; ++i) {
+                Entry* entry = old->buckets[i].load(std::memory_order_relaxed);
+                if (entry && entry != &tombstone) {
+                    delete entry;
+                }
+            }
+            delete old;
+        });
+    }
+    for (std::size_t ring = 0; ring < SEGMENT_RING; ++ring) {
+        std::lock_guard<std::mutex> stripe(segmentLocks[ring % SEGMENT_STRIPES]);
+        Segment* segment = segments[ring].exchange(nullptr, std::memory_order_acq_rel);
+        if (!segment) {
+            continue;
+        }
+        denseLive.fetch_sub(segment->live, std::memory_order_relaxed);
+        Epoch::instance().retire([segment]() {
+            for (int i = 0; i < SEGMENT_SIZE; ++i) {
+                delete segment->slots[i].load(std::memory_order_relaxed);
+            }
+            delete segment;
+        });
+    }
+    if (PublishedSnapshot* stale = published.exchange(nullptr, std::memory_order_acq_rel)) {
+        Epoch::instance().retire([stale]() { delete stale; });
+    }
+    spilled.store(0, std::memory_order_relaxed);
+    dropped.store(0, std::memory_order_relaxed);
+    coldHits.store(0, std::memory_order_relaxed);
+    coldMisses.store(0, std::memory_order_relaxed);
+}
+
+std::size_t TaskRegistry::countByState(TaskState state) const {
+    std::size_t total = 0;
+    for (const auto& shard : shards) {
+        total += shard.counts[static_cast<int>(state)].load(std::memory_order_relaxed);
+    }
+    return total;
 }
 
 size_t TaskRegistry::size() const {
-    std::lock_guard<std::mutex> lock(mtx);
-    return tasks.size();
+    std::size_t total = 0;
+    for (const auto& shard : shards) {
+        total += shard.live.load(std::memory_order_relaxed);
+    }
+    return total + denseLive.load(std::memory_order_relaxed);
+}
+
+void TaskRegistry::setRetention(std::size_t limit) {
+    maxFinished.store(limit, std::memory_order_relaxed);
+}
+
+// Finished for good: a FAILED task may still be between attempts
+static bool isFinished(const Task& task) {
+    switch (task.getState()) {
+        case TaskState::COMPLETED:
+        case TaskState::REJECTED:
+        case TaskState::CANCELLED:
+            return true;
+        case TaskState::FAILED:
+            return !task.shouldRetry();
+        default:
+            return false;
+    }
+}
+
+// Steady-clock instants mapped onto the wall clock ("" if never set)
+static std::string timestamp(std::chrono::steady_clock::time_point at) {
+    if (at == std::chrono::steady_clock::time_point{}) {
+        return "";
+    }
+    auto wall = std::chrono::system_clock::now() -
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::steady_clock::now() - at);
+    std::time_t time = std::chrono::system_clock::to_time_t(wall);
+    std::ostringstream oss;
+    oss << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S");
+    return oss.str();
 }
 
+static TaskRecord toRecord(const Task& task) {
+    TaskRecord record;
+    record.id = task.getId();
+    record.name = (task.getType().empty() ? "task" : task.getType()) + "-" + std::to_string(task.getId());
+    switch (task.getPriority()) {
+        case TaskPriority::HIGH: record.priority = "HIGH"; break;
+        case TaskPriority::MEDIUM: record.priority = "MEDIUM"; break;
+        case TaskPriority::LOW: record.priority = "LOW"; break;
+    }
+    record.max_retries = task.getMaxRetries();
+    record.retry_count = task.getRetryCount();
+    record.state = static_cast<int>(task.getState());
+    record.type = task.getType();
+    record.started_at = timestamp(task.getStartTime());
+    record.completed_at = timestamp(task.getEndTime());
+    record.created_at = timestamp(task.getEnqueueTime());
+    if (record.created_at.empty()) {
+        record.created_at = !record.completed_at.empty() ? record.completed_at
+                                                         : timestamp(std::chrono::steady_clock::now());
+    }
+    if (task.getThreadId() != std::thread::id()) {
+        std::ostringstream oss;
+        oss << task.getThreadId();
+        record.thread_id = oss.str();
+    }
+    record.error_message = task.getRejectReason();
+    return record;
+}
+
+void TaskRegistry::enforceRetention() {
+    std::unique_lock<std::mutex> lock(retentionMtx, std::try_to_lock);
+    std::size_t limit = maxFinished.load(std::memory_order_relaxed);
+    if (!lock.owns_lock() || limit == 0) {
+        return;  // another pass is already running
+    }
+
+    const TaskState finishedStates[] = {TaskState::COMPLETED, TaskState::FAILED,
+                                        TaskState::REJECTED, TaskState::CANCELLED};
+    std::size_t candidates = 0;
+    for (TaskState state : finishedStates) {
+        candidates += countByState(state);
+    }
+    if (candidates <= limit) {
+        return;
+    }
+
+    std::vector<std::shared_ptr<Task>> finished;
+    for (TaskState state : finishedStates) {
+        for (auto& task : getTasksByState(state)) {
+            if (isFinished(*task)) {
+                finished.push_back(std::move(task));
+            }
+        }
+    }
+    if (finished.size() <= limit) {
+        return;
+    }
+
+    // Oldest first: everything before the newest `limit` leaves memory
+    std::size_t evict = finished.size() - limit;
+    std::nth_element(finished.begin(), finished.begin() + evict, finished.end(),
+                     [](const auto& a, const auto& b) { return a->getEndTime() < b->getEndTime(); });
+    finished.resize(evict);
+
+    std::vector<TaskRecord> records;
+    records.reserve(evict);
+    for (const auto& task : finished) {
+        records.push_back(toRecord(*task));
+    }
+    bool saved = Database::instance().saveTasks(records);
+    if (!saved) {
+        Logger::warn("Registry retention: database unavailable, dropping " +
+                     std::to_string(evict) + " finished tasks");
+    }
+
+    for (const auto& task : finished) {
+        removeTask(task->getId());
+    }
+    (saved ? spilled : dropped).fetch_add(evict, std::memory_order_relaxed);
+}
+
+void TaskRegistry::signalRetention() {
+    {
+        std::lock_guard<std::mutex> lock(retentionWakeMtx);
+        if (retentionStop) {
+            return;
+        }
+        if (!retentionThread.joinable()) {
+            retentionThread = std::thread(&TaskRegistry::retentionLoop, this);
+        }
+        retentionDue = true;
+    }
+    retentionCv.notify_one();
+}
+
+// Signals that arrive during a pass coalesce into one more pass
+void TaskRegistry::retentionLoop() {
+    std::unique_lock<std::mutex> lock(retentionWakeMtx);
+    while (true) {
+        retentionCv.wait(lock, [this]() { return retentionDue || retentionStop; });
+        if (retentionStop) {
+            return;
+        }
+        retentionDue = false;
+        lock.unlock();
+        enforceRetention();
+        lock.lock();
+    }
+}
+
+RegistryStats TaskRegistry::getStats() const {
+    RegistryStats stats;
+    stats.hot = size();
+    stats.spilled = spilled.load(std::memory_order_relaxed);
+    stats.dropped = dropped.load(std::memory_order_relaxed);
+    for (const auto& shard : shards) {
+        stats.hotHits += shard.hits.load(std::memory_order_relaxed);
+        stats.hotMisses += shard.misses.load(std::memory_order_relaxed);
+    }
+    stats.coldHits = coldHits.load(std::memory_order_relaxed);
+    stats.coldMisses = coldMisses.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -1,36 +1,236 @@
 #pragma once
 
-#include <map>
-#include <mutex>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "../src/core/Task.h"
+#include "../utils/Database.h"
+
+struct RegistryStats {
+    std::size_t hot = 0;            // tasks held in memory
+    std::uint64_t spilled = 0;      // finished tasks moved to the database
+    std::uint64_t dropped = 0;      // finished tasks evicted with no database
+    std::uint64_t hotHits = 0;
+    std::uint64_t hotMisses = 0;
+    std::uint64_t coldHits = 0;     // misses answered from the database
+    std::uint64_t coldMisses = 0;
+
+    double hotHitRatio() const {
+        auto lookups = hotHits + hotMisses;
+        return lookups > 0 ? static_cast<double>(hotHits) / lookups : 0.0;
+    }
+    double coldHitRatio() const {
+        auto lookups = coldHits + coldMisses;
+        return lookups > 0 ? static_cast<double>(coldHits) / lookups : 0.0;
+    }
+};
+
+// Immutable listing of the registry. Membership and order are fixed at
+// build time; task fields read through the handles are live.
+struct RegistrySnapshot {
+    std::uint64_t version = 0;  // registrations + removals seen
+    std::chrono::steady_clock::time_point takenAt;
+    std::vector<std::shared_ptr<Task>> tasks;  // ordered by ID
+};
 
-// Registry to track all tasks (in-memory storage)
+// Registry to track all tasks (in-memory storage). Entries share the task's
+// control block with the executor, so reads see live state.
+//
+// Sharded open-addressing hash map. Writers serialize per shard; readers
+// take no lock at all and are protected by epoch-based reclamation, so a
+// lookup or listing never waits on (or blocks) a registration.
+//
+// Each task also carries a state hook linking it into its shard's list for
+// its current state, so counting by state is O(1) and listing a state costs
+// the size of the result.
+//
+// IDs from allocateId() start at DENSE_BASE and are stored in a ring of
+// fixed-size segments indexed directly by ID: O(1) lookup without hashing,
+// with neighbouring IDs on neighbouring slots. A segment is freed once all
+// of its IDs were allocated and its tasks removed.
+//
+// getSnapshot() serves list endpoints from a published snapshot: one atomic
+// pointer load while it is younger than the snapshot interval, and a
+// rebuild (by one reader, off the write path) only if tasks came or went.
+//
+// With a retention limit, active tasks and the most recently finished ones
+// stay in memory; older finished tasks are spilled to the database, where
+// getArchivedTask() still finds them. Spilling runs on a background thread
+// that registrations only wake, so submits never wait on database I/O.
 class TaskRegistry {
 public:
     static TaskRegistry& instance();
     
-    // Register a task
-    void registerTask(const Task& task);
+    // First server-assigned ID; clients may choose IDs below it
+    static constexpr int DENSE_BASE = 1 << 30;
+    
+    // Next server-assigned ID (monotonic). Throws std::overflow_error once
+    // the ID space is exhausted
+    int allocateId();
     
-    // Get task by ID
+    // Register a task (shares it; no copy of its state is taken). Atomic
+    // insert-if-absent: false if the ID is already registered.
+    bool registerTask(const Task& task);
+    
+    // Remove a task; false if it was not registered
+    bool removeTask(int id);
+    
+    // Get task by ID (in memory only)
     std::shared_ptr<Task> getTask(int id) const;
     
-    // Get all tasks
+    // Look up a task spilled to the database; false if it is not there
+    bool getArchivedTask(int id, TaskRecord& record) const;
+    
+    // Get all tasks, ordered by ID
     std::vector<std::shared_ptr<Task>> getAllTasks() const;
     
-    // Get tasks by state
+    // Published listing, rebuilt at most once per interval and only when
+    // tasks were registered or removed since the last one
+    std::shared_ptr<const RegistrySnapshot> getSnapshot() const;
+    void setSnapshotInterval(std::chrono::milliseconds interval);
+    
+    // Get tasks by state, ordered by ID
     std::vector<std::shared_ptr<Task>> getTasksByState(TaskState state) const;
     
+    // Number of registered tasks in a state
+    std::size_t countByState(TaskState state) const;
+    
     // Clear registry (for testing)
     void clear();
     
     size_t size() const;
+    
+    // Keep at most maxFinished finished tasks in memory (0 = keep all).
+    // Every few registrations wake the retention thread; enforceRetention()
+    // runs a pass on the calling thread
+    void setRetention(std::size_t maxFinished);
+    void enforceRetention();
+    
+    RegistryStats getStats() const;
+
+    ~TaskRegistry();
 
 private:
-    TaskRegistry() = default;
+    TaskRegistry();
     
-    mutable std::mutex mtx;
-    std::map<int, std::shared_ptr<Task>> tasks;
+    struct Shard;
+    
+    // Intrusive link of a task into its shard's per-state list. Owned by the
+    // task; links and `listed` are guarded by the shard's indexMtx
+    struct StateNode : TaskStateHook {
+        explicit StateNode(Shard* shard) : shard(shard) {}
+        void onStateChange(const Task& task) override;
+        
+        Shard* shard;
+        std::weak_ptr<Task> task;  // the registry entry's handle
+        bool linked = false;
+        TaskState listed = TaskState::CREATED;
+        StateNode* prev = nullptr;
+        StateNode* next = nullptr;
+    };
+    
+    struct Entry {
+        int id;
+        std::shared_ptr<Task> task;
+        StateNode* node;
+    };
+    
+    // Linear-probing table; a bucket is null (never used), the tombstone
+    // (removed) or a live entry. Replaced wholesale when it grows.
+    struct Table {
+        explicit Table(std::size_t capacity);
+        std::size_t mask;
+        std::unique_ptr<std::atomic<Entry*>[]> buckets;
+    };
+    
+    struct alignas(64) Shard {
+        mutable std::mutex writeMtx;
+        std::atomic<Table*> table{nullptr};
+        std::size_t used = 0;             // live + tombstones, under writeMtx
+        std::atomic<std::size_t> live{0};
+        std::atomic<std::uint64_t> changes{0};  // registrations + removals
+        mutable std::atomic<std::uint64_t> hits{0};
+        mutable std::atomic<std::uint64_t> misses{0};
+        
+        mutable std::mutex indexMtx;
+        std::array<StateNode*, TASK_STATE_COUNT> heads{};
+        std::array<std::atomic<std::size_t>, TASK_STATE_COUNT> counts{};
+    };
+    
+    // Slots for SEGMENT_SIZE consecutive dense IDs from firstId
+    struct Segment {
+        explicit Segment(int firstId);
+        const int firstId;
+        std::size_t live = 0;  // under the segment's stripe lock
+        std::unique_ptr<std::atomic<Entry*>[]> slots;
+    };
+    
+    static constexpr std::size_t SHARDS = 16;
+    static constexpr std::size_t INITIAL_CAPACITY = 64;
+    
+    static std::uint64_t hash(int id);
+    Shard& shardFor(std::uint64_t h) const;
+    // Caller holds writeMtx. Rehash live entries into a table sized for them
+    void grow(Shard& shard);
+    template <typename Visit>
+    void forEach(Visit visit) const;
+    // Caller holds the shard's indexMtx
+    static void link(Shard& shard, StateNode& node, TaskState state);
+    static void unlink(Shard& shard, StateNode& node);
+    
+    static constexpr int SEGMENT_BITS = 12;
+    static constexpr int SEGMENT_SIZE = 1 << SEGMENT_BITS;
+    static constexpr std::size_t SEGMENT_RING = 4096;  // 16M IDs in flight
+    static constexpr std::size_t SEGMENT_STRIPES = 64;
+    
+    static std::size_t ringSlot(int id);
+    static int segmentStart(int id);
+    // Caller is pinned (Epoch::Guard)
+    Entry* findDense(int id) const;
+    // False if the ID's ring slot still holds an older segment
+    bool insertDense(Entry* entry);
+    Entry* removeDense(int id);
+    // Caller holds writeMtx; the bucket holding the ID, or null
+    std::atomic<Entry*>* findHashed(Shard& shard, std::uint64_t h, int id);
+    
+    struct PublishedSnapshot {
+        std::shared_ptr<const RegistrySnapshot> snapshot;
+        std::atomic<std::int64_t> checkedAt;  // steady-clock ns of the last freshness check
+    };
+    std::uint64_t changeCount() const;
+    
+    // Wake the retention thread, starting it on first use
+    void signalRetention();
+    void retentionLoop();
+    
+    static Entry tombstone;
+    mutable std::array<Shard, SHARDS> shards;
+    
+    std::array<std::atomic<Segment*>, SEGMENT_RING> segments{};
+    std::array<std::mutex, SEGMENT_STRIPES> segmentLocks;
+    mutable std::atomic<PublishedSnapshot*> published{nullptr};
+    mutable std::mutex snapshotMtx;  // one rebuild at a time
+    std::atomic<std::int64_t> snapshotIntervalNs{100000000};
+    
+    std::atomic<int> nextId{DENSE_BASE};
+    std::atomic<std::size_t> denseLive{0};
+    
+    std::atomic<std::size_t> maxFinished{0};
+    std::atomic<std::uint64_t> registrations{0};
+    std::mutex retentionMtx;  // one retention pass at a time
+    std::mutex retentionWakeMtx;
+    std::condition_variable retentionCv;
+    bool retentionDue = false;   // under retentionWakeMtx
+    bool retentionStop = false;  // under retentionWakeMtx
+    std::thread retentionThread;
+    std::atomic<std::uint64_t> spilled{0};
+    std::atomic<std::uint64_t> dropped{0};
+    mutable std::atomic<std::uint64_t> coldHits{0};
+    mutable std::atomic<std::uint64_t> coldMisses{0};
 };
-
@@ -6,25 +6,35 @@ Task::Task(int id,
            TaskPriority priority,
            std::function<void()> fn,
            int maxRetries)
-    : id(id),
-      priority(priority),
-      fn(std::move(fn)),
-      state(TaskState::CREATED),
-      enqueueTime(),
-      startTime(),
-      endTime(),
-      threadId(),
-      retryCount(0),
-      maxRetries(maxRetries) {}
+    : ctl(std::make_shared<Control>(id, priority, std::move(fn), maxRetries)) {}
+
+Task Task::clone(std::function<void()> fn) const {
+    Task copy(ctl->id, getPriority(), std::move(fn), ctl->maxRetries);
+    copy.ctl->externalId = ctl->externalId;
+    copy.ctl->type = ctl->type;
+    copy.ctl->paramsHash = ctl->paramsHash;
+    copy.ctl->tenant = ctl->tenant;
+    copy.ctl->metricsKey = ctl->metricsKey;
+    copy.ctl->concurrencyKey = ctl->concurrencyKey;
+    copy.ctl->maxConcurrency = ctl->maxConcurrency;
+    copy.ctl->dedupKey = ctl->dedupKey;
+    copy.ctl->sheddable = ctl->sheddable;
+    return copy;
+}
 
 bool Task::canTransition(TaskState from, TaskState to) const {
     switch (from) {
         case TaskState::CREATED:
-            return to == TaskState::READY;
+            return to == TaskState::READY ||
+                   to == TaskState::CANCELLED;
 
         case TaskState::READY:
             return to == TaskState::RUNNING ||
-                   to == TaskState::READY;
+                   to == TaskState::READY ||
+                   to == TaskState::REJECTED ||
+                   to == TaskState::COMPLETED ||  // result cache hit
+                   to == TaskState::FAILED ||     // dropped while queued
+                   to == TaskState::CANCELLED;
 
         case TaskState::RUNNING:
             return to == TaskState::COMPLETED ||
@@ -41,89 +51,291 @@ bool Task::canTransition(TaskState from, TaskState to) const {
     }
 }
 
+bool Task::transitionTo(TaskState to) {
+    TaskState current = ctl->state.load();
+    do {
+        if (!canTransition(current, to))
+            return false;
+    } while (!ctl->state.compare_exchange_weak(current, to));
+    notifyStateChange();
+    return true;
+}
+
+void Task::notifyStateChange() const {
+    for (const auto& slot : ctl->stateHooks) {
+        if (TaskStateHook* hook = slot.load(std::memory_order_acquire))
+            hook->onStateChange(*this);
+    }
+}
+
+TaskStateHook* Task::attachStateHook(TaskHookSlot slot, std::unique_ptr<TaskStateHook> hook) {
+    auto& target = ctl->stateHooks[static_cast<std::size_t>(slot)];
+    TaskStateHook* current = nullptr;
+    if (target.compare_exchange_strong(current, hook.get(), std::memory_order_acq_rel))
+        return hook.release();
+    return current;
+}
+
+// Times are stored before the CAS publishes the state, and put back if the
+// CAS loses to a racing transition
 void Task::markReady() {
-    if (!canTransition(state, TaskState::READY))
+    if (!canTransition(ctl->state.load(), TaskState::READY))
         return;
 
-    state = TaskState::READY;
-    enqueueTime = std::chrono::steady_clock::now();
+    const auto now = std::chrono::steady_clock::now();
+    const auto previous = ctl->enqueueTime.exchange(now, std::memory_order_release);
+    auto unset = std::chrono::steady_clock::time_point();
+    const bool firstReady = ctl->readyTime.compare_exchange_strong(unset, now, std::memory_order_release);
+    if (!transitionTo(TaskState::READY)) {
+        ctl->enqueueTime.store(previous, std::memory_order_release);
+        if (firstReady)
+            ctl->readyTime.store(unset, std::memory_order_release);
+    }
 }
 
 void Task::execute() {
-    if (!canTransition(state, TaskState::RUNNING))
+    if (ctl->state.load() != TaskState::READY)
         return;
 
-    state = TaskState::RUNNING;
-    startTime = std::chrono::steady_clock::now();
+    const auto previous = ctl->startTime.exchange(std::chrono::steady_clock::now(),
+                                                  std::memory_order_release);
+    if (!transitionTo(TaskState::RUNNING)) {
+        ctl->startTime.store(previous, std::memory_order_release);
+        return;
+    }
 
     try {
-        fn();
-        state = TaskState::COMPLETED;
+        ctl->fn();
     } catch (...) {
-        state = TaskState::FAILED;
-        endTime = std::chrono::steady_clock::now();
-        threadId = std::this_thread::get_id();
+        ctl->threadId = std::this_thread::get_id();
+        ctl->endTime.store(std::chrono::steady_clock::now(), std::memory_order_release);
+        transitionTo(TaskState::FAILED);
         throw;
     }
 
-    endTime = std::chrono::steady_clock::now();
-    threadId = std::this_thread::get_id();
+    ctl->threadId = std::this_thread::get_id();
+    ctl->endTime.store(std::chrono::steady_clock::now(), std::memory_order_release);
+    transitionTo(TaskState::COMPLETED);
+    ctl->dedupHandle.reset();
 }
 
 bool Task::shouldRetry() const {
-    return retryCount < maxRetries;
+    return ctl->retryCount < ctl->maxRetries;
 }
 
 void Task::markRetry() {
     if (!shouldRetry())
         return;
 
-    if (!canTransition(state, TaskState::RETRYING))
+    if (!transitionTo(TaskState::RETRYING))
         return;
 
-    state = TaskState::RETRYING;
-    ++retryCount;
+    ++ctl->retryCount;
 
     // Move back to READY and capture a new enqueue time
     markReady();
 }
 
+// The mark* methods below are called by whoever holds the task (taken out
+// of a scheduler, or not yet queued), so nothing else writes its fields.
+// Times are written before the CAS publishes the final state, so a reader
+// that sees the state also sees them.
+
+// READY -> FAILED drops a queued task. After execute() threw for the last
+// time the task is FAILED already: the state is left alone and only the
+// dedup claim, kept across retries, is released.
 void Task::markFailed() {
-    state = TaskState::FAILED;
+    const TaskState current = ctl->state.load();
+    if (current == TaskState::FAILED) {
+        ctl->dedupHandle.reset();
+        return;
+    }
+    if (!canTransition(current, TaskState::FAILED))
+        return;
+
+    ctl->endTime.store(std::chrono::steady_clock::now(), std::memory_order_release);
+    if (transitionTo(TaskState::FAILED))
+        ctl->dedupHandle.reset();
+}
+
+void Task::markRejected(const std::string& reason) {
+    if (!canTransition(ctl->state.load(), TaskState::REJECTED))
+        return;
+
+    ctl->rejectReason = reason;
+    ctl->endTime.store(std::chrono::steady_clock::now(), std::memory_order_release);
+    if (transitionTo(TaskState::REJECTED))
+        ctl->dedupHandle.reset();
+}
+
+void Task::markCompletedFromCache() {
+    if (ctl->state.load() != TaskState::READY)
+        return;
+
+    const auto now = std::chrono::steady_clock::now();
+    ctl->threadId = std::this_thread::get_id();
+    ctl->startTime.store(now, std::memory_order_release);
+    ctl->endTime.store(now, std::memory_order_release);
+    if (transitionTo(TaskState::COMPLETED))
+        ctl->dedupHandle.reset();
+}
+
+void Task::markCancelled() {
+    if (!canTransition(ctl->state.load(), TaskState::CANCELLED))
+        return;
+
+    ctl->endTime.store(std::chrono::steady_clock::now(), std::memory_order_release);
+    if (transitionTo(TaskState::CANCELLED))
+        ctl->dedupHandle.reset();
 }
 
 int Task::getId() const {
-    return id;
+    return ctl->id;
+}
+
+void Task::setExternalId(int externalId) {
+    ctl->externalId = externalId;
+}
+
+int Task::getExternalId() const {
+    return ctl->externalId;
 }
 
 TaskPriority Task::getPriority() const {
-    return priority;
+    return ctl->priority;
 }
 
 TaskState Task::getState() const {
-    return state;
+    return ctl->state;
 }
 
 std::chrono::steady_clock::time_point Task::getEnqueueTime() const {
-    return enqueueTime;
+    return ctl->enqueueTime.load(std::memory_order_acquire);
+}
+
+std::chrono::steady_clock::time_point Task::getReadyTime() const {
+    return ctl->readyTime.load(std::memory_order_acquire);
 }
 
 std::chrono::steady_clock::time_point Task::getStartTime() const {
-    return startTime;
+    return ctl->startTime.load(std::memory_order_acquire);
 }
 
 std::chrono::steady_clock::time_point Task::getEndTime() const {
-    return endTime;
+    return ctl->endTime.load(std::memory_order_acquire);
 }
 
 std::thread::id Task::getThreadId() const {
-    return threadId;
+    return ctl->threadId;
 }
 
 int Task::getRetryCount() const {
-    return retryCount;
+    return ctl->retryCount;
 }
 
 int Task::getMaxRetries() const {
-    return maxRetries;
+    return ctl->maxRetries;
+}
+
+void Task::setPriority(TaskPriority priority) {
+    ctl->priority = priority;
+}
+
+void Task::setType(const std::string& type) {
+    ctl->type = type;
+    ctl->metricsKey = nullptr;
+}
+
+const std::string& Task::getType() const {
+    return ctl->type;
+}
+
+void Task::setParamsHash(std::size_t hash) {
+    ctl->paramsHash = hash;
+}
+
+std::size_t Task::getParamsHash() const {
+    return ctl->paramsHash;
+}
+
+void Task::setTenant(const std::string& tenant) {
+    ctl->tenant = tenant;
+    ctl->metricsKey = nullptr;
+}
+
+const std::string& Task::getTenant() const {
+    return ctl->tenant;
+}
+
+void Task::setMetricsKey(const MetricsKey* key) {
+    ctl->metricsKey = key;
+}
+
+const MetricsKey* Task::getMetricsKey() const {
+    return ctl->metricsKey;
+}
+
+void Task::setConcurrencyLimit(const std::string& key, int maxConcurrency) {
+    ctl->concurrencyKey = key;
+    ctl->maxConcurrency = maxConcurrency;
+}
+
+const std::string& Task::getConcurrencyKey() const {
+    return ctl->concurrencyKey;
+}
+
+int Task::getMaxConcurrency() const {
+    return ctl->maxConcurrency;
+}
+
+void Task::setDedupKey(const std::string& key) {
+    ctl->dedupKey = key;
+}
+
+const std::string& Task::getDedupKey() const {
+    return ctl->dedupKey;
+}
+
+void Task::setDedupHandle(std::shared_ptr<void> handle) {
+    ctl->dedupHandle = std::move(handle);
+}
+
+const std::shared_ptr<void>& Task::getDedupHandle() const {
+    return ctl->dedupHandle;
+}
+
+void Task::resetEnqueueTime() {
+    ctl->enqueueTime.store(std::chrono::steady_clock::now(), std::memory_order_release);
+}
+
+void Task::setSheddable(bool sheddable) {
+    ctl->sheddable = sheddable;
+}
+
+bool Task::isSheddable() const {
+    return ctl->sheddable;
+}
+
+const std::string& Task::getRejectReason() const {
+    return ctl->rejectReason;
+}
+
+void Task::setRunAt(std::chrono::steady_clock::time_point runAt) {
+    ctl->runAt = runAt;
+}
+
+std::chrono::steady_clock::time_point Task::getRunAt() const {
+    return ctl->runAt;
+}
+
+void Task::setDeadline(std::chrono::steady_clock::time_point deadline) {
+    ctl->deadline = deadline;
+}
+
+bool Task::hasDeadline() const {
+    return ctl->deadline != std::chrono::steady_clock::time_point();
+}
+
+std::chrono::steady_clock::time_point Task::getDeadline() const {
+    return ctl->deadline;
 }
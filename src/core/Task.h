@@ -1,7 +1,12 @@
 #pragma once
+#include <array>
+#include <atomic>
 #include <functional>
 #include <chrono>
 #include <thread>
+#include <string>
+#include <cstddef>
+#include <memory>
 
 #include "TaskState.h"
 
@@ -11,6 +16,31 @@ enum class TaskPriority {
     HIGH = 2
 };
 
+class Task;
+struct MetricsKey;
+
+// Notified after each state change of the task it is attached to, e.g. by an
+// index of tasks by state. Owned by the task's control block.
+class TaskStateHook {
+public:
+    virtual ~TaskStateHook() = default;
+    virtual void onStateChange(const Task& task) = 0;
+};
+
+// Each kind of observer has its own hook slot on a task, so one never finds
+// another's hook in place of its own
+enum class TaskHookSlot {
+    REGISTRY = 0,  // TaskRegistry's per-state index link
+    SOURCE = 1,    // whatever produced the task, e.g. a recurring job
+};
+constexpr std::size_t TASK_HOOK_SLOTS = 2;
+
+// Handle to a task's reference-counted control block. Copies share it, so
+// the registry, the scheduler and the worker all see one task: state is an
+// atomic advanced by compare-and-swap along canTransition(), and can be read
+// from any thread without a lock. Use clone() for an independent task.
+// Attributes are set before submission; afterwards only the scheduler holding
+// the task changes its priority or enqueue time.
 class Task {
 public:
     Task(int id,
@@ -18,36 +48,136 @@ public:
          std::function<void()> fn,
          int maxRetries = 0);
 
+    // Fresh CREATED task with the same id and attributes, running fn
+    Task clone(std::function<void()> fn) const;
+
     void markReady();
     void execute();
 
     bool shouldRetry() const;
     void markRetry();
     void markFailed();
+    void markRejected(const std::string& reason);
+    // READY -> COMPLETED without running: the result came from the cache
+    void markCompletedFromCache();
+    // CREATED/READY -> CANCELLED: withdrawn before it ever ran
+    void markCancelled();
+
+    // Attach a state hook to a slot (taking ownership) unless the slot is
+    // taken already; returns the slot's hook either way
+    TaskStateHook* attachStateHook(TaskHookSlot slot, std::unique_ptr<TaskStateHook> hook);
 
     int getId() const;
+    // Client-chosen ID when the server assigned getId() (0 = none)
+    void setExternalId(int externalId);
+    int getExternalId() const;
     TaskPriority getPriority() const;
     TaskState getState() const;
     std::chrono::steady_clock::time_point getEnqueueTime() const;
+    // When the task first became READY; end-to-end latency counts from here
+    std::chrono::steady_clock::time_point getReadyTime() const;
     std::chrono::steady_clock::time_point getStartTime() const;
     std::chrono::steady_clock::time_point getEndTime() const;
     std::thread::id getThreadId() const;
     int getRetryCount() const;
     int getMaxRetries() const;
 
+    // Change the priority; once queued, only the scheduler holding the task may
+    void setPriority(TaskPriority priority);
+
+    // Task type (e.g. "sleep", "print") used for per-type estimates
+    void setType(const std::string& type);
+    const std::string& getType() const;
+
+    // Hash of the task's parameters (0 = unknown), for per-params estimates
+    void setParamsHash(std::size_t hash);
+    std::size_t getParamsHash() const;
+
+    // Tenant the task is submitted on behalf of (empty = none), for per-tenant limits
+    void setTenant(const std::string& tenant);
+    const std::string& getTenant() const;
+
+    // Pre-resolved metrics key for (type, tenant), set at submission;
+    // setType/setTenant clear it
+    void setMetricsKey(const MetricsKey* key);
+    const MetricsKey* getMetricsKey() const;
+
+    // At most maxConcurrency tasks sharing a concurrency key run at once (empty = no limit)
+    void setConcurrencyLimit(const std::string& key, int maxConcurrency);
+    const std::string& getConcurrencyKey() const;
+    int getMaxConcurrency() const;
+
+    // Identical pending submissions with the same dedup key are coalesced (empty = never)
+    void setDedupKey(const std::string& key);
+    const std::string& getDedupKey() const;
+
+    // Opaque claim held while the task is pending in a dedup index; the index
+    // sees the claim expire if the task is dropped without being dispatched
+    void setDedupHandle(std::shared_ptr<void> handle);
+    const std::shared_ptr<void>& getDedupHandle() const;
+
+    // Restart the queueing clock, e.g. after being held back by a rate limit
+    void resetEnqueueTime();
+
+    // Whether overload control may shed this task
+    void setSheddable(bool sheddable);
+    bool isSheddable() const;
+    const std::string& getRejectReason() const;
+
+    // Earliest time the task may be queued (default: immediately)
+    void setRunAt(std::chrono::steady_clock::time_point runAt);
+    std::chrono::steady_clock::time_point getRunAt() const;
+
+    // Optional absolute completion deadline
+    void setDeadline(std::chrono::steady_clock::time_point deadline);
+    bool hasDeadline() const;
+    std::chrono::steady_clock::time_point getDeadline() const;
+
 private:
+    struct Control {
+        int id;
+        int externalId = 0;
+        std::atomic<TaskPriority> priority;
+        std::function<void()> fn;
+
+        std::atomic<TaskState> state{TaskState::CREATED};
+        // Atomic so readers that see a state (acquire) see the times
+        // written before it was published
+        std::atomic<std::chrono::steady_clock::time_point> enqueueTime{};
+        std::atomic<std::chrono::steady_clock::time_point> readyTime{};
+        std::atomic<std::chrono::steady_clock::time_point> startTime{};
+        std::atomic<std::chrono::steady_clock::time_point> endTime{};
+        std::thread::id threadId;
+
+        std::atomic<int> retryCount{0};
+        int maxRetries = 0;
+
+        std::string type;
+        std::size_t paramsHash = 0;
+        std::string tenant;
+        const MetricsKey* metricsKey = nullptr;
+        std::string concurrencyKey;
+        int maxConcurrency = 0;
+        std::string dedupKey;
+        std::shared_ptr<void> dedupHandle;
+        std::chrono::steady_clock::time_point runAt;
+        std::chrono::steady_clock::time_point deadline;
+        bool sheddable = false;
+        std::string rejectReason;
+        std::array<std::atomic<TaskStateHook*>, TASK_HOOK_SLOTS> stateHooks{};
+
+        Control(int id, TaskPriority priority, std::function<void()> fn, int maxRetries)
+            : id(id), priority(priority), fn(std::move(fn)), maxRetries(maxRetries) {}
+        ~Control() {
+            for (auto& hook : stateHooks)
+                delete hook.load();
+        }
+    };
 
     bool canTransition(TaskState from, TaskState to) const;
-    int id;
-    TaskPriority priority;
-    std::function<void()> fn;
-
-    TaskState state;
-    std::chrono::steady_clock::time_point enqueueTime;
-    std::chrono::steady_clock::time_point startTime;
-    std::chrono::steady_clock::time_point endTime;
-    std::thread::id threadId;
-
-    int retryCount = 0;
-    int maxRetries = 0;
+    // CAS from the current state; false if the move is not allowed from it
+    bool transitionTo(TaskState to);
+    void notifyStateChange() const;
+
+    std::shared_ptr<Control> ctl;
 };
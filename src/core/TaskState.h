@@ -6,5 +6,9 @@ enum class TaskState {
     RUNNING,
     RETRYING,
     COMPLETED,
-    FAILED
+    FAILED,
+    REJECTED,  // shed by the scheduler without running
+    CANCELLED  // removed from the queue on request
 };
+
+constexpr int TASK_STATE_COUNT = 8;
@@ -0,0 +1,54 @@
+#include "DedupIndex.h"
+
+std::size_t DedupIndex::shardIndex(const std::string& key) {
+    return std::hash<std::string>()(key) % SHARDS;
+}
+
+void DedupIndex::forget(Shard& shard, const std::string& key, const void* token) {
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    auto it = shard.entries.find(key);
+    if (it != shard.entries.end() && it->second.token == token) {
+        shard.entries.erase(it);
+    }
+}
+
+std::optional<int> DedupIndex::claim(Task& task) {
+    const std::string& key = task.getDedupKey();
+    const std::size_t index = shardIndex(key);
+    Shard& shard = (*shards)[index];
+    std::lock_guard<std::mutex> lock(shard.mtx);
+
+    auto it = shard.entries.find(key);
+    if (it != shard.entries.end() && !it->second.handle.expired()) {
+        return it->second.taskId;
+    }
+
+    // Never the last owner under the shard lock: the task keeps the handle
+    std::weak_ptr<Shards> owner = shards;
+    std::shared_ptr<void> handle(new int(task.getId()), [owner, index, key](int* token) {
+        if (auto live = owner.lock()) {
+            forget((*live)[index], key, token);
+        }
+        delete token;
+    });
+    shard.entries[key] = Entry{task.getId(), handle, handle.get()};
+    task.setDedupHandle(std::move(handle));
+    return std::nullopt;
+}
+
+void DedupIndex::release(const Task& task) {
+    // Taken before the lock: if this is the last owner, its deleter locks too
+    std::shared_ptr<void> handle = task.getDedupHandle();
+    if (handle) {
+        forget((*shards)[shardIndex(task.getDedupKey())], task.getDedupKey(), handle.get());
+    }
+}
+
+std::size_t DedupIndex::size() const {
+    std::size_t total = 0;
+    for (const auto& shard : *shards) {
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        total += shard.entries.size();
+    }
+    return total;
+}
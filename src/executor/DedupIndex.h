@@ -0,0 +1,52 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "../core/Task.h"
+
+// Dedup key -> pending task that owns it. Sharded by key hash so concurrent
+// submits rarely contend. The claim is a handle kept on the task's control
+// block, which the registry shares and keeps alive after the task has left
+// the queue, so claims are released explicitly: the worker erases the entry
+// on dispatch, and Task resets the handle when the task ends without being
+// dispatched (markRejected, markCancelled, markFailed, and
+// markCompletedFromCache). The handle's deleter erases its entry, so a claim
+// that ends either way, or whose task is dropped, leaves nothing behind.
+class DedupIndex {
+public:
+    static constexpr std::size_t SHARDS = 16;
+
+    // Returns the id of the pending task already holding the task's key, or
+    // nullopt after giving the task the claim
+    std::optional<int> claim(Task& task);
+
+    // Frees the key if this task still holds it
+    void release(const Task& task);
+
+    std::size_t size() const;
+
+private:
+    struct Entry {
+        int taskId;
+        std::weak_ptr<void> handle;
+        const void* token;  // the handle's pointer, still comparable once it expired
+    };
+
+    struct Shard {
+        mutable std::mutex mtx;
+        std::unordered_map<std::string, Entry> entries;
+    };
+    using Shards = std::array<Shard, SHARDS>;
+
+    static std::size_t shardIndex(const std::string& key);
+    // Erases the key's entry if it still belongs to token
+    static void forget(Shard& shard, const std::string& key, const void* token);
+
+    // Shared with the handles' deleters, which may outlive the index
+    std::shared_ptr<Shards> shards = std::make_shared<Shards>();
+};
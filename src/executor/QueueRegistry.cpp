@@ -0,0 +1,49 @@
+#include "QueueRegistry.h"
+#include "../scheduler/SchedulerFactory.h"
+#include "../../utils/Logger.h"
+
+QueueRegistry::QueueRegistry(std::shared_ptr<ThreadPool> defaultPool) {
+    pools[DEFAULT_QUEUE] = std::move(defaultPool);
+}
+
+std::shared_ptr<QueueRegistry> QueueRegistry::fromConfig(const Config& cfg) {
+    auto registry = std::make_shared<QueueRegistry>(std::make_shared<ThreadPool>(
+        static_cast<size_t>(cfg.getThreads()), SchedulerFactory::create(cfg)));
+
+    for (const auto& entry : cfg.getQueues()) {
+        const std::string& name = entry.first;
+        int threads = cfg.getQueueThreads(name);
+        std::string scheduler = cfg.getQueueScheduler(name);
+        registry->add(name, std::make_shared<ThreadPool>(
+            static_cast<size_t>(threads), SchedulerFactory::create(cfg, scheduler)));
+        Logger::info("Queue '" + name + "': threads=" + std::to_string(threads) +
+                     ", scheduler=" + scheduler);
+    }
+    return registry;
+}
+
+bool QueueRegistry::add(const std::string& name, std::shared_ptr<ThreadPool> pool) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return pools.emplace(name, std::move(pool)).second;
+}
+
+std::shared_ptr<ThreadPool> QueueRegistry::get(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = pools.find(name.empty() ? DEFAULT_QUEUE : name);
+    return it == pools.end() ? nullptr : it->second;
+}
+
+std::shared_ptr<ThreadPool> QueueRegistry::getDefault() const {
+    return get(DEFAULT_QUEUE);
+}
+
+std::vector<std::pair<std::string, std::shared_ptr<ThreadPool>>> QueueRegistry::list() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return {pools.begin(), pools.end()};
+}
+
+void QueueRegistry::shutdownAll() {
+    for (auto& entry : list()) {
+        entry.second->shutdown();
+    }
+}
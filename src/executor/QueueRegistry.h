@@ -0,0 +1,45 @@
+#pragma once
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "../../utils/Config.h"
+
+// Named queues, each served by its own ThreadPool (threads and scheduler
+// policy), so a noisy workload cannot starve the others. "default" always
+// exists and uses the global threads/scheduler settings.
+class QueueRegistry {
+public:
+    static constexpr const char* DEFAULT_QUEUE = "default";
+
+    explicit QueueRegistry(std::shared_ptr<ThreadPool> defaultPool);
+
+    // Default pool plus one pool per queue.<name>.* section in config
+    static std::shared_ptr<QueueRegistry> fromConfig(const Config& cfg);
+
+    // Returns false if the name is taken
+    bool add(const std::string& name, std::shared_ptr<ThreadPool> pool);
+
+    // nullptr for unknown names; an empty name means the default queue
+    std::shared_ptr<ThreadPool> get(const std::string& name) const;
+    std::shared_ptr<ThreadPool> getDefault() const;
+
+    std::vector<std::pair<std::string, std::shared_ptr<ThreadPool>>> list() const;
+    // visit(name, pool) in name order, without copying the map; the
+    // registry lock is held, so visit must not add queues
+    template <typename Visit>
+    void forEach(Visit&& visit) const {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (const auto& [name, pool] : pools) {
+            visit(name, *pool);
+        }
+    }
+    void shutdownAll();
+
+private:
+    mutable std::mutex mtx;
+    std::map<std::string, std::shared_ptr<ThreadPool>> pools;
+};
@@ -0,0 +1,349 @@
+#include "RecurringJobs.h"
+#include "../../core/TaskLoader.h"
+#include "../../utils/Logger.h"
+
+#include <algorithm>
+
+static double toMs(std::chrono::steady_clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count() / 1000.0;
+}
+
+RecurringJob::RecurringJob(const TaskDefinition& definition,
+                           std::optional<CronExpression> cron,
+                           ThreadPool& pool)
+    : def(definition),
+      cron(std::move(cron)),
+      pool(pool),
+      body(TaskLoader::createTaskFunction(definition)),
+      templateTask(TaskLoader::createTask(definition, nullptr)),
+      overlap(definition.overlap == "queue"        ? OverlapPolicy::QUEUE
+              : definition.overlap == "concurrent" ? OverlapPolicy::CONCURRENT
+                                                   : OverlapPolicy::SKIP),
+      catchUp(definition.catchUp == "all" ? CatchUpPolicy::ALL : CatchUpPolicy::NONE) {}
+
+std::string RecurringJob::describeSchedule() const {
+    if (cron) {
+        return "cron " + cron->str();
+    }
+    return "every " + std::to_string(def.everyMs) + "ms";
+}
+
+RecurringJob::Clock::time_point RecurringJob::nextAfter(Clock::time_point due) const {
+    if (cron) {
+        // Map onto the wall clock, ask cron, and map back
+        const auto steadyNow = Clock::now();
+        const auto systemNow = std::chrono::system_clock::now();
+        auto systemAfter = systemNow + std::chrono::duration_cast<std::chrono::system_clock::duration>(due - steadyNow);
+        auto next = cron->next(systemAfter);
+        if (!next) {
+            return Clock::time_point::max();
+        }
+        return steadyNow + std::chrono::duration_cast<Clock::duration>(*next - systemNow);
+    }
+
+    // Drift-free: the next multiple of the period after `due`, counted from the anchor
+    const auto period = std::chrono::milliseconds(def.everyMs);
+    if (due < anchor) {
+        return anchor;
+    }
+    auto k = (due - anchor) / period + 1;
+    return anchor + period * k;
+}
+
+void RecurringJob::start() {
+    std::lock_guard<std::mutex> lock(mtx);
+    const auto now = Clock::now();
+
+    Clock::time_point first;
+    if (def.runAtMs > 0 || def.delayMs > 0) {
+        first = templateTask.getRunAt() > now ? templateTask.getRunAt() : now;
+    } else if (cron) {
+        anchor = now;
+        first = nextAfter(now);
+    } else {
+        first = now + std::chrono::milliseconds(def.everyMs);
+    }
+    anchor = first;
+    scheduleFire(first);
+}
+
+void RecurringJob::cancel() {
+    std::lock_guard<std::mutex> lock(mtx);
+    cancelled = true;
+    waiting.clear();
+    stats.queued = 0;
+}
+
+// Caller must hold mtx
+void RecurringJob::scheduleFire(Clock::time_point due) {
+    nextDue = due;
+    if (due == Clock::time_point::max()) {
+        Logger::warn("Recurring job " + std::to_string(def.id) + " has no further occurrences");
+        return;
+    }
+    std::weak_ptr<RecurringJob> weak = weak_from_this();
+    pool.scheduleAt(due, [weak, due]() {
+        if (auto job = weak.lock()) {
+            job->fire(due);
+        }
+    });
+}
+
+void RecurringJob::fire(Clock::time_point due) {
+    // Submitted after unlocking: a task can settle (and lock mtx) inside submit()
+    std::vector<Task> released;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (cancelled) {
+            return;
+        }
+
+        // Collect this occurrence plus any that came due while we were behind
+        const auto now = Clock::now();
+        std::vector<Clock::time_point> dueTimes{due};
+        Clock::time_point next = nextAfter(due);
+        while (next <= now) {
+            if (dueTimes.size() < MAX_CATCH_UP) {
+                dueTimes.push_back(next);
+            } else {
+                ++stats.missed;
+            }
+            next = nextAfter(next);
+        }
+
+        if (catchUp == CatchUpPolicy::NONE && dueTimes.size() > 1) {
+            stats.missed += dueTimes.size() - 1;
+            dueTimes.erase(dueTimes.begin(), dueTimes.end() - 1);
+        }
+        for (auto dueTime : dueTimes) {
+            admit(dueTime, released);
+        }
+
+        scheduleFire(next);
+    }
+    for (auto& task : released) {
+        pool.submit(std::move(task));
+    }
+}
+
+// Caller must hold mtx. Applies the overlap policy.
+void RecurringJob::admit(Clock::time_point due, std::vector<Task>& released) {
+    if (stats.inFlight > 0 && overlap == OverlapPolicy::SKIP) {
+        ++stats.skippedOverlap;
+        return;
+    }
+    if ((stats.inFlight > 0 || !waiting.empty()) && overlap == OverlapPolicy::QUEUE) {
+        if (waiting.size() >= MAX_QUEUED) {
+            ++stats.skippedOverlap;
+        } else {
+            waiting.push_back(due);
+            stats.queued = waiting.size();
+        }
+        return;
+    }
+    released.push_back(release(due));
+}
+
+// Settles the occurrence on its task's final state. Cancelled, shed, dropped
+// or cached occurrences never finish their body, so the body can't do it.
+class RecurringJob::OccurrenceHook : public TaskStateHook {
+public:
+    OccurrenceHook(std::weak_ptr<RecurringJob> job, std::shared_ptr<Occurrence> occurrence)
+        : job(std::move(job)), occurrence(std::move(occurrence)) {}
+
+    // A task discarded without reaching a final state, e.g. at shutdown;
+    // the pool may be going away, so nothing waiting is released after it
+    ~OccurrenceHook() override { settle(TaskState::CANCELLED, true); }
+
+    void onStateChange(const Task& task) override {
+        switch (task.getState()) {
+            case TaskState::FAILED:
+                if (occurrence->retrying.exchange(false)) {
+                    return;
+                }
+                settle(TaskState::FAILED, false);
+                return;
+            case TaskState::COMPLETED:
+            case TaskState::REJECTED:
+            case TaskState::CANCELLED:
+                settle(task.getState(), false);
+                return;
+            default:
+                return;
+        }
+    }
+
+private:
+    void settle(TaskState outcome, bool discarded) {
+        if (occurrence->settled.exchange(true)) {
+            return;
+        }
+        if (auto owner = job.lock()) {
+            owner->onOccurrenceDone(*occurrence, outcome, discarded);
+        }
+    }
+
+    std::weak_ptr<RecurringJob> job;
+    std::shared_ptr<Occurrence> occurrence;
+};
+
+// Caller must hold mtx, and submit the task after unlocking
+Task RecurringJob::release(Clock::time_point due) {
+    auto self = shared_from_this();
+    auto occurrence = std::make_shared<Occurrence>();
+    occurrence->due = due;
+    const int maxRetries = def.maxRetries;
+    const auto work = body;
+
+    Task task = templateTask.clone([self, occurrence, maxRetries, work]() {
+        const auto start = Clock::now();
+        if (occurrence->attempts++ == 0) {
+            occurrence->firstStart = start;
+        }
+        try {
+            work();
+        } catch (...) {
+            occurrence->lastEnd = Clock::now();
+            occurrence->retrying = occurrence->attempts <= maxRetries;
+            throw;
+        }
+        occurrence->lastEnd = Clock::now();
+    });
+    task.attachStateHook(TaskHookSlot::SOURCE, std::make_unique<OccurrenceHook>(weak_from_this(), occurrence));
+    if (def.deadlineMs > 0) {
+        task.setDeadline(due + std::chrono::milliseconds(def.deadlineMs));
+    }
+
+    ++stats.inFlight;
+    ++stats.released;
+    return task;
+}
+
+// Called from the task's state hook, possibly under a scheduler's lock, so
+// a waiting occurrence is submitted from the timer thread
+void RecurringJob::onOccurrenceDone(const Occurrence& occurrence, TaskState outcome, bool discarded) {
+    std::optional<Task> next;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (stats.inFlight > 0) {
+            --stats.inFlight;
+        }
+        if (outcome == TaskState::COMPLETED) {
+            ++stats.completed;
+        } else if (outcome == TaskState::FAILED) {
+            ++stats.failed;
+        } else {
+            ++stats.dropped;
+        }
+
+        if (occurrence.attempts > 0) {
+            const double waitMs = std::max(0.0, toMs(occurrence.firstStart - occurrence.due));
+            const double execMs = toMs(occurrence.lastEnd - occurrence.firstStart);
+            ++stats.ran;
+            stats.totalWaitMs += waitMs;
+            stats.totalExecMs += execMs;
+            stats.maxWaitMs = std::max(stats.maxWaitMs, waitMs);
+            stats.maxExecMs = std::max(stats.maxExecMs, execMs);
+        }
+
+        if (!cancelled && !discarded && !waiting.empty() && stats.inFlight == 0) {
+            auto due = waiting.front();
+            waiting.pop_front();
+            stats.queued = waiting.size();
+            next = release(due);
+        }
+    }
+    if (next) {
+        ThreadPool& target = pool;
+        pool.scheduleAt(Clock::now(), [&target, task = std::move(*next)]() { target.submit(task); });
+    }
+}
+
+RecurringJobStats RecurringJob::getStats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return stats;
+}
+
+RecurringJob::Clock::time_point RecurringJob::getNextDue() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return nextDue;
+}
+
+RecurringJobManager::RecurringJobManager(std::shared_ptr<ThreadPool> pool)
+    : pool(std::move(pool)) {}
+
+RecurringJobManager::RecurringJobManager(std::shared_ptr<QueueRegistry> queues)
+    : queues(std::move(queues)) {}
+
+RecurringJobManager::~RecurringJobManager() {
+    cancelAll();
+}
+
+bool RecurringJobManager::add(const TaskDefinition& def, std::string& error) {
+    if (!def.isRecurring()) {
+        error = "Task has no schedule";
+        return false;
+    }
+
+    std::optional<CronExpression> cron;
+    if (!def.cron.empty()) {
+        cron = CronExpression::parse(def.cron);
+        if (!cron) {
+            error = "Invalid cron expression: " + def.cron;
+            return false;
+        }
+    }
+
+    std::shared_ptr<ThreadPool> target = queues ? queues->get(def.queue) : pool;
+    if (!target) {
+        error = "Unknown queue: " + def.queue;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    if (jobs.count(def.id) > 0) {
+        error = "Recurring job ID already exists";
+        return false;
+    }
+
+    auto job = std::make_shared<RecurringJob>(def, std::move(cron), *target);
+    jobs[def.id] = job;
+    job->start();
+    Logger::info("Recurring job " + std::to_string(def.id) + " scheduled (" +
+                 job->describeSchedule() + ")");
+    return true;
+}
+
+bool RecurringJobManager::remove(int id) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = jobs.find(id);
+    if (it == jobs.end()) {
+        return false;
+    }
+    it->second->cancel();
+    jobs.erase(it);
+    return true;
+}
+
+std::shared_ptr<RecurringJob> RecurringJobManager::get(int id) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = jobs.find(id);
+    return it == jobs.end() ? nullptr : it->second;
+}
+
+std::vector<std::shared_ptr<RecurringJob>> RecurringJobManager::list() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<std::shared_ptr<RecurringJob>> result;
+    for (const auto& pair : jobs) {
+        result.push_back(pair.second);
+    }
+    return result;
+}
+
+void RecurringJobManager::cancelAll() {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto& pair : jobs) {
+        pair.second->cancel();
+    }
+    jobs.clear();
+}
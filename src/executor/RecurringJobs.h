@@ -0,0 +1,128 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "QueueRegistry.h"
+#include "../../core/TaskDefinition.h"
+#include "../../core/CronExpression.h"
+
+// What to do when an occurrence comes due while the previous one is still in flight
+enum class OverlapPolicy {
+    SKIP,        // drop the new occurrence
+    QUEUE,       // release it when the running one finishes
+    CONCURRENT   // release it anyway
+};
+
+// What to do with occurrences whose due time passed while we were behind
+enum class CatchUpPolicy {
+    NONE,  // run once for the latest, count the rest as missed
+    ALL    // run every missed occurrence (bounded)
+};
+
+// Per-job roll-up of its occurrences
+struct RecurringJobStats {
+    std::uint64_t released = 0;
+    std::uint64_t completed = 0;
+    std::uint64_t failed = 0;
+    std::uint64_t dropped = 0;    // released but never run to the end: cancelled, shed, lost at shutdown
+    std::uint64_t skippedOverlap = 0;
+    std::uint64_t missed = 0;
+    std::uint64_t queued = 0;     // currently waiting on QUEUE overlap
+    std::uint64_t inFlight = 0;   // released and not yet finished
+    std::uint64_t ran = 0;        // finished after starting; the averages' denominator
+    double totalWaitMs = 0.0;     // due time -> first start
+    double maxWaitMs = 0.0;
+    double totalExecMs = 0.0;     // first start -> final end (includes retries)
+    double maxExecMs = 0.0;
+};
+
+// A periodic job. Occurrence due times are computed from a fixed anchor
+// (anchor + k * period, or the next cron minute), never from when the
+// previous occurrence ran, so the schedule does not drift. Occurrences are
+// clones of a task template built once from the definition. An occurrence
+// is settled by a state hook on its task when that reaches a final state,
+// whether or not its body ever ran.
+class RecurringJob : public std::enable_shared_from_this<RecurringJob> {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t MAX_CATCH_UP = 100;
+    static constexpr std::size_t MAX_QUEUED = 100;
+
+    RecurringJob(const TaskDefinition& def, std::optional<CronExpression> cron, ThreadPool& pool);
+
+    void start();
+    void cancel();
+
+    int getId() const { return def.id; }
+    const TaskDefinition& getDefinition() const { return def; }
+    std::string describeSchedule() const;
+    RecurringJobStats getStats() const;
+    Clock::time_point getNextDue() const;
+
+private:
+    struct Occurrence {
+        Clock::time_point due;
+        // Written by the body, one attempt at a time
+        int attempts = 0;
+        Clock::time_point firstStart;
+        Clock::time_point lastEnd;
+        std::atomic<bool> retrying{false};  // the failure just seen will be retried
+        std::atomic<bool> settled{false};
+    };
+    class OccurrenceHook;
+
+    Clock::time_point nextAfter(Clock::time_point due) const;
+    void scheduleFire(Clock::time_point due);
+    void fire(Clock::time_point due);
+    void admit(Clock::time_point due, std::vector<Task>& released);
+    Task release(Clock::time_point due);
+    void onOccurrenceDone(const Occurrence& occurrence, TaskState outcome, bool discarded);
+
+    TaskDefinition def;
+    std::optional<CronExpression> cron;
+    ThreadPool& pool;
+    std::function<void()> body;
+    Task templateTask;
+    OverlapPolicy overlap;
+    CatchUpPolicy catchUp;
+
+    mutable std::mutex mtx;
+    bool cancelled = false;
+    Clock::time_point anchor;
+    Clock::time_point nextDue;
+    std::deque<Clock::time_point> waiting;
+    RecurringJobStats stats;
+};
+
+// Owns recurring jobs; occurrences run on one pool, or on the pool of the
+// job's named queue
+class RecurringJobManager {
+public:
+    explicit RecurringJobManager(std::shared_ptr<ThreadPool> pool);
+    explicit RecurringJobManager(std::shared_ptr<QueueRegistry> queues);
+    ~RecurringJobManager();
+
+    // Returns false and sets error if the definition is not a valid recurring job
+    bool add(const TaskDefinition& def, std::string& error);
+    bool remove(int id);
+    std::shared_ptr<RecurringJob> get(int id) const;
+    std::vector<std::shared_ptr<RecurringJob>> list() const;
+    void cancelAll();
+
+private:
+    std::shared_ptr<ThreadPool> pool;
+    std::shared_ptr<QueueRegistry> queues;
+    mutable std::mutex mtx;
+    std::map<int, std::shared_ptr<RecurringJob>> jobs;
+};
@@ -1,66 +1,296 @@
 #include "ThreadPool.h"
 #include "../scheduler/RoundRobinScheduler.h"
+#include "../scheduler/CircuitBreaker.h"
 #include "../../utils/Metrics.h"
+#include "../../utils/ResultCache.h"
+#include "../../utils/RuntimeEstimator.h"
+#include "../../utils/TraceRecorder.h"
+
+#include <algorithm>
 
 ThreadPool::ThreadPool(size_t threadCount)
-    : scheduler(std::make_shared<RoundRobinScheduler>()), stop(false) {
+    : targetWorkers(threadCount), scheduler(std::make_shared<RoundRobinScheduler>()), stop(false) {
     workers.reserve(threadCount);
     start();
 }
 
 ThreadPool::ThreadPool(size_t threadCount,
                        std::shared_ptr<Scheduler> scheduler)
-    : scheduler(std::move(scheduler)), stop(false) {
+    : targetWorkers(threadCount), scheduler(std::move(scheduler)), stop(false) {
     workers.reserve(threadCount);
     start();
 }
 
 void ThreadPool::start() {
-    if (workers.size() < workers.capacity()) {
-        for (size_t i = workers.size(); i < workers.capacity(); ++i) {
-            workers.emplace_back(&ThreadPool::workerLoop, this);
+    std::lock_guard<std::mutex> lock(workersMtx);
+    reapRetired();
+    while (liveWorkers.load() < targetWorkers.load()) {
+        ++liveWorkers;
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+void ThreadPool::resize(size_t threadCount) {
+    if (threadCount == 0 || threadCount == targetWorkers.load()) {
+        return;
+    }
+    targetWorkers = threadCount;
+    if (stop) {
+        return;
+    }
+    start();
+    // Wake idle workers so surplus ones notice and exit
+    cv.notify_all();
+}
+
+// Caller must hold workersMtx
+void ThreadPool::reapRetired() {
+    for (auto it = workers.begin(); it != workers.end();) {
+        auto id = it->get_id();
+        auto found = std::find(retired.begin(), retired.end(), id);
+        if (found != retired.end()) {
+            it->join();
+            retired.erase(found);
+            it = workers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// A worker leaves when there are more live workers than the target
+bool ThreadPool::shouldRetire() {
+    size_t live = liveWorkers.load();
+    while (live > targetWorkers.load()) {
+        if (liveWorkers.compare_exchange_weak(live, live - 1)) {
+            std::lock_guard<std::mutex> lock(workersMtx);
+            retired.push_back(std::this_thread::get_id());
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::setScheduler(std::shared_ptr<Scheduler> next) {
+    std::unique_lock<std::shared_mutex> lock(schedulerMtx);
+    auto previous = std::atomic_load(&scheduler);
+    next->takeOver(*previous);
+    for (auto& task : previous->drain()) {
+        next->submit(std::move(task));
+    }
+    std::atomic_store(&scheduler, std::move(next));
+    cv.notify_all();
+}
+
+std::shared_ptr<Scheduler> ThreadPool::getScheduler() const {
+    return std::atomic_load(&scheduler);
+}
+
+bool ThreadPool::cancel(int taskId) {
+    bool cancelled;
+    {
+        std::shared_lock<std::shared_mutex> lock(schedulerMtx);
+        cancelled = scheduler->cancel(taskId);
+    }
+    if (cancelled) {
+        ++cancelledCount;
+        Metrics::instance().recordCancelled();
+    }
+    return cancelled;
+}
+
+bool ThreadPool::reprioritize(int taskId, TaskPriority priority) {
+    std::shared_lock<std::shared_mutex> lock(schedulerMtx);
+    return scheduler->reprioritize(taskId, priority);
+}
+
+ThreadPoolStats ThreadPool::getStats() const {
+    ThreadPoolStats stats;
+    stats.submitted = submittedCount.load();
+    stats.completed = completedCount.load();
+    stats.failed = failedCount.load();
+    stats.coalesced = coalescedCount.load();
+    stats.cached = cachedCount.load();
+    stats.cancelled = cancelledCount.load();
+    stats.queued = getScheduler()->size();
+    stats.delayed = getPendingTimers();
+    stats.workers = targetWorkers.load();
+    stats.busy = busyWorkers.load();
+
+    std::uint64_t started = startedCount.load();
+    if (started > 0) {
+        stats.avgWaitMs = totalWaitMicros.load() / 1000.0 / started;
+    }
+    double uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() - createdAt).count();
+    if (uptime > 0.0) {
+        stats.throughputPerSec = stats.completed / uptime;
+    }
+    return stats;
+}
+
+int ThreadPool::submit(Task task) {
+    const int id = task.getId();
+    if (!accepting) {
+        return id;
+    }
+    ++submittedCount;
+    Metrics::instance().recordSubmitted();
+
+    if (!task.getMetricsKey()) {
+        // Resolved once here so workers record without hashing the labels
+        task.setMetricsKey(Metrics::instance().resolveKey(task.getType(), task.getTenant()));
+    }
+
+    if (!task.getDedupKey().empty()) {
+        if (std::optional<int> pending = dedup.claim(task)) {
+            ++coalescedCount;
+            Metrics::instance().recordCoalesced();
+            return *pending;
         }
     }
+
+    ResultCache& cache = ResultCache::instance();
+    if (cache.isCacheable(task) && cache.get(ResultCache::keyFor(task))) {
+        // Deterministic and already computed: complete without a worker
+        task.markReady();
+        task.markCompletedFromCache();
+        ++cachedCount;
+        Metrics::instance().recordCacheHit();
+        return id;
+    }
+
+    if (task.getRunAt() > std::chrono::steady_clock::now()) {
+        auto runAt = task.getRunAt();
+        submitAt(std::move(task), runAt);
+        return id;
+    }
+    enqueue(std::move(task));
+    return id;
 }
 
-void ThreadPool::submit(Task task) {
+void ThreadPool::submitAt(Task task, std::chrono::steady_clock::time_point runAt) {
+    scheduleAt(runAt, [this, task]() { enqueue(task); });
+}
+
+void ThreadPool::scheduleAt(std::chrono::steady_clock::time_point due,
+                            std::function<void()> callback) {
     if (!accepting) {
         return;
     }
 
-    if (workers.empty()) {
+    std::lock_guard<std::mutex> lock(timerMtx);
+    if (!timerThread.joinable()) {
+        timerThread = std::thread(&ThreadPool::timerLoop, this);
+    }
+    timers.schedule(due, std::move(callback));
+    timerCv.notify_one();
+}
+
+size_t ThreadPool::getPendingTimers() const {
+    std::lock_guard<std::mutex> lock(timerMtx);
+    return timers.size();
+}
+
+void ThreadPool::enqueue(Task task) {
+    if (!accepting) {
+        return;
+    }
+
+    if (liveWorkers.load() == 0) {
         start();
     }
     task.markReady();
-    scheduler->submit(std::move(task));
+    {
+        std::shared_lock<std::shared_mutex> lock(schedulerMtx);
+        scheduler->submit(std::move(task));
+    }
     cv.notify_one();
 }
 
+void ThreadPool::timerLoop() {
+    std::unique_lock<std::mutex> lock(timerMtx);
+    while (!stop) {
+        if (timers.empty()) {
+            timerCv.wait(lock, [this] { return stop || !timers.empty(); });
+            continue;
+        }
+
+        // Sleep until the wheel has work; scheduleAt() wakes us for an earlier timer
+        timerCv.wait_until(lock, timers.nextExpiry());
+        auto due = timers.advance(std::chrono::steady_clock::now());
+        if (due.empty()) {
+            continue;
+        }
+
+        // Release into the scheduler without holding the timer lock
+        lock.unlock();
+        for (auto& release : due) {
+            release();
+        }
+        lock.lock();
+    }
+}
+
 void ThreadPool::workerLoop() {
     while (true) {
-        if (!scheduler->empty()) {
-            Task task = scheduler->getNextTask();
+        if (shouldRetire()) {
+            break;
+        }
+        // Finish-callbacks go to the scheduler the task came from
+        std::shared_ptr<Scheduler> current = std::atomic_load(&scheduler);
+        std::optional<Task> next = current->tryGetNextTask();
+        if (next) {
+            Task task = std::move(*next);
+            if (!task.getDedupKey().empty()) {
+                // Dispatched: later identical submits run again
+                dedup.release(task);
+            }
+            auto startWait = std::chrono::steady_clock::now() - task.getEnqueueTime();
+            totalWaitMicros += static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(startWait).count());
+            ++startedCount;
+            ++busyWorkers;
+            Metrics::instance().recordStarted();
             try {
                 task.execute();
+                ++completedCount;
+                TraceRecorder::instance().recordAttempt(task, TraceOutcome::COMPLETED);
+                current->onTaskFinished(task);
+                RuntimeEstimator::instance().record(task);
                 Metrics::instance().recordTask(task);
+                if (ResultCache::instance().isCacheable(task)) {
+                    ResultCache::instance().put(ResultCache::keyFor(task), "");
+                }
             } catch (...) {
+                current->onTaskFinished(task);
+                // Before markRetry() restarts the task's enqueue time
+                TraceRecorder::instance().recordAttempt(
+                    task, task.shouldRetry() ? TraceOutcome::RETRIED : TraceOutcome::FAILED);
                 if (task.shouldRetry()) {
                     task.markRetry();
-                    std::this_thread::sleep_for(
-                        std::chrono::milliseconds(50 * task.getRetryCount()));
+                    Metrics::instance().recordRetry();
+                    // Behind an open breaker the retry parks anyway; don't
+                    // hold the worker in a backoff sleep for it
+                    if (!CircuitBreakerRegistry::instance().isOpen(task.getType())) {
+                        std::this_thread::sleep_for(
+                            std::chrono::milliseconds(50 * task.getRetryCount()));
+                    }
+                    std::shared_lock<std::shared_mutex> lock(schedulerMtx);
                     scheduler->submit(task);
                 } else {
+                    ++failedCount;
                     task.markFailed();
                     Metrics::instance().recordTask(task);
                 }
             }
+            --busyWorkers;
         } else {
             std::unique_lock<std::mutex> lock(mtx);
             if (stop) {
                 break;
             }
             cv.wait_for(lock, std::chrono::milliseconds(50));
-            if (stop && scheduler->empty()) {
+            if (stop && std::atomic_load(&scheduler)->empty()) {
                 break;
             }
         }
@@ -71,7 +301,20 @@ void ThreadPool::shutdown() {
     accepting = false;
     stop = true;
     cv.notify_all();
-    for (auto& t : workers) {
+    {
+        // Delayed tasks that are not due yet are dropped
+        std::lock_guard<std::mutex> lock(timerMtx);
+        timerCv.notify_all();
+    }
+    if (timerThread.joinable())
+        timerThread.join();
+    std::vector<std::thread> joining;
+    {
+        std::lock_guard<std::mutex> lock(workersMtx);
+        joining.swap(workers);
+        retired.clear();
+    }
+    for (auto& t : joining) {
         if (t.joinable())
             t.join();
     }
@@ -81,7 +324,19 @@ void ThreadPool::shutdownNow() {
     accepting = false;
     stop = true;
     cv.notify_all();
-    for (auto& t : workers) {
+    {
+        std::lock_guard<std::mutex> lock(timerMtx);
+        timerCv.notify_all();
+    }
+    if (timerThread.joinable())
+        timerThread.join();
+    std::vector<std::thread> joining;
+    {
+        std::lock_guard<std::mutex> lock(workersMtx);
+        joining.swap(workers);
+        retired.clear();
+    }
+    for (auto& t : joining) {
         if (t.joinable())
             t.join();
     }
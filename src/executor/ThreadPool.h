@@ -3,11 +3,32 @@
 #include <thread>
 #include <atomic>
 #include <mutex>
+#include <shared_mutex>
 #include <condition_variable>
 #include <memory>
 #include <chrono>
+#include <functional>
+#include <cstdint>
 
 #include "../scheduler/Scheduler.h"
+#include "TimerWheel.h"
+#include "DedupIndex.h"
+
+// Counters for one pool (one per named queue)
+struct ThreadPoolStats {
+    std::uint64_t submitted = 0;
+    std::uint64_t completed = 0;
+    std::uint64_t failed = 0;       // after the last retry
+    std::uint64_t coalesced = 0;    // submits attached to an identical pending task
+    std::uint64_t cached = 0;       // submits completed from the result cache
+    std::uint64_t cancelled = 0;    // withdrawn while queued
+    std::size_t queued = 0;         // held by the scheduler
+    std::size_t delayed = 0;        // on the timer wheel
+    std::size_t workers = 0;        // target worker count
+    std::size_t busy = 0;           // workers inside a task right now
+    double avgWaitMs = 0.0;         // enqueue -> start, per attempt
+    double throughputPerSec = 0.0;  // completions per second since creation
+};
 
 class ThreadPool {
 public:
@@ -16,19 +37,74 @@ public:
     ~ThreadPool();
 
     void start();
-    void submit(Task task);
+    // Held in the timer wheel until task.getRunAt(). Returns the id of the
+    // task that will run: its own, or that of the pending task with the same
+    // dedup key it was coalesced into.
+    int submit(Task task);
+    void submitAt(Task task, std::chrono::steady_clock::time_point runAt);
+    // Run callback on the timer thread once due (it must not block)
+    void scheduleAt(std::chrono::steady_clock::time_point due, std::function<void()> callback);
     void shutdown();      // graceful: finish queued work, stop accepting
     void shutdownNow();   // force: stop immediately
-    size_t getSize() const { return workers.size(); }
+    size_t getSize() const { return targetWorkers.load(); }
+    size_t getPendingTimers() const;
+
+    // Replace the scheduler while running. Queued tasks are moved from the
+    // old scheduler to the new one before any new submission sees it.
+    void setScheduler(std::shared_ptr<Scheduler> next);
+    std::shared_ptr<Scheduler> getScheduler() const;
+
+    // Grow or shrink the worker set live. Surplus workers exit after their
+    // current task; in-flight work is never interrupted.
+    void resize(size_t threadCount);
+
+    // Act on a task still held by the scheduler. False if it is not queued
+    // here (running, finished, delayed, unknown) or the policy can't do it.
+    bool cancel(int taskId);
+    bool reprioritize(int taskId, TaskPriority priority);
+
+    ThreadPoolStats getStats() const;
 
 private:
     void workerLoop();
+    void timerLoop();
+    void enqueue(Task task);
+    bool shouldRetire();
+    void reapRetired();
 
+    std::mutex workersMtx;
     std::vector<std::thread> workers;
-    std::shared_ptr<Scheduler> scheduler;
+    std::vector<std::thread::id> retired;  // exited after a shrink, not yet joined
+    std::atomic<size_t> targetWorkers{0};
+    std::atomic<size_t> liveWorkers{0};
+
+    // Submitters hold this shared while handing a task to the scheduler;
+    // setScheduler holds it exclusively so no task lands in a retired scheduler
+    mutable std::shared_mutex schedulerMtx;
+    std::shared_ptr<Scheduler> scheduler;  // read with std::atomic_load
+
+    std::chrono::steady_clock::time_point createdAt = std::chrono::steady_clock::now();
+    std::atomic<std::uint64_t> submittedCount{0};
+    std::atomic<std::uint64_t> completedCount{0};
+    std::atomic<std::uint64_t> failedCount{0};
+    std::atomic<std::uint64_t> coalescedCount{0};
+    std::atomic<std::uint64_t> cachedCount{0};
+    std::atomic<std::uint64_t> cancelledCount{0};
+    std::atomic<std::uint64_t> startedCount{0};
+    std::atomic<std::size_t> busyWorkers{0};
+    std::atomic<std::uint64_t> totalWaitMicros{0};
 
     std::atomic<bool> stop;
     std::atomic<bool> accepting{true};
     std::mutex mtx;
     std::condition_variable cv;
+
+    // Pending tasks by dedup key, from submit until dispatch
+    DedupIndex dedup;
+
+    // Delayed tasks wait here, not in the scheduler, until they are due
+    mutable std::mutex timerMtx;
+    std::condition_variable timerCv;
+    TimerWheel timers;
+    std::thread timerThread;
 };
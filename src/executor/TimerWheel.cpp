@@ -0,0 +1,125 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+TimerWheel::TimerWheel(Clock::time_point start)
+    : start(start) {}
+
+std::uint64_t TimerWheel::toTick(Clock::time_point t) const {
+    if (t <= start)
+        return 0;
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(t - start).count());
+}
+
+std::vector<TimerWheel::Entry>& TimerWheel::slot(int level, std::uint64_t tick) {
+    if (level == 0)
+        return root[tick & (ROOT_SIZE - 1)];
+    return levels[level - 1][(tick >> levelShift(level)) & (LEVEL_SIZE - 1)];
+}
+
+// Place an entry with dueTick >= currentTick in the lowest level whose span covers it
+void TimerWheel::place(Entry entry) {
+    const std::uint64_t delta = entry.dueTick - currentTick;
+    for (int level = 0; level < LEVELS; ++level) {
+        const int span = level == 0 ? ROOT_BITS : levelShift(level) + LEVEL_BITS;
+        if (delta < (std::uint64_t(1) << span)) {
+            slot(level, entry.dueTick).push_back(std::move(entry));
+            return;
+        }
+    }
+    overflow.push_back(std::move(entry));
+}
+
+void TimerWheel::schedule(Clock::time_point due, Callback cb) {
+    std::uint64_t dueTick = toTick(due);
+    if (dueTick <= currentTick) {
+        dueTick = currentTick + 1;
+    }
+    place(Entry{dueTick, std::move(cb)});
+    ++count;
+}
+
+// Move every entry of the current slot at `level` one level down
+void TimerWheel::cascade(int level) {
+    std::vector<Entry> entries;
+    if (level == LEVELS) {
+        entries.swap(overflow);
+    } else {
+        entries.swap(slot(level, currentTick));
+    }
+    for (auto& entry : entries) {
+        place(std::move(entry));
+    }
+}
+
+std::vector<TimerWheel::Callback> TimerWheel::advance(Clock::time_point now) {
+    std::vector<Callback> due;
+    const std::uint64_t target = toTick(now);
+
+    if (count == 0) {
+        // Nothing pending: jump straight to now
+        if (target > currentTick)
+            currentTick = target;
+        return due;
+    }
+
+    while (currentTick < target && count > 0) {
+        ++currentTick;
+
+        // When a level wraps, pull the next slot of the level above down
+        for (int level = 1; level <= LEVELS; ++level) {
+            const std::uint64_t mask = (std::uint64_t(1) << levelShift(level)) - 1;
+            if ((currentTick & mask) != 0)
+                break;
+            cascade(level);
+        }
+
+        auto& bucket = slot(0, currentTick);
+        for (auto& entry : bucket) {
+            due.push_back(std::move(entry.cb));
+        }
+        count -= bucket.size();
+        bucket.clear();
+    }
+
+    if (count == 0 && target > currentTick) {
+        currentTick = target;
+    }
+    return due;
+}
+
+TimerWheel::Clock::time_point TimerWheel::nextExpiry() const {
+    if (count == 0)
+        return Clock::time_point::max();
+
+    // Level-0 entries are due within the next ROOT_SIZE ticks, one tick per slot
+    std::uint64_t next = UINT64_MAX;
+    for (std::uint64_t tick = currentTick + 1; tick < currentTick + ROOT_SIZE; ++tick) {
+        if (!root[tick & (ROOT_SIZE - 1)].empty()) {
+            next = tick;
+            break;
+        }
+    }
+
+    // Higher entries are due no earlier than the tick their slot cascades on;
+    // a slot index comes round again after LEVEL_SIZE boundaries
+    for (int level = 1; level < LEVELS; ++level) {
+        const int shift = levelShift(level);
+        const std::uint64_t base = currentTick >> shift;
+        for (std::uint64_t i = 1; i <= LEVEL_SIZE; ++i) {
+            const std::uint64_t boundary = (base + i) << shift;
+            if (boundary >= next)
+                break;
+            if (!levels[level - 1][(base + i) & (LEVEL_SIZE - 1)].empty()) {
+                next = boundary;
+                break;
+            }
+        }
+    }
+    if (!overflow.empty()) {
+        const int shift = levelShift(LEVELS);
+        next = std::min(next, ((currentTick >> shift) + 1) << shift);
+    }
+    return start + std::chrono::milliseconds(next);
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Hierarchical timing wheel with 1 ms ticks.
+// Level 0 has 256 one-tick slots; levels 1-4 have 64 slots each covering
+// 2^8, 2^14, 2^20 and 2^26 ticks, for a horizon of 2^32 ms (~49 days).
+// Timers further out wait in an overflow list. Insert is O(1); entries in a
+// higher level are cascaded down when the lower level wraps.
+// Not thread-safe: the owner serializes access.
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    explicit TimerWheel(Clock::time_point start = Clock::now());
+
+    // Schedule cb to fire at (or just after) due; past times fire on the next tick
+    void schedule(Clock::time_point due, Callback cb);
+
+    // Advance the wheel to now and return the callbacks that became due
+    std::vector<Callback> advance(Clock::time_point now);
+
+    // Earliest time at which advance() can have work: the first occupied
+    // level-0 tick, or the next cascade of an occupied higher slot, whichever
+    // comes first. Clock::time_point::max() when empty.
+    Clock::time_point nextExpiry() const;
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    struct Entry {
+        std::uint64_t dueTick;
+        Callback cb;
+    };
+
+    static constexpr int LEVELS = 5;
+    static constexpr int ROOT_BITS = 8;
+    static constexpr int LEVEL_BITS = 6;
+    static constexpr std::size_t ROOT_SIZE = 1u << ROOT_BITS;
+    static constexpr std::size_t LEVEL_SIZE = 1u << LEVEL_BITS;
+
+    static int levelShift(int level) {
+        return level == 0 ? 0 : ROOT_BITS + LEVEL_BITS * (level - 1);
+    }
+
+    std::uint64_t toTick(Clock::time_point t) const;
+    void place(Entry entry);
+    void cascade(int level);
+    std::vector<Entry>& slot(int level, std::uint64_t tick);
+
+    Clock::time_point start;
+    std::uint64_t currentTick = 0;
+    std::size_t count = 0;
+
+    std::array<std::vector<Entry>, ROOT_SIZE> root;
+    std::array<std::array<std::vector<Entry>, LEVEL_SIZE>, LEVELS - 1> levels;
+    std::vector<Entry> overflow;
+};
@@ -14,10 +14,14 @@
 
 // Executor
 #include "../src/executor/ThreadPool.h"
+#include "../src/executor/RecurringJobs.h"
+#include "../src/executor/QueueRegistry.h"
 
 // Schedulers
 #include "../src/scheduler/PriorityScheduler.h"
 #include "../src/scheduler/RoundRobinScheduler.h"
+#include "../src/scheduler/SchedulerFactory.h"
+#include "../src/scheduler/CircuitBreaker.h"
 
 // API
 #include "../api/ApiServer.h"
@@ -27,9 +31,13 @@
 #include "../utils/Metrics.h"
 #include "../utils/Config.h"
 #include "../utils/Database.h"
+#include "../utils/ResultCache.h"
+#include "../utils/RuntimeEstimator.h"
+#include "../utils/TraceRecorder.h"
 
 static std::atomic<EngineState> g_engineState{EngineState::RUNNING};
 static std::atomic<bool> g_shutdownRequested{false};
+static std::atomic<bool> g_reloadRequested{false};
 
 void signalHandler(int signum) {
     (void)signum;
@@ -39,6 +47,12 @@ void signalHandler(int signum) {
     }
 }
 
+// SIGHUP: re-read config.ini on the main loop (not in the handler)
+void reloadSignalHandler(int signum) {
+    (void)signum;
+    g_reloadRequested.store(true);
+}
+
 // ---------------- PHASE 1 ----------------
 void runPhase1() {
     Logger::info("===== PHASE 1: Basic ThreadPool Execution =====");
@@ -123,12 +137,7 @@ void runPhase7() {
 
     Config& cfg = Config::instance();
 
-    std::shared_ptr<Scheduler> scheduler;
-    if (cfg.getScheduler() == "priority") {
-        scheduler = std::make_shared<PriorityScheduler>();
-    } else {
-        scheduler = std::make_shared<RoundRobinScheduler>();
-    }
+    std::shared_ptr<Scheduler> scheduler = SchedulerFactory::create(cfg);
 
     ThreadPool pool(static_cast<size_t>(cfg.getThreads()), scheduler);
 
@@ -167,20 +176,13 @@ void runApiMode() {
     
     Config& cfg = Config::instance();
     
-    // Create scheduler
-    std::shared_ptr<Scheduler> scheduler;
-    if (cfg.getScheduler() == "priority") {
-        scheduler = std::make_shared<PriorityScheduler>();
-    } else {
-        scheduler = std::make_shared<RoundRobinScheduler>();
-    }
+    // Create one thread pool per queue ("default" plus queue.<name>.* in config)
+    auto queues = QueueRegistry::fromConfig(cfg);
     
-    // Create thread pool
-    auto pool = std::make_shared<ThreadPool>(
-        static_cast<size_t>(cfg.getThreads()), scheduler);
+    auto recurringJobs = std::make_shared<RecurringJobManager>(queues);
     
     // Start API server
-    ApiServer apiServer(pool, cfg.getApiPort());
+    ApiServer apiServer(queues, cfg.getApiPort(), recurringJobs);
     apiServer.start();
     
     // Load tasks from JSON file if exists
@@ -188,9 +190,26 @@ void runApiMode() {
     if (!tasks.empty()) {
         Logger::info("Loaded " + std::to_string(tasks.size()) + " tasks from tasks.json");
         for (const auto& def : tasks) {
+            if (def.isRecurring()) {
+                std::string error;
+                if (!recurringJobs->add(def, error)) {
+                    Logger::warn("Skipping recurring task " + std::to_string(def.id) + ": " + error);
+                }
+                continue;
+            }
+            auto pool = queues->get(def.queue);
+            if (!pool) {
+                Logger::warn("Skipping task " + std::to_string(def.id) + ": unknown queue " + def.queue);
+                continue;
+            }
             Task task = TaskLoader::createTask(def);
-            TaskRegistry::instance().registerTask(task);
-            pool->submit(task);
+            if (!TaskRegistry::instance().registerTask(task)) {
+                Logger::warn("Skipping task " + std::to_string(def.id) + ": duplicate ID");
+                continue;
+            }
+            if (pool->submit(task) != def.id) {
+                TaskRegistry::instance().removeTask(def.id);
+            }
         }
     }
     
@@ -200,15 +219,21 @@ void runApiMode() {
     Logger::info("  GET  http://localhost:" + std::to_string(cfg.getApiPort()) + "/tasks");
     Logger::info("  GET  http://localhost:" + std::to_string(cfg.getApiPort()) + "/tasks/{id}");
     Logger::info("  POST http://localhost:" + std::to_string(cfg.getApiPort()) + "/tasks");
+    Logger::info("  GET  http://localhost:" + std::to_string(cfg.getApiPort()) + "/recurring");
+    Logger::info("  POST http://localhost:" + std::to_string(cfg.getApiPort()) + "/admin/scheduler");
     
     // Wait for shutdown signal
     while (!g_shutdownRequested.load()) {
+        if (g_reloadRequested.exchange(false)) {
+            apiServer.reloadConfig();
+        }
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
     
-    Logger::info("Shutting down API server and thread pool...");
+    Logger::info("Shutting down API server and thread pools...");
     apiServer.stop();
-    pool->shutdown();
+    recurringJobs->cancelAll();
+    queues->shutdownAll();
     g_engineState.store(EngineState::TERMINATED);
 }
 
@@ -222,6 +247,9 @@ int main(int argc, char* argv[]) {
 
     std::signal(SIGINT, signalHandler);
     std::signal(SIGTERM, signalHandler);
+#ifdef SIGHUP
+    std::signal(SIGHUP, reloadSignalHandler);
+#endif
 
     // Load config (order: defaults -> file -> environment -> args)
     Config& cfg = Config::instance();
@@ -234,6 +262,17 @@ int main(int argc, char* argv[]) {
         Logger::error("Configuration validation failed. Some values may be incorrect.");
     }
 
+    RuntimeEstimator::instance().configure(cfg.getEstimatorAlpha(), cfg.isEstimatorPerParams());
+    ResultCache::instance().configure(static_cast<std::size_t>(cfg.getResultCacheCapacity()),
+                                      std::chrono::milliseconds(cfg.getResultCacheTtlMs()),
+                                      cfg.getResultCacheTypes());
+    CircuitBreakerRegistry::instance().configure(cfg.getCircuitBreaker());
+    TaskRegistry::instance().setRetention(static_cast<std::size_t>(cfg.getRegistryMaxFinished()));
+    TaskRegistry::instance().setSnapshotInterval(std::chrono::milliseconds(cfg.getSnapshotIntervalMs()));
+    Metrics::instance().setMaxKeys(static_cast<std::size_t>(cfg.getMetricsMaxKeys()));
+    TraceRecorder::instance().configure(cfg.isTraceEnabled(),
+                                        static_cast<std::size_t>(cfg.getTraceEventsPerThread()));
+
     Logger::info(
         "Effective config: threads=" + std::to_string(cfg.getThreads()) +
         ", scheduler=" + cfg.getScheduler() +
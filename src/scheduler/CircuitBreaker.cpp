@@ -0,0 +1,189 @@
+#include "CircuitBreaker.h"
+#include "../../utils/Logger.h"
+
+#include <algorithm>
+
+std::string toString(CircuitState state) {
+    switch (state) {
+        case CircuitState::OPEN:
+            return "open";
+        case CircuitState::HALF_OPEN:
+            return "half_open";
+        default:
+            return "closed";
+    }
+}
+
+CircuitBreaker::CircuitBreaker(const CircuitBreakerConfig& config)
+    : config(config), outcomes(static_cast<std::size_t>(config.window > 0 ? config.window : 1), false) {}
+
+void CircuitBreaker::transition(CircuitState to, std::chrono::steady_clock::time_point now) {
+    stats.lastTransition = toString(stats.state) + "->" + toString(to);
+    stats.lastTransitionAt = now;
+    stats.state = to;
+    probesInFlight = 0;
+    probeSuccesses = 0;
+
+    if (to == CircuitState::OPEN) {
+        openedAt = now;
+        ++stats.opened;
+    } else if (to == CircuitState::CLOSED) {
+        // Start over so the failures that opened the breaker do not count
+        std::fill(outcomes.begin(), outcomes.end(), false);
+        next = 0;
+        failures = 0;
+        stats.windowCalls = 0;
+        stats.failureRate = 0.0;
+        ++stats.closed;
+    }
+}
+
+bool CircuitBreaker::tryAcquire(std::chrono::steady_clock::time_point now, bool* probe) {
+    if (stats.state == CircuitState::OPEN &&
+        now - openedAt >= std::chrono::milliseconds(config.openMs)) {
+        transition(CircuitState::HALF_OPEN, now);
+    }
+
+    switch (stats.state) {
+        case CircuitState::CLOSED:
+            return true;
+        case CircuitState::HALF_OPEN:
+            if (probesInFlight + probeSuccesses < config.probes) {
+                ++probesInFlight;
+                if (probe) {
+                    *probe = true;
+                }
+                return true;
+            }
+            break;
+        default:
+            break;
+    }
+    return false;
+}
+
+void CircuitBreaker::recordResult(bool success, std::chrono::steady_clock::time_point now) {
+    switch (stats.state) {
+        case CircuitState::CLOSED: {
+            if (stats.windowCalls == outcomes.size() && outcomes[next]) {
+                --failures;
+            }
+            outcomes[next] = !success;
+            if (!success) {
+                ++failures;
+            }
+            next = (next + 1) % outcomes.size();
+            if (stats.windowCalls < outcomes.size()) {
+                ++stats.windowCalls;
+            }
+            stats.failureRate = static_cast<double>(failures) / stats.windowCalls;
+            if (stats.windowCalls >= static_cast<std::size_t>(config.minCalls) &&
+                stats.failureRate >= config.failureRate) {
+                transition(CircuitState::OPEN, now);
+            }
+            break;
+        }
+        case CircuitState::HALF_OPEN:
+            if (probesInFlight > 0) {
+                --probesInFlight;
+            }
+            if (!success) {
+                transition(CircuitState::OPEN, now);
+            } else if (++probeSuccesses >= config.probes) {
+                transition(CircuitState::CLOSED, now);
+            }
+            break;
+        default:
+            // Finished after the breaker opened: already accounted for
+            break;
+    }
+}
+
+void CircuitBreaker::releaseProbe() {
+    if (stats.state == CircuitState::HALF_OPEN && probesInFlight > 0) {
+        --probesInFlight;
+    }
+}
+
+bool CircuitBreaker::isOpen(std::chrono::steady_clock::time_point now) const {
+    return stats.state == CircuitState::OPEN &&
+           now - openedAt < std::chrono::milliseconds(config.openMs);
+}
+
+CircuitBreakerStats CircuitBreaker::getStats() const {
+    return stats;
+}
+
+CircuitBreakerRegistry& CircuitBreakerRegistry::instance() {
+    static CircuitBreakerRegistry registry;
+    return registry;
+}
+
+void CircuitBreakerRegistry::configure(const CircuitBreakerConfig& config) {
+    std::lock_guard<std::mutex> lock(mtx);
+    const CircuitBreakerConfig& current = this->config;
+    if (config.enabled == current.enabled && config.window == current.window &&
+        config.minCalls == current.minCalls && config.failureRate == current.failureRate &&
+        config.openMs == current.openMs && config.probes == current.probes &&
+        config.failFast == current.failFast) {
+        return;
+    }
+    this->config = config;
+    breakers.clear();
+}
+
+CircuitBreakerConfig CircuitBreakerRegistry::getConfig() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return config;
+}
+
+bool CircuitBreakerRegistry::tryAcquire(const std::string& type, bool* probe) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!config.enabled || type.empty()) {
+        return true;
+    }
+    auto it = breakers.try_emplace(type, config).first;
+    return it->second.tryAcquire(std::chrono::steady_clock::now(), probe);
+}
+
+void CircuitBreakerRegistry::releaseProbe(const std::string& type) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = breakers.find(type);
+    if (config.enabled && it != breakers.end()) {
+        it->second.releaseProbe();
+    }
+}
+
+void CircuitBreakerRegistry::recordResult(const std::string& type, bool success) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!config.enabled || type.empty()) {
+        return;
+    }
+    CircuitBreaker& breaker = breakers.try_emplace(type, config).first->second;
+    CircuitState before = breaker.getStats().state;
+    breaker.recordResult(success, std::chrono::steady_clock::now());
+    CircuitBreakerStats after = breaker.getStats();
+    if (after.state != before) {
+        if (after.state == CircuitState::OPEN) {
+            Logger::warn("Circuit breaker for '" + type + "' " + after.lastTransition +
+                         " (failure rate " + std::to_string(after.failureRate) + ")");
+        } else {
+            Logger::info("Circuit breaker for '" + type + "' " + after.lastTransition);
+        }
+    }
+}
+
+bool CircuitBreakerRegistry::isOpen(const std::string& type) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = breakers.find(type);
+    return it != breakers.end() && it->second.isOpen(std::chrono::steady_clock::now());
+}
+
+std::map<std::string, CircuitBreakerStats> CircuitBreakerRegistry::getStats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::map<std::string, CircuitBreakerStats> result;
+    for (const auto& [type, breaker] : breakers) {
+        result[type] = breaker.getStats();
+    }
+    return result;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "../../utils/Config.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class CircuitState {
+    CLOSED,
+    OPEN,
+    HALF_OPEN
+};
+
+std::string toString(CircuitState state);
+
+struct CircuitBreakerStats {
+    CircuitState state = CircuitState::CLOSED;
+    double failureRate = 0.0;      // over the current window
+    std::size_t windowCalls = 0;
+    std::uint64_t opened = 0;      // CLOSED/HALF_OPEN -> OPEN transitions
+    std::uint64_t closed = 0;      // HALF_OPEN -> CLOSED transitions
+    std::string lastTransition;    // e.g. "closed->open"; empty if none yet
+    std::chrono::steady_clock::time_point lastTransitionAt{};
+};
+
+// Breaker for one task type. Outcomes go into a sliding window of the last
+// `window` attempts; once it holds `minCalls` and the failure share reaches
+// `failureRate`, the breaker opens. After `openMs` it half-opens and admits
+// up to `probes` tasks at a time: one failure re-opens it, `probes`
+// successes close it with a fresh window. Not thread-safe on its own.
+class CircuitBreaker {
+public:
+    explicit CircuitBreaker(const CircuitBreakerConfig& config);
+
+    // True if a task may be dispatched now; a half-open admit is a probe
+    // (reported through `probe` if given)
+    bool tryAcquire(std::chrono::steady_clock::time_point now, bool* probe = nullptr);
+    void recordResult(bool success, std::chrono::steady_clock::time_point now);
+    // A probe left without running (cancelled, shed, requeued): free its slot
+    void releaseProbe();
+
+    // OPEN and still cooling down
+    bool isOpen(std::chrono::steady_clock::time_point now) const;
+    CircuitBreakerStats getStats() const;
+
+private:
+    void transition(CircuitState to, std::chrono::steady_clock::time_point now);
+
+    CircuitBreakerConfig config;
+    std::vector<bool> outcomes;  // ring buffer, true = failure
+    std::size_t next = 0;
+    std::size_t failures = 0;
+    int probesInFlight = 0;
+    int probeSuccesses = 0;
+    std::chrono::steady_clock::time_point openedAt{};
+    CircuitBreakerStats stats;
+};
+
+// Shared breakers by task type, so every queue and scheduler sees the same
+// state and it survives scheduler swaps. Breakers are created on first use.
+class CircuitBreakerRegistry {
+public:
+    static CircuitBreakerRegistry& instance();
+
+    // Replaces the settings and forgets all breaker state (no-op if unchanged)
+    void configure(const CircuitBreakerConfig& config);
+    CircuitBreakerConfig getConfig() const;
+
+    bool tryAcquire(const std::string& type, bool* probe = nullptr);
+    void recordResult(const std::string& type, bool success);
+    void releaseProbe(const std::string& type);
+    bool isOpen(const std::string& type) const;
+
+    std::map<std::string, CircuitBreakerStats> getStats() const;
+
+private:
+    CircuitBreakerRegistry() = default;
+
+    mutable std::mutex mtx;
+    CircuitBreakerConfig config;
+    std::map<std::string, CircuitBreaker> breakers;
+};
@@ -0,0 +1,180 @@
+#include "CircuitBreakerScheduler.h"
+#include "../../utils/Metrics.h"
+
+#include <stdexcept>
+
+CircuitBreakerScheduler::CircuitBreakerScheduler(std::shared_ptr<Scheduler> inner,
+                                                 CircuitBreakerRegistry& breakers)
+    : SchedulerDecorator(std::move(inner)),
+      breakers(breakers),
+      failFast(breakers.getConfig().failFast) {}
+
+void CircuitBreakerScheduler::hold(Task task) {
+    if (failFast) {
+        task.markRejected("circuit open for type '" + task.getType() + "'");
+        ++rejected;
+        Metrics::instance().recordRejected();
+        return;
+    }
+    parked[task.getType()].push_back(std::move(task));
+    ++parkedCount;
+}
+
+Task CircuitBreakerScheduler::admit(Task task, bool probe) {
+    if (probe) {
+        probes.push_back(task);
+    }
+    return task;
+}
+
+void CircuitBreakerScheduler::releaseAbandonedProbes() {
+    for (auto it = probes.begin(); it != probes.end();) {
+        TaskState state = it->getState();
+        if (state == TaskState::CANCELLED || state == TaskState::REJECTED) {
+            breakers.releaseProbe(it->getType());
+            it = probes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void CircuitBreakerScheduler::submit(Task task) {
+    std::lock_guard<std::mutex> lock(mtx);
+    // Keep FIFO within a type: nothing overtakes tasks already parked
+    auto it = parked.find(task.getType());
+    if (it != parked.end() || breakers.isOpen(task.getType())) {
+        hold(std::move(task));
+        return;
+    }
+    inner->submit(std::move(task));
+}
+
+std::optional<Task> CircuitBreakerScheduler::tryGetNextTask() {
+    std::lock_guard<std::mutex> lock(mtx);
+    releaseAbandonedProbes();
+
+    // Parked tasks are older than anything in the inner scheduler
+    for (auto it = parked.begin(); it != parked.end(); ++it) {
+        bool probe = false;
+        if (breakers.tryAcquire(it->first, &probe)) {
+            Task task = std::move(it->second.front());
+            it->second.pop_front();
+            --parkedCount;
+            if (it->second.empty()) {
+                parked.erase(it);
+            }
+            // Time spent parked is not queueing delay
+            task.resetEnqueueTime();
+            return admit(std::move(task), probe);
+        }
+    }
+
+    while (std::optional<Task> task = inner->tryGetNextTask()) {
+        bool probe = false;
+        if (parked.count(task->getType()) == 0 && breakers.tryAcquire(task->getType(), &probe)) {
+            return admit(std::move(*task), probe);
+        }
+        hold(std::move(*task));
+    }
+    return std::nullopt;
+}
+
+Task CircuitBreakerScheduler::getNextTask() {
+    std::optional<Task> task = tryGetNextTask();
+    if (!task)
+        throw std::runtime_error("CircuitBreakerScheduler: no task available");
+    return std::move(*task);
+}
+
+void CircuitBreakerScheduler::onTaskFinished(const Task& task) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        bool wasProbe = false;
+        for (auto it = probes.begin(); it != probes.end(); ++it) {
+            if (it->getId() == task.getId()) {
+                probes.erase(it);
+                wasProbe = true;
+                break;
+            }
+        }
+        if (task.getState() == TaskState::COMPLETED) {
+            breakers.recordResult(task.getType(), true);
+        } else if (task.getState() == TaskState::FAILED) {
+            breakers.recordResult(task.getType(), false);
+        } else if (wasProbe) {
+            // Dispatched but never ran: no outcome to report
+            breakers.releaseProbe(task.getType());
+        }
+    }
+    inner->onTaskFinished(task);
+}
+
+bool CircuitBreakerScheduler::empty() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return parkedCount == 0 && inner->empty();
+}
+
+std::size_t CircuitBreakerScheduler::size() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return parkedCount + inner->size();
+}
+
+std::vector<Task> CircuitBreakerScheduler::drain() {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<Task> tasks = inner->drain();
+    for (auto& [type, lane] : parked) {
+        for (auto& task : lane) {
+            tasks.push_back(std::move(task));
+        }
+    }
+    parked.clear();
+    parkedCount = 0;
+
+    // Probes still waiting above us are requeued into the next scheduler,
+    // which admits them afresh; running ones still report here
+    for (auto it = probes.begin(); it != probes.end();) {
+        if (it->getState() == TaskState::READY) {
+            breakers.releaseProbe(it->getType());
+            it = probes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    releaseAbandonedProbes();
+    return tasks;
+}
+
+bool CircuitBreakerScheduler::cancel(int taskId) {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::size_t removed = 0;
+    for (auto it = parked.begin(); it != parked.end();) {
+        removed += cancelIn(it->second, taskId);
+        it = it->second.empty() ? parked.erase(it) : std::next(it);
+    }
+    parkedCount -= removed;
+    // A decorator above may have just cancelled a probe we admitted
+    releaseAbandonedProbes();
+    bool inInner = inner->cancel(taskId);
+    return removed > 0 || inInner;
+}
+
+bool CircuitBreakerScheduler::reprioritize(int taskId, TaskPriority priority) {
+    std::lock_guard<std::mutex> lock(mtx);
+    bool found = false;
+    for (auto& [type, lane] : parked) {
+        found = reprioritizeIn(lane, taskId, priority) || found;
+    }
+    bool inInner = inner->reprioritize(taskId, priority);
+    return found || inInner;
+}
+
+std::size_t CircuitBreakerScheduler::getParkedCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return parkedCount;
+}
+
+std::uint64_t CircuitBreakerScheduler::getRejectedCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return rejected;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "SchedulerDecorator.h"
+#include "CircuitBreaker.h"
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Gates dispatch on the per-type circuit breakers in `breakers`. A task whose
+// breaker refuses it is parked here (or rejected, in fail-fast mode) instead
+// of reaching a worker; parked tasks are retried ahead of new work once the
+// breaker half-opens. Outcomes reported through onTaskFinished drive the
+// breakers. A half-open probe that leaves without a result (cancelled or shed
+// above this scheduler, or drained for a scheduler swap) gives its probe slot
+// back, so the breaker can send another.
+class CircuitBreakerScheduler : public SchedulerDecorator {
+public:
+    CircuitBreakerScheduler(std::shared_ptr<Scheduler> inner,
+                            CircuitBreakerRegistry& breakers = CircuitBreakerRegistry::instance());
+
+    void submit(Task task) override;
+    Task getNextTask() override;
+    std::optional<Task> tryGetNextTask() override;
+    bool empty() const override;
+    std::size_t size() const override;
+    void onTaskFinished(const Task& task) override;
+    std::vector<Task> drain() override;
+    bool cancel(int taskId) override;
+    bool reprioritize(int taskId, TaskPriority priority) override;
+
+    std::size_t getParkedCount() const;
+    std::uint64_t getRejectedCount() const;
+
+private:
+    // Caller must hold mtx. Parks or rejects a task its breaker refused
+    void hold(Task task);
+    // Caller must hold mtx. Dispatches a task its breaker admitted
+    Task admit(Task task, bool probe);
+    // Caller must hold mtx. Frees the slots of probes cancelled or rejected
+    // before they ran
+    void releaseAbandonedProbes();
+
+    CircuitBreakerRegistry& breakers;
+    bool failFast;
+
+    mutable std::mutex mtx;
+    std::map<std::string, std::deque<Task>> parked;  // by type
+    std::size_t parkedCount = 0;
+    std::uint64_t rejected = 0;
+    std::vector<Task> probes;  // admitted half-open probes without a result yet
+};
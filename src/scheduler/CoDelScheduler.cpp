@@ -0,0 +1,136 @@
+#include "CoDelScheduler.h"
+#include "../../utils/Metrics.h"
+#include "../../utils/Logger.h"
+
+#include <cmath>
+#include <stdexcept>
+
+CoDelScheduler::CoDelScheduler(std::shared_ptr<Scheduler> inner,
+                               std::chrono::milliseconds target,
+                               std::chrono::milliseconds interval,
+                               bool drainGuard)
+    : SchedulerDecorator(std::move(inner)), target(target), interval(interval),
+      drainGuard(drainGuard),
+      arrivals(interval, DRAIN_WINDOW + 1),
+      departures(interval, DRAIN_WINDOW + 1) {}
+
+void CoDelScheduler::submit(Task task) {
+    if (drainGuard) {
+        arrivals.add();
+    }
+    inner->submit(std::move(task));
+}
+
+bool CoDelScheduler::draining(Clock::time_point now) const {
+    const auto window = interval * DRAIN_WINDOW;
+    return departures.count(window, now) > arrivals.count(window, now);
+}
+
+CoDelScheduler::Clock::time_point CoDelScheduler::controlLaw(Clock::time_point t) const {
+    auto step = std::chrono::duration_cast<Clock::duration>(
+        interval / std::sqrt(static_cast<double>(dropCount)));
+    return t + step;
+}
+
+// Caller must hold mtx. Follows the CoDel dequeue logic (RFC 8289), split so
+// that the drop schedule only advances, in recordDrop(), once a task is shed.
+bool CoDelScheduler::dropDue(Clock::duration sojourn, Clock::time_point now) {
+    bool okToDrop = false;
+    if (sojourn < target) {
+        firstAboveTime = Clock::time_point();
+    } else if (firstAboveTime == Clock::time_point()) {
+        firstAboveTime = now + interval;
+    } else if (now >= firstAboveTime) {
+        okToDrop = true;
+    }
+
+    if (dropping) {
+        if (!okToDrop) {
+            dropping = false;
+            return false;
+        }
+        return now >= dropNext;
+    }
+
+    if (okToDrop && drainGuard && draining(now)) {
+        // Sojourn is high but falling on its own; keep the interval armed
+        return false;
+    }
+    return okToDrop;
+}
+
+// Caller must hold mtx
+void CoDelScheduler::recordDrop(Clock::time_point now) {
+    ++rejected;
+    if (dropping) {
+        ++dropCount;
+        dropNext = controlLaw(dropNext);
+        return;
+    }
+    dropping = true;
+    // Resume near the previous drop rate if we were dropping recently
+    if (dropCount > 2 && now - dropNext < interval * 8) {
+        dropCount -= 2;
+    } else {
+        dropCount = 1;
+    }
+    dropNext = controlLaw(now);
+}
+
+void CoDelScheduler::shed(Task& task, Clock::duration sojourn) {
+    auto sojournMs = std::chrono::duration_cast<std::chrono::milliseconds>(sojourn).count();
+    task.markRejected("load shed: queue sojourn " + std::to_string(sojournMs) +
+                      " ms above target " + std::to_string(target.count()) + " ms");
+    Metrics::instance().recordRejected();
+    Logger::warn("Task " + std::to_string(task.getId()) + " rejected: " +
+                 task.getRejectReason());
+}
+
+Task CoDelScheduler::getNextTask() {
+    std::optional<Task> task = tryGetNextTask();
+    if (!task)
+        throw std::runtime_error("CoDelScheduler: no task available");
+    return std::move(*task);
+}
+
+std::optional<Task> CoDelScheduler::tryGetNextTask() {
+    while (std::optional<Task> next = inner->tryGetNextTask()) {
+        const auto now = Clock::now();
+        const auto sojourn = now - next->getEnqueueTime();
+        if (drainGuard) {
+            departures.add(1, now);
+        }
+
+        std::optional<Task> victim;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!dropDue(sojourn, now)) {
+                return next;
+            }
+            // Prefer a sheddable task queued below the head; a head of equal
+            // priority is the older one, so it goes first
+            if (!next->isSheddable()) {
+                victim = inner->takeShedCandidate(TaskPriority::HIGH);
+            } else if (next->getPriority() != TaskPriority::LOW) {
+                victim = inner->takeShedCandidate(
+                    static_cast<TaskPriority>(static_cast<int>(next->getPriority()) - 1));
+            }
+            if (!victim && !next->isSheddable()) {
+                return next;
+            }
+            recordDrop(now);
+        }
+
+        if (victim) {
+            shed(*victim, sojourn);
+            return next;
+        }
+        shed(*next, sojourn);
+    }
+    return std::nullopt;
+}
+
+std::uint64_t CoDelScheduler::getRejectedCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return rejected;
+}
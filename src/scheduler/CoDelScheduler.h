@@ -0,0 +1,55 @@
+#pragma once
+#include "SchedulerDecorator.h"
+#include "../../utils/RateWindow.h"
+#include <mutex>
+#include <cstdint>
+
+// Delay-based load shedding (CoDel) on top of any scheduler.
+// Sojourn time (now - enqueue time) is measured at dequeue. Once it has
+// stayed above `target` for a full `interval`, the controller enters the
+// dropping state and sheds one task per drop, at a rate that rises with
+// sqrt(drop count) until sojourn falls back under target. The task shed is
+// the lowest-priority sheddable one: a queued task below the head's priority
+// if the wrapped scheduler can pick one out, else the head itself.
+// Non-sheddable tasks are always passed through, and a drop with nothing
+// sheddable to shed does not advance the drop schedule.
+// With the drain guard, arrivals and departures are counted in windows of
+// DRAIN_WINDOW intervals; dropping does not start while departures outpace
+// arrivals, since the standing queue is already shrinking.
+class CoDelScheduler : public SchedulerDecorator {
+public:
+    static constexpr int DRAIN_WINDOW = 10;  // intervals
+
+    CoDelScheduler(std::shared_ptr<Scheduler> inner,
+                   std::chrono::milliseconds target = std::chrono::milliseconds(5),
+                   std::chrono::milliseconds interval = std::chrono::milliseconds(100),
+                   bool drainGuard = false);
+
+    void submit(Task task) override;
+    Task getNextTask() override;
+    std::optional<Task> tryGetNextTask() override;
+
+    std::uint64_t getRejectedCount() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    bool dropDue(Clock::duration sojourn, Clock::time_point now);
+    void recordDrop(Clock::time_point now);
+    void shed(Task& task, Clock::duration sojourn);
+    Clock::time_point controlLaw(Clock::time_point t) const;
+    bool draining(Clock::time_point now) const;
+
+    std::chrono::milliseconds target;
+    std::chrono::milliseconds interval;
+    bool drainGuard;
+    RateWindow arrivals;
+    RateWindow departures;  // served or shed
+
+    mutable std::mutex mtx;
+    Clock::time_point firstAboveTime{};
+    Clock::time_point dropNext{};
+    std::uint32_t dropCount = 0;
+    bool dropping = false;
+    std::uint64_t rejected = 0;
+};
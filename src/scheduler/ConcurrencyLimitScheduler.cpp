@@ -0,0 +1,200 @@
+#include "ConcurrencyLimitScheduler.h"
+
+#include <stdexcept>
+
+ConcurrencyLimitScheduler::ConcurrencyLimitScheduler(std::shared_ptr<Scheduler> inner)
+    : SchedulerDecorator(std::move(inner)), slots(std::make_shared<ConcurrencySlots>()) {}
+
+bool ConcurrencyLimitScheduler::isLimited(const Task& task) {
+    return !task.getConcurrencyKey().empty() && task.getMaxConcurrency() > 0;
+}
+
+void ConcurrencyLimitScheduler::submit(Task task) {
+    if (isLimited(task)) {
+        // Known to be full: wait on the key now instead of taking a trip
+        // through the wrapped scheduler
+        std::lock_guard<std::mutex> lock(slots->mtx);
+        auto it = slots->keys.find(task.getConcurrencyKey());
+        if (it != slots->keys.end() &&
+            (it->second.running >= task.getMaxConcurrency() || !it->second.waiting.empty())) {
+            it->second.limit = task.getMaxConcurrency();
+            it->second.waiting.push_back(std::move(task));
+            return;
+        }
+    }
+    inner->submit(std::move(task));
+}
+
+std::optional<Task> ConcurrencyLimitScheduler::tryGetNextTask() {
+    {
+        std::lock_guard<std::mutex> lock(slots->mtx);
+        if (!slots->handoff.empty()) {
+            Task task = std::move(slots->handoff.front());
+            slots->handoff.pop_front();
+            return task;
+        }
+    }
+
+    while (std::optional<Task> task = inner->tryGetNextTask()) {
+        if (!isLimited(*task)) {
+            return task;
+        }
+
+        std::lock_guard<std::mutex> lock(slots->mtx);
+        ConcurrencySlots::KeyState& state = slots->keys[task->getConcurrencyKey()];
+        state.limit = task->getMaxConcurrency();
+        if (state.running < state.limit && state.waiting.empty()) {
+            ++state.running;
+            return task;
+        }
+        // Full: park on the key; a finishing holder will hand its slot over
+        state.waiting.push_back(std::move(*task));
+    }
+    return std::nullopt;
+}
+
+Task ConcurrencyLimitScheduler::getNextTask() {
+    std::optional<Task> task = tryGetNextTask();
+    if (!task)
+        throw std::runtime_error("ConcurrencyLimitScheduler: no task available");
+    return std::move(*task);
+}
+
+bool ConcurrencyLimitScheduler::empty() const {
+    // Parked waiters are not runnable until a holder finishes, and every
+    // holder is running, so they are not counted here
+    std::lock_guard<std::mutex> lock(slots->mtx);
+    return slots->handoff.empty() && inner->empty();
+}
+
+void ConcurrencyLimitScheduler::onTaskFinished(const Task& task) {
+    inner->onTaskFinished(task);
+    if (!isLimited(task)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(slots->mtx);
+    releaseSlot(task.getConcurrencyKey());
+}
+
+void ConcurrencyLimitScheduler::releaseSlot(const std::string& key) {
+    auto it = slots->keys.find(key);
+    if (it == slots->keys.end()) {
+        return;
+    }
+
+    ConcurrencySlots::KeyState& state = it->second;
+    if (!state.waiting.empty() && state.running <= state.limit) {
+        // Direct handoff: the slot passes to the oldest waiter
+        slots->handoff.push_back(std::move(state.waiting.front()));
+        state.waiting.pop_front();
+        return;
+    }
+    if (state.running > 0) {
+        --state.running;
+    }
+    if (state.running == 0 && state.waiting.empty()) {
+        slots->keys.erase(it);
+    }
+}
+
+bool ConcurrencyLimitScheduler::cancel(int taskId) {
+    std::lock_guard<std::mutex> lock(slots->mtx);
+    bool found = false;
+    for (auto& [key, state] : slots->keys) {
+        found = cancelIn(state.waiting, taskId) > 0 || found;
+    }
+    // Handed-off tasks hold a slot they will never use; pass it on once the
+    // handoff queue is no longer being iterated
+    std::vector<std::string> freed;
+    for (auto it = slots->handoff.begin(); it != slots->handoff.end();) {
+        if (it->getId() == taskId) {
+            freed.push_back(it->getConcurrencyKey());
+            it->markCancelled();
+            it = slots->handoff.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (const auto& key : freed) {
+        releaseSlot(key);
+    }
+    found = found || !freed.empty();
+    bool inInner = inner->cancel(taskId);
+    return found || inInner;
+}
+
+bool ConcurrencyLimitScheduler::reprioritize(int taskId, TaskPriority priority) {
+    std::lock_guard<std::mutex> lock(slots->mtx);
+    bool found = reprioritizeIn(slots->handoff, taskId, priority);
+    for (auto& [key, state] : slots->keys) {
+        found = reprioritizeIn(state.waiting, taskId, priority) || found;
+    }
+    bool inInner = inner->reprioritize(taskId, priority);
+    return found || inInner;
+}
+
+// Adopt the previous limiter's table before its waiters are drained into us:
+// they park here again, and its holders keep counting against their keys
+void ConcurrencyLimitScheduler::takeOver(Scheduler& previous) {
+    if (std::shared_ptr<ConcurrencySlots> previousSlots = previous.getConcurrencySlots()) {
+        slots = std::move(previousSlots);
+    }
+    inner->takeOver(previous);
+}
+
+std::shared_ptr<ConcurrencySlots> ConcurrencyLimitScheduler::getConcurrencySlots() {
+    return slots;
+}
+
+int ConcurrencyLimitScheduler::getRunning(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(slots->mtx);
+    auto it = slots->keys.find(key);
+    return it == slots->keys.end() ? 0 : it->second.running;
+}
+
+std::size_t ConcurrencyLimitScheduler::getWaiting(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(slots->mtx);
+    auto it = slots->keys.find(key);
+    return it == slots->keys.end() ? 0 : it->second.waiting.size();
+}
+
+// Slot counts of running holders are kept: they report back through
+// onTaskFinished and must find their key. A handed-off task gives its slot
+// back; it takes one again when it is dispatched after the move.
+std::vector<Task> ConcurrencyLimitScheduler::drain() {
+    std::lock_guard<std::mutex> lock(slots->mtx);
+    std::vector<Task> tasks;
+    for (auto& task : slots->handoff) {
+        auto it = slots->keys.find(task.getConcurrencyKey());
+        if (it != slots->keys.end() && it->second.running > 0) {
+            --it->second.running;
+        }
+        tasks.push_back(std::move(task));
+    }
+    slots->handoff.clear();
+    for (auto it = slots->keys.begin(); it != slots->keys.end();) {
+        for (auto& task : it->second.waiting) {
+            tasks.push_back(std::move(task));
+        }
+        it->second.waiting.clear();
+        if (it->second.running == 0) {
+            it = slots->keys.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto& task : inner->drain()) {
+        tasks.push_back(std::move(task));
+    }
+    return tasks;
+}
+
+std::size_t ConcurrencyLimitScheduler::size() const {
+    std::lock_guard<std::mutex> lock(slots->mtx);
+    std::size_t held = slots->handoff.size();
+    for (const auto& [key, state] : slots->keys) {
+        held += state.waiting.size();
+    }
+    return held + inner->size();
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "SchedulerDecorator.h"
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Slot counts, waiters and handed-off tasks of a concurrency limiter
+class ConcurrencySlots {
+public:
+    struct KeyState {
+        int running = 0;  // slots held (running or handed off)
+        int limit = 1;
+        std::deque<Task> waiting;
+    };
+
+    std::mutex mtx;
+    std::unordered_map<std::string, KeyState> keys;
+    std::deque<Task> handoff;  // waiters that were handed a slot
+};
+
+// Per-key concurrency limits (counting semaphores) on top of any scheduler.
+// A task with a concurrency key holds one of the key's slots from dispatch
+// until its execution attempt finishes. Tasks that find the key full wait in
+// the key's side queue rather than going back into the wrapped scheduler;
+// when a holder finishes, its slot is handed directly to the oldest waiter,
+// which is served ahead of the wrapped scheduler.
+// The slot table is shared with a replacement limiter (takeOver), so holders
+// that finish on the old instance after a scheduler swap release their slots
+// where the new one dispatches from, and a key never runs above its limit.
+class ConcurrencyLimitScheduler : public SchedulerDecorator {
+public:
+    explicit ConcurrencyLimitScheduler(std::shared_ptr<Scheduler> inner);
+
+    void submit(Task task) override;
+    Task getNextTask() override;
+    std::optional<Task> tryGetNextTask() override;
+    bool empty() const override;
+    std::size_t size() const override;
+    std::vector<Task> drain() override;
+    void onTaskFinished(const Task& task) override;
+    bool cancel(int taskId) override;
+    bool reprioritize(int taskId, TaskPriority priority) override;
+    void takeOver(Scheduler& previous) override;
+    std::shared_ptr<ConcurrencySlots> getConcurrencySlots() override;
+
+    int getRunning(const std::string& key) const;
+    std::size_t getWaiting(const std::string& key) const;
+
+private:
+    static bool isLimited(const Task& task);
+    // Caller must hold slots->mtx. Passes a held slot to the oldest waiter or frees it
+    void releaseSlot(const std::string& key);
+
+    std::shared_ptr<ConcurrencySlots> slots;
+};
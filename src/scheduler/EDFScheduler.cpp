@@ -0,0 +1,105 @@
+#include "EDFScheduler.h"
+#include "../../utils/Metrics.h"
+#include "../../utils/RuntimeEstimator.h"
+#include "../../utils/Logger.h"
+
+#include <stdexcept>
+
+EDFScheduler::EDFScheduler(DeadlineMissPolicy policy)
+    : policy(policy) {}
+
+bool EDFScheduler::canMeetDeadline(const Task& task,
+                                   std::chrono::steady_clock::time_point now) const {
+    auto expected = RuntimeEstimator::instance().estimate(task);
+    return now + expected <= task.getDeadline();
+}
+
+// Caller must hold mtx
+void EDFScheduler::handleMiss(Task task) {
+    if (policy == DeadlineMissPolicy::DROP) {
+        Logger::warn("Task " + std::to_string(task.getId()) +
+                     " cannot meet its deadline; dropping");
+        task.markFailed();
+        Metrics::instance().recordDeadlineDropped();
+        return;
+    }
+
+    Metrics::instance().recordDeadlineDemoted();
+    lateQueue.push(std::move(task));
+}
+
+void EDFScheduler::submit(Task task) {
+    std::lock_guard<std::mutex> lock(mtx);
+    task.markReady();
+
+    if (!task.hasDeadline()) {
+        bestEffortQueue.push(std::move(task));
+    } else if (canMeetDeadline(task, std::chrono::steady_clock::now())) {
+        deadlineQueue.push(std::move(task));
+    } else {
+        handleMiss(std::move(task));
+    }
+}
+
+Task EDFScheduler::getNextTask() {
+    std::optional<Task> task = tryGetNextTask();
+    if (!task)
+        throw std::runtime_error("EDFScheduler: no task available");
+    return std::move(*task);
+}
+
+std::optional<Task> EDFScheduler::tryGetNextTask() {
+    std::lock_guard<std::mutex> lock(mtx);
+    const auto now = std::chrono::steady_clock::now();
+
+    // Eagerly shed heads that can no longer make it
+    while (!deadlineQueue.empty()) {
+        Task task = deadlineQueue.top();
+        deadlineQueue.pop();
+        if (canMeetDeadline(task, now))
+            return task;
+        handleMiss(std::move(task));
+    }
+
+    if (!bestEffortQueue.empty()) {
+        Task task = bestEffortQueue.top();
+        bestEffortQueue.pop();
+        return task;
+    }
+
+    if (!lateQueue.empty()) {
+        Task task = std::move(lateQueue.front());
+        lateQueue.pop();
+        return task;
+    }
+
+    return std::nullopt;
+}
+
+bool EDFScheduler::empty() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return deadlineQueue.empty() && bestEffortQueue.empty() && lateQueue.empty();
+}
+
+std::vector<Task> EDFScheduler::drain() {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<Task> tasks;
+    while (!deadlineQueue.empty()) {
+        tasks.push_back(deadlineQueue.top());
+        deadlineQueue.pop();
+    }
+    while (!bestEffortQueue.empty()) {
+        tasks.push_back(bestEffortQueue.top());
+        bestEffortQueue.pop();
+    }
+    while (!lateQueue.empty()) {
+        tasks.push_back(std::move(lateQueue.front()));
+        lateQueue.pop();
+    }
+    return tasks;
+}
+
+std::size_t EDFScheduler::size() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return deadlineQueue.size() + bestEffortQueue.size() + lateQueue.size();
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "Scheduler.h"
+#include "PriorityScheduler.h"
+#include <queue>
+#include <mutex>
+
+// What to do with a task that can no longer finish before its deadline
+enum class DeadlineMissPolicy {
+    DEMOTE,  // run it after all feasible and best-effort work
+    DROP     // fail it without running
+};
+
+struct DeadlineComparator {
+    bool operator()(const Task& a, const Task& b) const {
+        if (a.getDeadline() != b.getDeadline())
+            return a.getDeadline() > b.getDeadline();
+
+        return a.getEnqueueTime() > b.getEnqueueTime();
+    }
+};
+
+// Earliest-deadline-first scheduler.
+// Order: tasks with a feasible deadline (earliest first), then tasks without
+// a deadline (by priority), then demoted tasks that already missed (FIFO).
+// A task is infeasible once now + its expected exec time (RuntimeEstimator)
+// passes its deadline; this is checked on submit and again at the head.
+class EDFScheduler : public Scheduler {
+public:
+    explicit EDFScheduler(DeadlineMissPolicy policy = DeadlineMissPolicy::DEMOTE);
+
+    void submit(Task task) override;
+    Task getNextTask() override;
+    std::optional<Task> tryGetNextTask() override;
+    bool empty() const override;
+    std::size_t size() const override;
+    std::vector<Task> drain() override;
+
+private:
+    bool canMeetDeadline(const Task& task,
+                         std::chrono::steady_clock::time_point now) const;
+    void handleMiss(Task task);
+
+    DeadlineMissPolicy policy;
+
+    mutable std::mutex mtx;
+    std::priority_queue<Task, std::vector<Task>, DeadlineComparator> deadlineQueue;
+    std::priority_queue<Task, std::vector<Task>, TaskComparator> bestEffortQueue;
+    std::queue<Task> lateQueue;
+};
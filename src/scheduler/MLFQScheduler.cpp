@@ -0,0 +1,94 @@
+#include "MLFQScheduler.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+MLFQScheduler::MLFQScheduler(std::chrono::milliseconds agingInterval,
+                             std::chrono::milliseconds longRunThreshold,
+                             int demoteAfter)
+    : agingInterval(agingInterval),
+      longRunThreshold(longRunThreshold),
+      demoteAfter(std::max(1, demoteAfter)) {}
+
+void MLFQScheduler::submit(Task task) {
+    std::lock_guard<std::mutex> lock(mtx);
+    task.markReady();
+
+    int level = static_cast<int>(task.getPriority());
+    auto it = typeHistory.find(task.getType());
+    if (it != typeHistory.end()) {
+        level = std::max(0, level - it->second.demotion);
+    }
+
+    auto key = task.getEnqueueTime() - agingInterval * level;
+    pq.push(Entry{key, nextSeq++, std::move(task)});
+}
+
+Task MLFQScheduler::getNextTask() {
+    std::optional<Task> task = tryGetNextTask();
+    if (!task)
+        throw std::runtime_error("MLFQScheduler: no task available");
+    return std::move(*task);
+}
+
+std::optional<Task> MLFQScheduler::tryGetNextTask() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (pq.empty())
+        return std::nullopt;
+    Task task = pq.top().task;
+    pq.pop();
+    return task;
+}
+
+bool MLFQScheduler::empty() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return pq.empty();
+}
+
+void MLFQScheduler::onTaskFinished(const Task& task) {
+    if (task.getType().empty())
+        return;
+
+    const auto execTime = task.getEndTime() - task.getStartTime();
+
+    std::lock_guard<std::mutex> lock(mtx);
+    TypeHistory& history = typeHistory[task.getType()];
+
+    // Demote a type after demoteAfter long runs in a row; promote it back
+    // one level after the same number of short runs
+    if (execTime > longRunThreshold) {
+        history.consecutiveShort = 0;
+        if (++history.consecutiveLong >= demoteAfter) {
+            history.demotion = std::min(MAX_LEVEL, history.demotion + 1);
+            history.consecutiveLong = 0;
+        }
+    } else {
+        history.consecutiveLong = 0;
+        if (history.demotion > 0 && ++history.consecutiveShort >= demoteAfter) {
+            --history.demotion;
+            history.consecutiveShort = 0;
+        }
+    }
+}
+
+int MLFQScheduler::getTypeDemotion(const std::string& type) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = typeHistory.find(type);
+    return it == typeHistory.end() ? 0 : it->second.demotion;
+}
+
+std::vector<Task> MLFQScheduler::drain() {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<Task> tasks;
+    tasks.reserve(pq.size());
+    while (!pq.empty()) {
+        tasks.push_back(pq.top().task);
+        pq.pop();
+    }
+    return tasks;
+}
+
+std::size_t MLFQScheduler::size() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return pq.size();
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "Scheduler.h"
+#include <queue>
+#include <mutex>
+#include <map>
+#include <string>
+#include <cstdint>
+
+// Multi-level feedback queue with lazy aging.
+// A task's level starts at its priority (LOW=0 .. HIGH=2), minus any
+// demotion earned by its type, and rises by one for every agingInterval it
+// waits. Because every queued task ages at the same rate, "level + waited /
+// agingInterval" orders tasks exactly like the static key
+// "enqueueTime - level * agingInterval", so a single heap on that key gives
+// aging without ever rescanning the queue.
+class MLFQScheduler : public Scheduler {
+public:
+    static constexpr int MAX_LEVEL = static_cast<int>(TaskPriority::HIGH);
+
+    MLFQScheduler(std::chrono::milliseconds agingInterval = std::chrono::milliseconds(1000),
+                  std::chrono::milliseconds longRunThreshold = std::chrono::milliseconds(500),
+                  int demoteAfter = 3);
+
+    void submit(Task task) override;
+    Task getNextTask() override;
+    std::optional<Task> tryGetNextTask() override;
+    bool empty() const override;
+    std::size_t size() const override;
+    std::vector<Task> drain() override;
+    void onTaskFinished(const Task& task) override;
+
+    // Current level demotion applied to a task type (0 = none)
+    int getTypeDemotion(const std::string& type) const;
+
+private:
+    struct Entry {
+        std::chrono::steady_clock::time_point key;
+        std::uint64_t seq;
+        Task task;
+    };
+
+    struct EntryComparator {
+        bool operator()(const Entry& a, const Entry& b) const {
+            if (a.key != b.key)
+                return a.key > b.key;
+            return a.seq > b.seq;
+        }
+    };
+
+    struct TypeHistory {
+        int consecutiveLong = 0;
+        int consecutiveShort = 0;
+        int demotion = 0;
+    };
+
+    std::chrono::milliseconds agingInterval;
+    std::chrono::milliseconds longRunThreshold;
+    int demoteAfter;
+
+    mutable std::mutex mtx;
+    std::priority_queue<Entry, std::vector<Entry>, EntryComparator> pq;
+    std::uint64_t nextSeq = 0;
+    std::map<std::string, TypeHistory> typeHistory;
+};
@@ -1,19 +1,164 @@
 #include "PriorityScheduler.h"
 
+#include <stdexcept>
+
+bool PriorityScheduler::before(const Entry& a, const Entry& b) {
+    if (a.task.getPriority() != b.task.getPriority())
+        return static_cast<int>(a.task.getPriority()) > static_cast<int>(b.task.getPriority());
+    if (a.task.getEnqueueTime() != b.task.getEnqueueTime())
+        return a.task.getEnqueueTime() < b.task.getEnqueueTime();
+    return a.seq < b.seq;
+}
+
+void PriorityScheduler::place(std::size_t slot, Entry entry) {
+    slotBySeq[entry.seq] = slot;
+    heap[slot] = std::move(entry);
+}
+
+void PriorityScheduler::siftUp(std::size_t slot) {
+    Entry moving = std::move(heap[slot]);
+    while (slot > 0) {
+        std::size_t parent = (slot - 1) / 2;
+        if (!before(moving, heap[parent]))
+            break;
+        place(slot, std::move(heap[parent]));
+        slot = parent;
+    }
+    place(slot, std::move(moving));
+}
+
+void PriorityScheduler::siftDown(std::size_t slot) {
+    Entry moving = std::move(heap[slot]);
+    const std::size_t count = heap.size();
+    while (true) {
+        std::size_t child = 2 * slot + 1;
+        if (child >= count)
+            break;
+        if (child + 1 < count && before(heap[child + 1], heap[child]))
+            ++child;
+        if (!before(heap[child], moving))
+            break;
+        place(slot, std::move(heap[child]));
+        slot = child;
+    }
+    place(slot, std::move(moving));
+}
+
+PriorityScheduler::Entry PriorityScheduler::removeAt(std::size_t slot) {
+    Entry removed = std::move(heap[slot]);
+    slotBySeq.erase(removed.seq);
+    auto range = seqsById.equal_range(removed.task.getId());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == removed.seq) {
+            seqsById.erase(it);
+            break;
+        }
+    }
+
+    Entry last = std::move(heap.back());
+    heap.pop_back();
+    if (slot < heap.size()) {
+        // Fill the hole with the last entry and restore heap order around it
+        bool rises = before(last, removed);
+        place(slot, std::move(last));
+        if (rises) {
+            siftUp(slot);
+        } else {
+            siftDown(slot);
+        }
+    }
+    return removed;
+}
+
 void PriorityScheduler::submit(Task task) {
     std::lock_guard<std::mutex> lock(mtx);
     task.markReady();
-    pq.push(std::move(task));
+    std::uint64_t seq = nextSeq++;
+    seqsById.emplace(task.getId(), seq);
+    heap.push_back(Entry{std::move(task), seq});
+    slotBySeq[seq] = heap.size() - 1;
+    siftUp(heap.size() - 1);
 }
 
 Task PriorityScheduler::getNextTask() {
+    std::optional<Task> task = tryGetNextTask();
+    if (!task)
+        throw std::runtime_error("PriorityScheduler: no task available");
+    return std::move(*task);
+}
+
+std::optional<Task> PriorityScheduler::tryGetNextTask() {
     std::lock_guard<std::mutex> lock(mtx);
-    Task task = pq.top();  // Remove redundant std::move
-    pq.pop();
-    return task;
+    if (heap.empty())
+        return std::nullopt;
+    return removeAt(0).task;
 }
 
 bool PriorityScheduler::empty() const {
     std::lock_guard<std::mutex> lock(mtx);
-    return pq.empty();
+    return heap.empty();
+}
+
+std::vector<Task> PriorityScheduler::drain() {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<Task> tasks;
+    tasks.reserve(heap.size());
+    while (!heap.empty()) {
+        tasks.push_back(removeAt(0).task);
+    }
+    return tasks;
+}
+
+bool PriorityScheduler::cancel(int taskId) {
+    std::lock_guard<std::mutex> lock(mtx);
+    bool found = false;
+    // Slots move as entries are removed, so look the next one up each time
+    while (seqsById.count(taskId) > 0) {
+        std::size_t slot = slotBySeq.at(seqsById.find(taskId)->second);
+        removeAt(slot).task.markCancelled();
+        found = true;
+    }
+    return found;
+}
+
+bool PriorityScheduler::reprioritize(int taskId, TaskPriority priority) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto range = seqsById.equal_range(taskId);
+    bool found = range.first != range.second;
+    for (auto it = range.first; it != range.second; ++it) {
+        // Looked up per entry: sifting one entry can move the others
+        std::size_t slot = slotBySeq.at(it->second);
+        TaskPriority previous = heap[slot].task.getPriority();
+        heap[slot].task.setPriority(priority);
+        if (static_cast<int>(priority) > static_cast<int>(previous)) {
+            siftUp(slot);
+        } else {
+            siftDown(slot);
+        }
+    }
+    return found;
+}
+
+std::size_t PriorityScheduler::size() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return heap.size();
+}
+
+// Linear: the heap keeps the lowest priorities among its leaves in no order,
+// and this runs only when overload control is due to shed
+std::optional<Task> PriorityScheduler::takeShedCandidate(TaskPriority atMost) {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::size_t victim = heap.size();
+    for (std::size_t slot = 0; slot < heap.size(); ++slot) {
+        const Task& task = heap[slot].task;
+        if (!task.isSheddable() || static_cast<int>(task.getPriority()) > static_cast<int>(atMost))
+            continue;
+        if (victim == heap.size() ||
+            static_cast<int>(task.getPriority()) < static_cast<int>(heap[victim].task.getPriority()) ||
+            (task.getPriority() == heap[victim].task.getPriority() && before(heap[slot], heap[victim])))
+            victim = slot;
+    }
+    if (victim == heap.size())
+        return std::nullopt;
+    return removeAt(victim).task;
 }
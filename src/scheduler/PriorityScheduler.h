@@ -1,7 +1,9 @@
 #pragma once
 #include "Scheduler.h"
-#include <queue>
+#include <cstdint>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 struct TaskComparator {
     bool operator()(const Task& a, const Task& b) const {
@@ -13,13 +15,41 @@ struct TaskComparator {
     }
 };
 
+// Highest priority first, FIFO within a priority. The heap is indexed (task
+// id -> heap slot), so a queued task can be cancelled or reprioritized in
+// O(log n) instead of waiting to be skipped at dequeue.
 class PriorityScheduler : public Scheduler {
 public:
     void submit(Task task) override;
     Task getNextTask() override;
+    std::optional<Task> tryGetNextTask() override;
     bool empty() const override;
+    std::size_t size() const override;
+    std::vector<Task> drain() override;
+    bool cancel(int taskId) override;
+    bool reprioritize(int taskId, TaskPriority priority) override;
+    std::optional<Task> takeShedCandidate(TaskPriority atMost) override;
 
 private:
+    struct Entry {
+        Task task;
+        std::uint64_t seq;  // submit order; breaks enqueue-time ties
+    };
+
+    // True if a must be served before b
+    static bool before(const Entry& a, const Entry& b);
+
+    // All callers must hold mtx
+    void place(std::size_t slot, Entry entry);
+    void siftUp(std::size_t slot);
+    void siftDown(std::size_t slot);
+    Entry removeAt(std::size_t slot);
+
     mutable std::mutex mtx;
-    std::priority_queue<Task, std::vector<Task>, TaskComparator> pq;
+    std::vector<Entry> heap;
+    // Recurring occurrences can share an id, so an id maps to each of its
+    // entries (by seq), and each seq to its current heap slot
+    std::unordered_multimap<int, std::uint64_t> seqsById;
+    std::unordered_map<std::uint64_t, std::size_t> slotBySeq;
+    std::uint64_t nextSeq = 0;
 };
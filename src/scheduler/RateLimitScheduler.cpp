@@ -0,0 +1,211 @@
+#include "RateLimitScheduler.h"
+#include "../../utils/Metrics.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+void RateLimitScheduler::Bucket::refill(Clock::time_point now) {
+    double elapsed = std::chrono::duration<double>(now - last).count();
+    if (elapsed > 0.0) {
+        tokens = std::min(limit.burst, tokens + elapsed * limit.rate);
+        last = now;
+    }
+}
+
+RateLimitScheduler::Clock::duration RateLimitScheduler::Bucket::timeUntilToken() const {
+    if (tokens >= 1.0) {
+        return Clock::duration::zero();
+    }
+    return std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>((1.0 - tokens) / limit.rate));
+}
+
+RateLimitScheduler::RateLimitScheduler(std::shared_ptr<Scheduler> inner,
+                                       const std::map<std::string, RateLimit>& typeLimits,
+                                       const std::map<std::string, RateLimit>& tenantLimits)
+    : SchedulerDecorator(std::move(inner)) {
+    auto now = Clock::now();
+    for (const auto& [type, limit] : typeLimits) {
+        typeBuckets[type] = Bucket{limit, limit.burst, now};
+    }
+    for (const auto& [tenant, limit] : tenantLimits) {
+        tenantBuckets[tenant] = Bucket{limit, limit.burst, now};
+    }
+}
+
+RateLimitScheduler::Bucket* RateLimitScheduler::findBucket(std::map<std::string, Bucket>& buckets,
+                                                           const std::string& key) {
+    if (key.empty()) {
+        return nullptr;
+    }
+    auto it = buckets.find(key);
+    return it == buckets.end() ? nullptr : &it->second;
+}
+
+// Takes a token from every bucket the lane is subject to, or from none
+bool RateLimitScheduler::tryAcquire(Lane& lane, Clock::time_point now) {
+    for (Bucket* bucket : {lane.typeBucket, lane.tenantBucket}) {
+        if (bucket) {
+            bucket->refill(now);
+            if (bucket->tokens < 1.0) {
+                return false;
+            }
+        }
+    }
+    for (Bucket* bucket : {lane.typeBucket, lane.tenantBucket}) {
+        if (bucket) {
+            bucket->tokens -= 1.0;
+        }
+    }
+    return true;
+}
+
+// Time until every bucket the lane is subject to has a token
+RateLimitScheduler::Clock::duration RateLimitScheduler::laneWait(Lane& lane, Clock::time_point now) {
+    Clock::duration wait = Clock::duration::zero();
+    for (Bucket* bucket : {lane.typeBucket, lane.tenantBucket}) {
+        if (bucket) {
+            bucket->refill(now);
+            wait = std::max(wait, bucket->timeUntilToken());
+        }
+    }
+    return wait;
+}
+
+void RateLimitScheduler::submit(Task task) {
+    std::lock_guard<std::mutex> lock(mtx);
+    Bucket* typeBucket = findBucket(typeBuckets, task.getType());
+    Bucket* tenantBucket = findBucket(tenantBuckets, task.getTenant());
+    if (!typeBucket && !tenantBucket) {
+        inner->submit(std::move(task));
+        return;
+    }
+
+    auto now = Clock::now();
+    auto key = std::make_pair(task.getType(), task.getTenant());
+    auto it = lanes.find(key);
+    if (it == lanes.end()) {
+        Lane probe{typeBucket, tenantBucket, {}};
+        if (tryAcquire(probe, now)) {
+            inner->submit(std::move(task));
+            return;
+        }
+        it = lanes.emplace(key, std::move(probe)).first;
+    }
+
+    // Over the limit, or others of this kind are already waiting (keep FIFO)
+    it->second.parked.push_back(std::move(task));
+    ++parkedCount;
+    ++throttled;
+    Metrics::instance().recordThrottled();
+    // Each lane waits for its own buckets, not behind a slower lane
+    Clock::time_point laneReady = now + laneWait(it->second, now);
+    nextRelease = parkedCount == 1 ? laneReady : std::min(nextRelease, laneReady);
+}
+
+// Caller must hold mtx. Releases one task per lane per pass so lanes that
+// share a tenant bucket take turns.
+void RateLimitScheduler::releaseParked(Clock::time_point now) {
+    if (parkedCount == 0 || now < nextRelease) {
+        return;
+    }
+
+    bool progress = true;
+    while (progress && parkedCount > 0) {
+        progress = false;
+        for (auto it = lanes.begin(); it != lanes.end();) {
+            Lane& lane = it->second;
+            if (tryAcquire(lane, now)) {
+                Task task = std::move(lane.parked.front());
+                lane.parked.pop_front();
+                --parkedCount;
+                // Time spent parked is throttling, not queueing delay
+                task.resetEnqueueTime();
+                inner->submit(std::move(task));
+                progress = true;
+            }
+            if (lane.parked.empty()) {
+                it = lanes.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Nothing can be released before the soonest bucket refills
+    Clock::duration wait = Clock::duration::max();
+    for (auto& [key, lane] : lanes) {
+        wait = std::min(wait, laneWait(lane, now));
+    }
+    nextRelease = parkedCount > 0 ? now + wait : Clock::time_point{};
+}
+
+std::optional<Task> RateLimitScheduler::tryGetNextTask() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        releaseParked(Clock::now());
+    }
+    return inner->tryGetNextTask();
+}
+
+Task RateLimitScheduler::getNextTask() {
+    std::optional<Task> task = tryGetNextTask();
+    if (!task)
+        throw std::runtime_error("RateLimitScheduler: no task available");
+    return std::move(*task);
+}
+
+bool RateLimitScheduler::empty() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return parkedCount == 0 && inner->empty();
+}
+
+std::size_t RateLimitScheduler::getParkedCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return parkedCount;
+}
+
+std::uint64_t RateLimitScheduler::getThrottledCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return throttled;
+}
+
+std::vector<Task> RateLimitScheduler::drain() {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<Task> tasks = inner->drain();
+    for (auto& [key, lane] : lanes) {
+        for (auto& task : lane.parked) {
+            tasks.push_back(std::move(task));
+        }
+    }
+    lanes.clear();
+    parkedCount = 0;
+    return tasks;
+}
+
+std::size_t RateLimitScheduler::size() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return parkedCount + inner->size();
+}
+
+bool RateLimitScheduler::cancel(int taskId) {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::size_t removed = 0;
+    for (auto it = lanes.begin(); it != lanes.end();) {
+        removed += cancelIn(it->second.parked, taskId);
+        it = it->second.parked.empty() ? lanes.erase(it) : std::next(it);
+    }
+    parkedCount -= removed;
+    bool inInner = inner->cancel(taskId);
+    return removed > 0 || inInner;
+}
+
+bool RateLimitScheduler::reprioritize(int taskId, TaskPriority priority) {
+    std::lock_guard<std::mutex> lock(mtx);
+    bool found = false;
+    for (auto& [key, lane] : lanes) {
+        found = reprioritizeIn(lane.parked, taskId, priority) || found;
+    }
+    bool inInner = inner->reprioritize(taskId, priority);
+    return found || inInner;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "SchedulerDecorator.h"
+#include "../../utils/Config.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+// Token-bucket rate limits per task type and per tenant on top of any
+// scheduler. A task over its limit is parked in a side queue here, so it is
+// never handed to a worker, and is released into the wrapped scheduler once
+// its buckets have a token again. Parked tasks are grouped by (type, tenant)
+// so other types and tenants are not held up behind them.
+class RateLimitScheduler : public SchedulerDecorator {
+public:
+    RateLimitScheduler(std::shared_ptr<Scheduler> inner,
+                       const std::map<std::string, RateLimit>& typeLimits,
+                       const std::map<std::string, RateLimit>& tenantLimits = {});
+
+    void submit(Task task) override;
+    Task getNextTask() override;
+    std::optional<Task> tryGetNextTask() override;
+    bool empty() const override;
+    std::size_t size() const override;
+    std::vector<Task> drain() override;
+    bool cancel(int taskId) override;
+    bool reprioritize(int taskId, TaskPriority priority) override;
+
+    std::size_t getParkedCount() const;
+    std::uint64_t getThrottledCount() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Bucket {
+        RateLimit limit;
+        double tokens = 0.0;
+        Clock::time_point last;
+
+        void refill(Clock::time_point now);
+        Clock::duration timeUntilToken() const;
+    };
+
+    struct Lane {
+        Bucket* typeBucket = nullptr;
+        Bucket* tenantBucket = nullptr;
+        std::deque<Task> parked;
+    };
+
+    static Bucket* findBucket(std::map<std::string, Bucket>& buckets, const std::string& key);
+    static bool tryAcquire(Lane& lane, Clock::time_point now);
+    static Clock::duration laneWait(Lane& lane, Clock::time_point now);
+    void releaseParked(Clock::time_point now);
+
+    mutable std::mutex mtx;
+    std::map<std::string, Bucket> typeBuckets;
+    std::map<std::string, Bucket> tenantBuckets;
+    std::map<std::pair<std::string, std::string>, Lane> lanes;  // (type, tenant)
+    std::size_t parkedCount = 0;
+    std::uint64_t throttled = 0;
+    Clock::time_point nextRelease{};  // earliest time a parked task can get a token
+};
@@ -2,14 +2,23 @@
 
 void RoundRobinScheduler::submit(Task task) {
     std::lock_guard<std::mutex> lock(queueMutex);
-    taskQueue.push(std::move(task));
+    taskQueue.push_back(std::move(task));
 }
 
 Task RoundRobinScheduler::getNextTask() {
     std::lock_guard<std::mutex> lock(queueMutex);
 
     Task task = std::move(taskQueue.front());
-    taskQueue.pop();
+    taskQueue.pop_front();
+    return task;
+}
+
+std::optional<Task> RoundRobinScheduler::tryGetNextTask() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (taskQueue.empty())
+        return std::nullopt;
+    Task task = std::move(taskQueue.front());
+    taskQueue.pop_front();
     return task;
 }
 
@@ -17,3 +26,66 @@ bool RoundRobinScheduler::empty() const {
     std::lock_guard<std::mutex> lock(queueMutex);
     return taskQueue.empty();
 }
+
+std::vector<Task> RoundRobinScheduler::drain() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    std::vector<Task> tasks;
+    tasks.reserve(taskQueue.size());
+    while (!taskQueue.empty()) {
+        tasks.push_back(std::move(taskQueue.front()));
+        taskQueue.pop_front();
+    }
+    return tasks;
+}
+
+std::size_t RoundRobinScheduler::size() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return taskQueue.size();
+}
+
+// Linear scan: order here ignores priority, so there is no index to keep
+bool RoundRobinScheduler::cancel(int taskId) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    bool found = false;
+    for (auto it = taskQueue.begin(); it != taskQueue.end();) {
+        if (it->getId() == taskId) {
+            it->markCancelled();
+            it = taskQueue.erase(it);
+            found = true;
+        } else {
+            ++it;
+        }
+    }
+    return found;
+}
+
+// Keeps the task's place; the new priority matters if it moves to another policy
+bool RoundRobinScheduler::reprioritize(int taskId, TaskPriority priority) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    bool found = false;
+    for (auto& task : taskQueue) {
+        if (task.getId() == taskId) {
+            task.setPriority(priority);
+            found = true;
+        }
+    }
+    return found;
+}
+
+// Lowest priority first, then the oldest (front-most) of that priority
+std::optional<Task> RoundRobinScheduler::takeShedCandidate(TaskPriority atMost) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    auto victim = taskQueue.end();
+    for (auto it = taskQueue.begin(); it != taskQueue.end(); ++it) {
+        if (!it->isSheddable() || static_cast<int>(it->getPriority()) > static_cast<int>(atMost))
+            continue;
+        if (victim == taskQueue.end() ||
+            static_cast<int>(it->getPriority()) < static_cast<int>(victim->getPriority()))
+            victim = it;
+    }
+    if (victim == taskQueue.end())
+        return std::nullopt;
+    Task task = std::move(*victim);
+    taskQueue.erase(victim);
+    return task;
+}
@@ -1,16 +1,22 @@
 #pragma once
 
 #include "Scheduler.h"
-#include <queue>
+#include <deque>
 #include <mutex>
 
 class RoundRobinScheduler : public Scheduler {
 private:
-    std::queue<Task> taskQueue;
+    std::deque<Task> taskQueue;
     mutable std::mutex queueMutex;
 
 public:
     void submit(Task task) override;
     Task getNextTask() override;
+    std::optional<Task> tryGetNextTask() override;
     bool empty() const override;
+    std::size_t size() const override;
+    std::vector<Task> drain() override;
+    bool cancel(int taskId) override;
+    bool reprioritize(int taskId, TaskPriority priority) override;
+    std::optional<Task> takeShedCandidate(TaskPriority atMost) override;
 };
@@ -0,0 +1,58 @@
+#include "SJFScheduler.h"
+#include "../../utils/RuntimeEstimator.h"
+
+#include <stdexcept>
+
+SJFScheduler::SJFScheduler(double agingRate)
+    : agingRate(agingRate > 0.0 ? agingRate : 0.1) {}
+
+void SJFScheduler::submit(Task task) {
+    const auto expected = RuntimeEstimator::instance().estimate(task);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    task.markReady();
+
+    auto credit = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::chrono::steady_clock::period>(
+            static_cast<double>(expected.count()) / agingRate));
+    auto key = task.getEnqueueTime() + credit;
+    TaskPriority priority = task.getPriority();
+    pq.push(Entry{key, priority, nextSeq++, std::move(task)});
+}
+
+Task SJFScheduler::getNextTask() {
+    std::optional<Task> task = tryGetNextTask();
+    if (!task)
+        throw std::runtime_error("SJFScheduler: no task available");
+    return std::move(*task);
+}
+
+std::optional<Task> SJFScheduler::tryGetNextTask() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (pq.empty())
+        return std::nullopt;
+    Task task = pq.top().task;
+    pq.pop();
+    return task;
+}
+
+bool SJFScheduler::empty() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return pq.empty();
+}
+
+std::vector<Task> SJFScheduler::drain() {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<Task> tasks;
+    tasks.reserve(pq.size());
+    while (!pq.empty()) {
+        tasks.push_back(pq.top().task);
+        pq.pop();
+    }
+    return tasks;
+}
+
+std::size_t SJFScheduler::size() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return pq.size();
+}
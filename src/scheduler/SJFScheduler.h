@@ -0,0 +1,47 @@
+#pragma once
+#include "Scheduler.h"
+#include <queue>
+#include <mutex>
+#include <cstdint>
+
+// Shortest-expected-job-first scheduler.
+// Expected runtime comes from RuntimeEstimator at submit time. To keep long
+// jobs from starving, a waiting task's effective runtime shrinks by
+// agingRate ms for every ms it waits. Ordering by
+// "expected - waited * agingRate" is the same as ordering by the static key
+// "enqueueTime + expected / agingRate", so aging needs no rescans.
+class SJFScheduler : public Scheduler {
+public:
+    explicit SJFScheduler(double agingRate = 0.1);
+
+    void submit(Task task) override;
+    Task getNextTask() override;
+    std::optional<Task> tryGetNextTask() override;
+    bool empty() const override;
+    std::size_t size() const override;
+    std::vector<Task> drain() override;
+
+private:
+    struct Entry {
+        std::chrono::steady_clock::time_point key;
+        TaskPriority priority;
+        std::uint64_t seq;
+        Task task;
+    };
+
+    struct EntryComparator {
+        bool operator()(const Entry& a, const Entry& b) const {
+            if (a.key != b.key)
+                return a.key > b.key;
+            if (a.priority != b.priority)
+                return static_cast<int>(a.priority) < static_cast<int>(b.priority);
+            return a.seq > b.seq;
+        }
+    };
+
+    double agingRate;
+
+    mutable std::mutex mtx;
+    std::priority_queue<Entry, std::vector<Entry>, EntryComparator> pq;
+    std::uint64_t nextSeq = 0;
+};
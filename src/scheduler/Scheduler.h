@@ -1,10 +1,56 @@
 #pragma once
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include "../core/Task.h"
 
+class ConcurrencySlots;
+
 class Scheduler {
 public:
     virtual void submit(Task task) = 0;
     virtual Task getNextTask() = 0;
     virtual bool empty() const = 0;
+
+    // Tasks held (queued or parked), for depth metrics
+    virtual std::size_t size() const = 0;
+
+    // Atomically check-and-pop; returns nullopt when nothing is runnable.
+    // Workers use this so two threads never race on the same last task.
+    virtual std::optional<Task> tryGetNextTask() {
+        if (empty())
+            return std::nullopt;
+        return getNextTask();
+    }
+
+    // Called by the executor after every execution attempt of a task
+    // obtained from this scheduler (successful or not)
+    virtual void onTaskFinished(const Task& /* task */) {}
+
+    // Remove and return every queued task, without running or dropping any,
+    // so they can be moved to another scheduler
+    virtual std::vector<Task> drain() = 0;
+
+    // Withdraw every queued task with this id so it never runs. False if
+    // none is queued here, or the policy cannot remove tasks.
+    virtual bool cancel(int /* taskId */) { return false; }
+
+    // Change the priority of queued tasks with this id in place. False if
+    // none is queued here, or the policy cannot reorder tasks.
+    virtual bool reprioritize(int /* taskId */, TaskPriority /* priority */) { return false; }
+
+    // Remove and return the queued task overload control should shed first:
+    // the lowest-priority sheddable one no higher than atMost, oldest first
+    // within a priority. nullopt if none, or the policy cannot pick one out.
+    virtual std::optional<Task> takeShedCandidate(TaskPriority /* atMost */) { return std::nullopt; }
+
+    // Called on a replacement before the scheduler it replaces is drained
+    // into it, to carry over state that outlives the swap
+    virtual void takeOver(Scheduler& /* previous */) {}
+
+    // Slot table of the concurrency limiter in this scheduler, if any
+    virtual std::shared_ptr<ConcurrencySlots> getConcurrencySlots() { return nullptr; }
+
     virtual ~Scheduler() = default;
 };
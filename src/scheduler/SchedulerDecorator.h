@@ -0,0 +1,60 @@
+#pragma once
+#include "Scheduler.h"
+#include <deque>
+#include <memory>
+
+// Base for schedulers that add a policy on top of another scheduler.
+// Everything is forwarded to the wrapped scheduler by default.
+class SchedulerDecorator : public Scheduler {
+public:
+    explicit SchedulerDecorator(std::shared_ptr<Scheduler> inner)
+        : inner(std::move(inner)) {}
+
+    void submit(Task task) override { inner->submit(std::move(task)); }
+    Task getNextTask() override { return inner->getNextTask(); }
+    std::optional<Task> tryGetNextTask() override { return inner->tryGetNextTask(); }
+    bool empty() const override { return inner->empty(); }
+    std::size_t size() const override { return inner->size(); }
+    void onTaskFinished(const Task& task) override { inner->onTaskFinished(task); }
+    std::vector<Task> drain() override { return inner->drain(); }
+    bool cancel(int taskId) override { return inner->cancel(taskId); }
+    bool reprioritize(int taskId, TaskPriority priority) override {
+        return inner->reprioritize(taskId, priority);
+    }
+    std::optional<Task> takeShedCandidate(TaskPriority atMost) override {
+        return inner->takeShedCandidate(atMost);
+    }
+    void takeOver(Scheduler& previous) override { inner->takeOver(previous); }
+    std::shared_ptr<ConcurrencySlots> getConcurrencySlots() override {
+        return inner->getConcurrencySlots();
+    }
+
+protected:
+    // For decorators that hold tasks aside: linear, side queues are short
+    static std::size_t cancelIn(std::deque<Task>& tasks, int taskId) {
+        std::size_t removed = 0;
+        for (auto it = tasks.begin(); it != tasks.end();) {
+            if (it->getId() == taskId) {
+                it->markCancelled();
+                it = tasks.erase(it);
+                ++removed;
+            } else {
+                ++it;
+            }
+        }
+        return removed;
+    }
+
+    static bool reprioritizeIn(std::deque<Task>& tasks, int taskId, TaskPriority priority) {
+        bool found = false;
+        for (auto& task : tasks) {
+            if (task.getId() == taskId) {
+                task.setPriority(priority);
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    std::shared_ptr<Scheduler> inner;
+};
@@ -0,0 +1,99 @@
+#include "SchedulerFactory.h"
+#include "PriorityScheduler.h"
+#include "RoundRobinScheduler.h"
+#include "EDFScheduler.h"
+#include "MLFQScheduler.h"
+#include "SJFScheduler.h"
+#include "CoDelScheduler.h"
+#include "RateLimitScheduler.h"
+#include "ConcurrencyLimitScheduler.h"
+#include "CircuitBreakerScheduler.h"
+
+#include <sstream>
+
+std::shared_ptr<Scheduler> SchedulerFactory::createPolicy(const Config& cfg) {
+    return createPolicy(cfg, cfg.getScheduler());
+}
+
+std::shared_ptr<Scheduler> SchedulerFactory::create(const Config& cfg) {
+    return create(cfg, cfg.getScheduler());
+}
+
+std::string SchedulerFactory::describe(const Config& cfg) {
+    return describe(cfg, cfg.getScheduler());
+}
+
+std::shared_ptr<Scheduler> SchedulerFactory::createPolicy(const Config& cfg, const std::string& policy) {
+    if (policy == "priority") {
+        return std::make_shared<PriorityScheduler>();
+    }
+    if (policy == "edf") {
+        return std::make_shared<EDFScheduler>(
+            cfg.getEdfMissPolicy() == "drop" ? DeadlineMissPolicy::DROP
+                                             : DeadlineMissPolicy::DEMOTE);
+    }
+    if (policy == "mlfq") {
+        return std::make_shared<MLFQScheduler>(
+            std::chrono::milliseconds(cfg.getMlfqAgingMs()),
+            std::chrono::milliseconds(cfg.getMlfqLongRunMs()));
+    }
+    if (policy == "sjf") {
+        return std::make_shared<SJFScheduler>(cfg.getSjfAgingRate());
+    }
+    return std::make_shared<RoundRobinScheduler>();
+}
+
+std::shared_ptr<Scheduler> SchedulerFactory::create(const Config& cfg, const std::string& policy) {
+    std::shared_ptr<Scheduler> scheduler = createPolicy(cfg, policy);
+    if (cfg.isCodelEnabled()) {
+        scheduler = std::make_shared<CoDelScheduler>(
+            scheduler,
+            std::chrono::milliseconds(cfg.getCodelTargetMs()),
+            std::chrono::milliseconds(cfg.getCodelIntervalMs()),
+            cfg.isCodelDrainGuard());
+    }
+    // Tasks held by an open breaker never reach CoDel's sojourn check or take
+    // a concurrency slot
+    if (cfg.getCircuitBreaker().enabled) {
+        scheduler = std::make_shared<CircuitBreakerScheduler>(scheduler);
+    }
+    // Outside CoDel, so a task shed at dequeue never holds a concurrency slot
+    scheduler = std::make_shared<ConcurrencyLimitScheduler>(scheduler);
+    // Outermost, so tasks held back by a rate limit are not seen as queueing delay
+    if (!cfg.getTypeRateLimits().empty() || !cfg.getTenantRateLimits().empty()) {
+        scheduler = std::make_shared<RateLimitScheduler>(
+            scheduler, cfg.getTypeRateLimits(), cfg.getTenantRateLimits());
+    }
+    return scheduler;
+}
+
+std::string SchedulerFactory::describe(const Config& cfg, const std::string& policy) {
+    std::ostringstream out;
+    out << policy;
+    if (policy == "edf") {
+        out << " miss=" << cfg.getEdfMissPolicy();
+    } else if (policy == "mlfq") {
+        out << " aging=" << cfg.getMlfqAgingMs() << "ms long_run=" << cfg.getMlfqLongRunMs() << "ms";
+    } else if (policy == "sjf") {
+        out << " aging_rate=" << cfg.getSjfAgingRate();
+    }
+    if (cfg.isCodelEnabled()) {
+        out << " codel=" << cfg.getCodelTargetMs() << "/" << cfg.getCodelIntervalMs() << "ms";
+        if (cfg.isCodelDrainGuard()) {
+            out << " drain_guard";
+        }
+    }
+    const CircuitBreakerConfig& breaker = cfg.getCircuitBreaker();
+    if (breaker.enabled) {
+        out << " circuit_breaker=" << breaker.failureRate << "/" << breaker.window
+            << " min=" << breaker.minCalls << " open=" << breaker.openMs << "ms"
+            << " probes=" << breaker.probes << (breaker.failFast ? " fail" : " park");
+    }
+    for (const auto& [type, limit] : cfg.getTypeRateLimits()) {
+        out << " rate_limit.type." << type << "=" << limit.rate << "," << limit.burst;
+    }
+    for (const auto& [tenant, limit] : cfg.getTenantRateLimits()) {
+        out << " rate_limit.tenant." << tenant << "=" << limit.rate << "," << limit.burst;
+    }
+    return out.str();
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <memory>
+#include <string>
+
+#include "Scheduler.h"
+#include "../../utils/Config.h"
+
+// Builds the scheduler stack selected by config: the policy (priority,
+// roundrobin, edf, mlfq, sjf) wrapped by the configured controls
+class SchedulerFactory {
+public:
+    static std::shared_ptr<Scheduler> create(const Config& cfg);
+    static std::shared_ptr<Scheduler> createPolicy(const Config& cfg);
+
+    // Same, with the policy given by name (e.g. a named queue's scheduler)
+    static std::shared_ptr<Scheduler> create(const Config& cfg, const std::string& policy);
+    static std::shared_ptr<Scheduler> createPolicy(const Config& cfg, const std::string& policy);
+
+    // Settings that shape the stack; equal strings mean an equivalent stack
+    static std::string describe(const Config& cfg);
+    static std::string describe(const Config& cfg, const std::string& policy);
+};
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include "../utils/Histogram.h"
+#include "../utils/Metrics.h"
+#include "../utils/RateWindow.h"
+#include "../src/core/Task.h"
+#include "../api/PrometheusExporter.h"
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class HistogramTest : public ::testing::Test {};
+
+// Test Bucket Layout - Exact Below 64, Then Within 1/32 Relative Error
+TEST_F(HistogramTest, BucketBoundsAreTight) {
+    for (std::uint64_t v = 0; v < 64; v++) {
+        EXPECT_EQ(Histogram::bucketUpperBound(Histogram::bucketFor(v)), v);
+    }
+    std::size_t previous = Histogram::bucketFor(63);
+    for (std::uint64_t v = 64; v < (1ULL << 22); v = v * 9 / 8 + 1) {
+        std::size_t bucket = Histogram::bucketFor(v);
+        EXPECT_GE(bucket, previous);
+        std::uint64_t upper = Histogram::bucketUpperBound(bucket);
+        EXPECT_GE(upper, v);
+        EXPECT_LE(static_cast<double>(upper - v), v / 32.0);
+        previous = bucket;
+    }
+    EXPECT_EQ(Histogram::bucketFor(Histogram::MAX_VALUE * 4), Histogram::BUCKETS - 1);
+}
+
+// Test Percentiles Of A Uniform Distribution
+TEST_F(HistogramTest, Percentiles) {
+    Histogram histogram;
+    for (std::uint64_t v = 1; v <= 10000; v++) {
+        histogram.record(v);
+    }
+    HistogramSnapshot snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 10000u);
+    EXPECT_EQ(snapshot.max, 10000u);
+    EXPECT_NEAR(snapshot.mean(), 5000.5, 0.01);
+    EXPECT_NEAR(static_cast<double>(snapshot.percentile(0.50)), 5000.0, 5000.0 / 32);
+    EXPECT_NEAR(static_cast<double>(snapshot.percentile(0.99)), 9900.0, 9900.0 / 32);
+    EXPECT_EQ(snapshot.percentile(1.0), 10000u);
+    EXPECT_EQ(HistogramSnapshot().percentile(0.5), 0u);
+    
+    // Merging two halves matches recording everything in one
+    Histogram low, high;
+    for (std::uint64_t v = 1; v <= 10000; v++) {
+        (v <= 5000 ? low : high).record(v);
+    }
+    HistogramSnapshot merged = low.snapshot();
+    merged.merge(high.snapshot());
+    EXPECT_EQ(merged.count, snapshot.count);
+    EXPECT_EQ(merged.percentile(0.999), snapshot.percentile(0.999));
+}
+
+// Test Latency Report - Per-Thread Shards Merge By Priority And Type
+TEST_F(HistogramTest, LatencyReportMergesThreads) {
+    const LatencyReport before = Metrics::instance().getLatencyReport();
+    
+    auto runTasks = [](TaskPriority priority, const std::string& type, int count) {
+        for (int i = 0; i < count; i++) {
+            Task task(i + 1, priority, []() {}, 0);
+            task.setType(type);
+            task.markReady();
+            task.execute();
+            Metrics::instance().recordTask(task);
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.emplace_back(runTasks, TaskPriority::HIGH, "histogram-a", 30);
+    threads.emplace_back(runTasks, TaskPriority::LOW, "histogram-b", 20);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    // Shards of exited threads stay in the report
+    runTasks(TaskPriority::HIGH, "histogram-b", 5);
+    
+    const LatencyReport after = Metrics::instance().getLatencyReport();
+    EXPECT_EQ(after.overall.exec.count - before.overall.exec.count, 55u);
+    EXPECT_EQ(after.byType.at("histogram-a").endToEnd.count, 30u);
+    EXPECT_EQ(after.byType.at("histogram-b").wait.count, 25u);
+    auto highBefore = before.byPriority.count("HIGH") ? before.byPriority.at("HIGH").exec.count : 0;
+    EXPECT_EQ(after.byPriority.at("HIGH").exec.count - highBefore, 35u);
+}
+
+// Test Prometheus Exposition - Cumulative Buckets, Labels And Buffer Reuse
+TEST_F(HistogramTest, PrometheusExposition) {
+    Histogram histogram;
+    histogram.record(700);      // le 0.001
+    histogram.record(3000);     // le 0.005
+    histogram.record(20000000); // above the last bound
+    std::array<std::uint64_t, PrometheusExporter::BOUNDS + 1> perBound{};
+    std::uint64_t count = 0, sum = 0;
+    histogram.accumulate(PrometheusExporter::BOUNDS_MICROS.data(), PrometheusExporter::BOUNDS,
+                         perBound.data(), count, sum);
+    EXPECT_EQ(perBound[1], 1u);
+    EXPECT_EQ(perBound[3], 1u);
+    EXPECT_EQ(perBound[PrometheusExporter::BOUNDS], 1u);
+    EXPECT_EQ(count, 3u);
+    EXPECT_EQ(sum, 20003700u);
+    
+    for (int i = 0; i < 4; i++) {
+        Task task(i + 1, TaskPriority::LOW, []() {}, 0);
+        task.setType("prom\"quoted");
+        task.markReady();
+        task.execute();
+        Metrics::instance().recordTask(task);
+    }
+    
+    auto pool = std::make_shared<ThreadPool>(2);
+    QueueRegistry queues(pool);
+    PrometheusExporter exporter;
+    const std::string& text = exporter.render(queues);
+    EXPECT_NE(text.find("# TYPE taskweave_tasks_executed_total counter\n"), std::string::npos);
+    EXPECT_NE(text.find("taskweave_pool_workers{queue=\"default\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("taskweave_pool_busy_workers{queue=\"default\"} 0\n"), std::string::npos);
+    EXPECT_NE(text.find("taskweave_registry_tasks{state=\"running\"} "), std::string::npos);
+    EXPECT_NE(text.find("# TYPE taskweave_task_exec_seconds histogram\n"), std::string::npos);
+    EXPECT_NE(text.find("taskweave_task_exec_seconds_bucket{type=\"prom\\\"quoted\",tenant=\"\",priority=\"LOW\",le=\"+Inf\"} 4\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("taskweave_task_exec_seconds_count{type=\"prom\\\"quoted\",tenant=\"\",priority=\"LOW\"} 4\n"),
+              std::string::npos);
+    
+    // A repeat scrape renders into the same storage
+    const char* storage = text.data();
+    const std::string& again = exporter.render(queues);
+    EXPECT_EQ(again.data(), storage);
+}
+
+// Test Key Breakdown - Per Type, Tenant And Priority Outcomes
+TEST_F(HistogramTest, KeyBreakdownByTypeTenantPriority) {
+    const MetricsKey* key = Metrics::instance().resolveKey("breakdown", "acme");
+    EXPECT_EQ(Metrics::instance().resolveKey("breakdown", "acme"), key);
+    EXPECT_NE(Metrics::instance().resolveKey("breakdown", "globex"), key);
+    
+    for (int i = 0; i < 3; i++) {
+        Task task(i + 1, TaskPriority::HIGH, []() {}, 0);
+        task.setType("breakdown");
+        task.setTenant("acme");
+        task.setMetricsKey(key);
+        task.markReady();
+        task.execute();
+        Metrics::instance().recordTask(task);
+    }
+    // Fails twice: one retry, then final failure
+    Task failing(9, TaskPriority::LOW, []() { throw std::runtime_error("boom"); }, 1);
+    failing.setType("breakdown");
+    failing.setTenant("acme");
+    failing.markReady();
+    EXPECT_THROW(failing.execute(), std::runtime_error);
+    failing.markRetry();
+    EXPECT_THROW(failing.execute(), std::runtime_error);
+    failing.markFailed();
+    Metrics::instance().recordTask(failing);
+    
+    const KeyBreakdown breakdown = Metrics::instance().getKeyBreakdown();
+    const KeyMetrics* high = nullptr;
+    const KeyMetrics* low = nullptr;
+    for (const auto& metrics : breakdown.keys) {
+        if (metrics.type == "breakdown" && metrics.tenant == "acme") {
+            (metrics.priority == TaskPriority::HIGH ? high : low) = &metrics;
+        }
+    }
+    ASSERT_NE(high, nullptr);
+    ASSERT_NE(low, nullptr);
+    EXPECT_EQ(high->completed, 3u);
+    EXPECT_EQ(high->latency.exec.count, 3u);
+    EXPECT_EQ(low->failed, 1u);
+    EXPECT_EQ(low->retries, 1u);
+}
+
+// Test Cardinality Cap - New Keys Past The Limit Share The Overflow Key
+TEST_F(HistogramTest, KeyCardinalityCap) {
+    Metrics& metrics = Metrics::instance();
+    metrics.setMaxKeys(metrics.getKeyBreakdown().distinctKeys + 1);
+    
+    const MetricsKey* admitted = metrics.resolveKey("cap-a", "");
+    EXPECT_EQ(admitted->type, "cap-a");
+    const std::uint64_t overflowedBefore = metrics.getKeyBreakdown().overflowed;
+    const MetricsKey* folded = metrics.resolveKey("cap-b", "");
+    EXPECT_EQ(folded->type, Metrics::OVERFLOW_LABEL);
+    EXPECT_EQ(metrics.resolveKey("cap-c", "x"), folded);
+    EXPECT_EQ(metrics.resolveKey("cap-a", ""), admitted);
+    EXPECT_EQ(metrics.getKeyBreakdown().overflowed - overflowedBefore, 2u);
+    
+    metrics.setMaxKeys(1000);
+}
+
+// Test Rate Window - Counts Slide Out And Reused Buckets Restart
+TEST_F(HistogramTest, RateWindowSlides) {
+    using std::chrono::seconds;
+    const auto origin = RateWindow::Clock::now();
+    RateWindow window(seconds(1), 10, origin);
+    
+    for (int s = 0; s < 5; s++) {
+        window.add(10, origin + seconds(s));
+    }
+    EXPECT_EQ(window.count(seconds(5), origin + seconds(4)), 50u);
+    EXPECT_EQ(window.count(seconds(2), origin + seconds(4)), 20u);
+    // Five seconds of history so far: the rate is not diluted to 10 s
+    EXPECT_NEAR(window.rate(seconds(10), origin + seconds(5)), 10.0, 0.01);
+    
+    // A lap later the old buckets have expired and are restarted on use
+    EXPECT_EQ(window.count(seconds(10), origin + seconds(14)), 0u);
+    window.add(3, origin + seconds(12));
+    EXPECT_EQ(window.count(seconds(10), origin + seconds(14)), 3u);
+    
+    // Concurrent adds into one bucket are not lost
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&window, origin]() {
+            for (int i = 0; i < 1000; i++) {
+                window.add(1, origin + seconds(13));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(window.count(seconds(1), origin + seconds(13)), 4000u);
+}
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include "../core/CronExpression.h"
+#include "../core/TaskDefinition.h"
+#include "../src/executor/RecurringJobs.h"
+#include "../src/executor/ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <thread>
+
+using namespace std::chrono;
+
+class RecurringTest : public ::testing::Test {
+protected:
+    // Local time -> system_clock, so cron results can be checked field by field
+    static system_clock::time_point localTime(int year, int month, int day, int hour, int minute) {
+        std::tm tm{};
+        tm.tm_year = year - 1900;
+        tm.tm_mon = month - 1;
+        tm.tm_mday = day;
+        tm.tm_hour = hour;
+        tm.tm_min = minute;
+        tm.tm_isdst = -1;
+        return system_clock::from_time_t(std::mktime(&tm));
+    }
+    
+    static std::tm toLocal(system_clock::time_point tp) {
+        std::time_t t = system_clock::to_time_t(tp);
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &t);
+#else
+        localtime_r(&t, &tm);
+#endif
+        return tm;
+    }
+    
+    static TaskDefinition sleepJob(int id, long long everyMs, int sleepMs, const std::string& overlap) {
+        TaskDefinition def;
+        def.id = id;
+        def.name = "Recurring " + std::to_string(id);
+        def.type = "sleep";
+        def.params["duration_ms"] = std::to_string(sleepMs);
+        def.everyMs = everyMs;
+        def.overlap = overlap;
+        return def;
+    }
+};
+
+// Test Cron Expression Parsing
+TEST_F(RecurringTest, CronParse) {
+    EXPECT_TRUE(CronExpression::parse("* * * * *").has_value());
+    EXPECT_TRUE(CronExpression::parse("*/5 9-17 * * 1-5").has_value());
+    EXPECT_TRUE(CronExpression::parse("0,30 0 1 1,6 7").has_value());
+    
+    EXPECT_FALSE(CronExpression::parse("").has_value());
+    EXPECT_FALSE(CronExpression::parse("* * * *").has_value());
+    EXPECT_FALSE(CronExpression::parse("60 * * * *").has_value());
+    EXPECT_FALSE(CronExpression::parse("*/0 * * * *").has_value());
+    EXPECT_FALSE(CronExpression::parse("5-1 * * * *").has_value());
+    EXPECT_FALSE(CronExpression::parse("a * * * *").has_value());
+}
+
+// Test Cron Next Occurrence
+TEST_F(RecurringTest, CronNext) {
+    auto every15 = CronExpression::parse("*/15 * * * *");
+    ASSERT_TRUE(every15.has_value());
+    auto next = every15->next(localTime(2030, 3, 10, 10, 7));
+    ASSERT_TRUE(next.has_value());
+    std::tm tm = toLocal(*next);
+    EXPECT_EQ(tm.tm_hour, 10);
+    EXPECT_EQ(tm.tm_min, 15);
+    
+    // Strictly after: a matching minute is not returned again
+    next = every15->next(localTime(2030, 3, 10, 10, 15));
+    tm = toLocal(*next);
+    EXPECT_EQ(tm.tm_min, 30);
+    
+    // Weekday 9:00 from a Saturday lands on Monday
+    auto weekdays = CronExpression::parse("0 9 * * 1-5");
+    next = weekdays->next(localTime(2030, 3, 9, 12, 0));
+    ASSERT_TRUE(next.has_value());
+    tm = toLocal(*next);
+    EXPECT_EQ(tm.tm_wday, 1);
+    EXPECT_EQ(tm.tm_mday, 11);
+    EXPECT_EQ(tm.tm_hour, 9);
+    
+    // "*/1" day-of-month is unrestricted: only Mondays match, not every day
+    auto mondays = CronExpression::parse("0 0 */1 * 1");
+    next = mondays->next(localTime(2030, 3, 9, 12, 0));
+    ASSERT_TRUE(next.has_value());
+    tm = toLocal(*next);
+    EXPECT_EQ(tm.tm_wday, 1);
+    EXPECT_EQ(tm.tm_mday, 11);
+    
+    // Impossible date never matches
+    auto never = CronExpression::parse("0 0 31 2 *");
+    EXPECT_FALSE(never->next(localTime(2030, 1, 1, 0, 0)).has_value());
+}
+
+// Test Interval Job Runs Repeatedly And Rolls Up Stats
+TEST_F(RecurringTest, IntervalJobRuns) {
+    auto pool = std::make_shared<ThreadPool>(2);
+    RecurringJobManager manager(pool);
+    
+    std::string error;
+    ASSERT_TRUE(manager.add(sleepJob(1, 20, 1, "skip"), error)) << error;
+    EXPECT_FALSE(manager.add(sleepJob(1, 20, 1, "skip"), error));
+    
+    std::this_thread::sleep_for(milliseconds(250));
+    auto stats = manager.get(1)->getStats();
+    manager.cancelAll();
+    pool->shutdown();
+    
+    EXPECT_GE(stats.completed, 5u);
+    EXPECT_EQ(stats.failed, 0u);
+    EXPECT_EQ(stats.skippedOverlap, 0u);
+    EXPECT_GT(stats.totalExecMs, 0.0);
+}
+
+// Test Skip Overlap Drops Occurrences While One Is Running
+TEST_F(RecurringTest, OverlapSkip) {
+    auto pool = std::make_shared<ThreadPool>(4);
+    RecurringJobManager manager(pool);
+    
+    std::string error;
+    ASSERT_TRUE(manager.add(sleepJob(1, 20, 120, "skip"), error));
+    ASSERT_TRUE(manager.add(sleepJob(2, 20, 120, "queue"), error));
+    
+    std::this_thread::sleep_for(milliseconds(300));
+    auto skip = manager.get(1)->getStats();
+    auto queue = manager.get(2)->getStats();
+    manager.cancelAll();
+    pool->shutdown();
+    
+    // Never more than one occurrence of either job in flight
+    EXPECT_LE(skip.inFlight, 1u);
+    EXPECT_LE(queue.inFlight, 1u);
+    EXPECT_GT(skip.skippedOverlap, 0u);
+    EXPECT_EQ(queue.skippedOverlap, 0u);
+    EXPECT_GT(queue.queued, 0u);
+}
+
+// Test A Cancelled Occurrence Settles, So Skip Overlap Releases The Next One
+TEST_F(RecurringTest, CancelledOccurrenceSettles) {
+    auto pool = std::make_shared<ThreadPool>(1);
+    RecurringJobManager manager(pool);
+    
+    // Hold the only worker so the first occurrence stays queued
+    std::atomic<bool> hold{true};
+    pool->submit(Task(1000, TaskPriority::MEDIUM, [&hold]() {
+        while (hold) {
+            std::this_thread::sleep_for(milliseconds(1));
+        }
+    }, 0));
+    
+    std::string error;
+    ASSERT_TRUE(manager.add(sleepJob(77, 40, 1, "skip"), error)) << error;
+    std::this_thread::sleep_for(milliseconds(60));
+    EXPECT_TRUE(pool->cancel(77));
+    EXPECT_EQ(manager.get(77)->getStats().inFlight, 0u);
+    hold = false;
+    
+    std::this_thread::sleep_for(milliseconds(200));
+    auto stats = manager.get(77)->getStats();
+    manager.cancelAll();
+    pool->shutdown();
+    
+    EXPECT_EQ(stats.dropped, 1u);
+    EXPECT_GE(stats.completed, 2u);
+    EXPECT_EQ(stats.ran, stats.completed);
+}
+
+// Test Invalid Schedules Are Refused
+TEST_F(RecurringTest, InvalidSchedule) {
+    auto pool = std::make_shared<ThreadPool>(1);
+    RecurringJobManager manager(pool);
+    
+    TaskDefinition def;
+    def.id = 7;
+    def.cron = "not a cron";
+    std::string error;
+    EXPECT_FALSE(manager.add(def, error));
+    EXPECT_FALSE(error.empty());
+    
+    def.cron.clear();
+    EXPECT_FALSE(manager.add(def, error));
+    EXPECT_TRUE(manager.list().empty());
+    
+    pool->shutdown();
+}
@@ -1,7 +1,17 @@
 #include <gtest/gtest.h>
 #include "../src/scheduler/PriorityScheduler.h"
 #include "../src/scheduler/RoundRobinScheduler.h"
+#include "../src/scheduler/EDFScheduler.h"
+#include "../src/scheduler/MLFQScheduler.h"
+#include "../src/scheduler/SJFScheduler.h"
+#include "../src/scheduler/CoDelScheduler.h"
+#include "../src/scheduler/RateLimitScheduler.h"
+#include "../src/scheduler/ConcurrencyLimitScheduler.h"
+#include "../src/scheduler/CircuitBreakerScheduler.h"
+#include "../utils/RuntimeEstimator.h"
 #include "../src/core/Task.h"
+#include <atomic>
+#include <stdexcept>
 #include <thread>
 #include <chrono>
 #include <vector>
@@ -136,6 +146,50 @@ TEST_F(SchedulerTest, PrioritySchedulerThreadSafety) {
     EXPECT_EQ(count, numTasks);
 }
 
+// Test Priority Scheduler - Cancel Removes Queued Tasks Anywhere In The Heap
+TEST_F(SchedulerTest, PrioritySchedulerCancel) {
+    PriorityScheduler scheduler;
+    for (int i = 1; i <= 50; i++) {
+        scheduler.submit(Task(i, static_cast<TaskPriority>(i % 3), []() {}, 0));
+    }
+    // Recurring occurrences can share an id: both copies go
+    scheduler.submit(Task(7, TaskPriority::HIGH, []() {}, 0));
+
+    EXPECT_TRUE(scheduler.cancel(7));
+    EXPECT_TRUE(scheduler.cancel(30));
+    EXPECT_FALSE(scheduler.cancel(30));
+    EXPECT_FALSE(scheduler.cancel(999));
+    EXPECT_EQ(scheduler.size(), 48u);
+
+    // Order is intact and the cancelled tasks never come out
+    int last = static_cast<int>(TaskPriority::HIGH);
+    while (auto next = scheduler.tryGetNextTask()) {
+        EXPECT_NE(next->getId(), 7);
+        EXPECT_NE(next->getId(), 30);
+        EXPECT_LE(static_cast<int>(next->getPriority()), last);
+        last = static_cast<int>(next->getPriority());
+    }
+}
+
+// Test Priority Scheduler - Reprioritize Moves A Queued Task
+TEST_F(SchedulerTest, PrioritySchedulerReprioritize) {
+    PriorityScheduler scheduler;
+    for (int i = 1; i <= 5; i++) {
+        scheduler.submit(Task(i, TaskPriority::MEDIUM, []() {}, 0));
+    }
+    scheduler.submit(Task(6, TaskPriority::LOW, []() {}, 0));
+
+    EXPECT_TRUE(scheduler.reprioritize(6, TaskPriority::HIGH));
+    EXPECT_TRUE(scheduler.reprioritize(1, TaskPriority::LOW));
+    EXPECT_FALSE(scheduler.reprioritize(42, TaskPriority::HIGH));
+
+    std::vector<int> order;
+    while (auto next = scheduler.tryGetNextTask()) {
+        order.push_back(next->getId());
+    }
+    EXPECT_EQ(order, (std::vector<int>{6, 2, 3, 4, 5, 1}));
+}
+
 // ============================================================================
 // RoundRobinScheduler Tests
 // ============================================================================
@@ -263,3 +317,745 @@ TEST_F(SchedulerTest, RoundRobinVsPriorityDifferentBehavior) {
     Task roundRobinFirst = roundRobinScheduler.getNextTask();
     EXPECT_EQ(roundRobinFirst.getId(), 1); // First submitted
 }
+
+// ============================================================================
+// EDFScheduler Tests
+// ============================================================================
+
+// Test EDF Scheduler - Earliest Deadline First
+TEST_F(SchedulerTest, EDFSchedulerEarliestDeadlineFirst) {
+    EDFScheduler scheduler;
+    auto now = std::chrono::steady_clock::now();
+
+    Task late(1, TaskPriority::HIGH, []() {}, 0);
+    Task soon(2, TaskPriority::LOW, []() {}, 0);
+    Task middle(3, TaskPriority::MEDIUM, []() {}, 0);
+    late.setDeadline(now + std::chrono::seconds(30));
+    soon.setDeadline(now + std::chrono::seconds(10));
+    middle.setDeadline(now + std::chrono::seconds(20));
+
+    scheduler.submit(late);
+    scheduler.submit(soon);
+    scheduler.submit(middle);
+
+    // Deadline wins over priority
+    EXPECT_EQ(scheduler.getNextTask().getId(), 2);
+    EXPECT_EQ(scheduler.getNextTask().getId(), 3);
+    EXPECT_EQ(scheduler.getNextTask().getId(), 1);
+    EXPECT_TRUE(scheduler.empty());
+}
+
+// Test EDF Scheduler - Tasks Without Deadline Run After Deadline Tasks
+TEST_F(SchedulerTest, EDFSchedulerNoDeadlineAfterDeadline) {
+    EDFScheduler scheduler;
+
+    Task noDeadline(1, TaskPriority::HIGH, []() {}, 0);
+    Task withDeadline(2, TaskPriority::LOW, []() {}, 0);
+    withDeadline.setDeadline(std::chrono::steady_clock::now() + std::chrono::seconds(10));
+
+    scheduler.submit(noDeadline);
+    scheduler.submit(withDeadline);
+
+    EXPECT_EQ(scheduler.getNextTask().getId(), 2);
+    EXPECT_EQ(scheduler.getNextTask().getId(), 1);
+}
+
+// Test EDF Scheduler - Missed Deadline Is Demoted
+TEST_F(SchedulerTest, EDFSchedulerDemotesMissedDeadline) {
+    EDFScheduler scheduler(DeadlineMissPolicy::DEMOTE);
+    auto now = std::chrono::steady_clock::now();
+
+    Task missed(1, TaskPriority::HIGH, []() {}, 0);
+    Task noDeadline(2, TaskPriority::LOW, []() {}, 0);
+    Task feasible(3, TaskPriority::LOW, []() {}, 0);
+    missed.setDeadline(now - std::chrono::milliseconds(1));
+    feasible.setDeadline(now + std::chrono::seconds(10));
+
+    scheduler.submit(missed);
+    scheduler.submit(noDeadline);
+    scheduler.submit(feasible);
+
+    // Late work still runs, but only after everything that can still succeed
+    EXPECT_EQ(scheduler.getNextTask().getId(), 3);
+    EXPECT_EQ(scheduler.getNextTask().getId(), 2);
+    EXPECT_EQ(scheduler.getNextTask().getId(), 1);
+    EXPECT_TRUE(scheduler.empty());
+}
+
+// Test EDF Scheduler - Missed Deadline Is Dropped
+TEST_F(SchedulerTest, EDFSchedulerDropsMissedDeadline) {
+    EDFScheduler scheduler(DeadlineMissPolicy::DROP);
+
+    Task missed(1, TaskPriority::HIGH, []() {}, 0);
+    missed.setDeadline(std::chrono::steady_clock::now() - std::chrono::milliseconds(1));
+    scheduler.submit(missed);
+
+    EXPECT_TRUE(scheduler.empty());
+    EXPECT_FALSE(scheduler.tryGetNextTask().has_value());
+}
+
+// Test EDF Scheduler - Deadline Expires While Queued
+TEST_F(SchedulerTest, EDFSchedulerDropsDeadlineExpiredInQueue) {
+    EDFScheduler scheduler(DeadlineMissPolicy::DROP);
+
+    Task shortLived(1, TaskPriority::HIGH, []() {}, 0);
+    shortLived.setDeadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(5));
+    scheduler.submit(shortLived);
+    EXPECT_FALSE(scheduler.empty());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_FALSE(scheduler.tryGetNextTask().has_value());
+    EXPECT_TRUE(scheduler.empty());
+}
+
+// ============================================================================
+// MLFQScheduler Tests
+// ============================================================================
+
+// Test MLFQ Scheduler - Priority Order Without Aging
+TEST_F(SchedulerTest, MLFQSchedulerPriorityOrder) {
+    MLFQScheduler scheduler(std::chrono::seconds(60));
+
+    scheduler.submit(Task(1, TaskPriority::LOW, []() {}, 0));
+    scheduler.submit(Task(2, TaskPriority::HIGH, []() {}, 0));
+    scheduler.submit(Task(3, TaskPriority::MEDIUM, []() {}, 0));
+
+    EXPECT_EQ(scheduler.getNextTask().getId(), 2);
+    EXPECT_EQ(scheduler.getNextTask().getId(), 3);
+    EXPECT_EQ(scheduler.getNextTask().getId(), 1);
+    EXPECT_TRUE(scheduler.empty());
+}
+
+// Test MLFQ Scheduler - Waiting LOW Task Ages Past Fresh HIGH Task
+TEST_F(SchedulerTest, MLFQSchedulerAgingPreventsStarvation) {
+    MLFQScheduler scheduler(std::chrono::milliseconds(10));
+
+    scheduler.submit(Task(1, TaskPriority::LOW, []() {}, 0));
+    // Two levels of aging plus margin
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    scheduler.submit(Task(2, TaskPriority::HIGH, []() {}, 0));
+
+    EXPECT_EQ(scheduler.getNextTask().getId(), 1);
+    EXPECT_EQ(scheduler.getNextTask().getId(), 2);
+}
+
+// Test MLFQ Scheduler - Long-Running Types Are Demoted And Recover
+TEST_F(SchedulerTest, MLFQSchedulerDemotesLongRunningType) {
+    MLFQScheduler scheduler(std::chrono::seconds(60), std::chrono::milliseconds(5), 2);
+
+    auto runOnce = [&scheduler](int sleepMs) {
+        Task task(1, TaskPriority::HIGH, [sleepMs]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs));
+        }, 0);
+        task.setType("mlfq_slow");
+        task.markReady();
+        task.execute();
+        scheduler.onTaskFinished(task);
+    };
+
+    runOnce(10);
+    EXPECT_EQ(scheduler.getTypeDemotion("mlfq_slow"), 0);
+    runOnce(10);
+    EXPECT_EQ(scheduler.getTypeDemotion("mlfq_slow"), 1);
+
+    // Demoted HIGH task now ranks with MEDIUM and loses the FIFO tie
+    scheduler.submit(Task(10, TaskPriority::MEDIUM, []() {}, 0));
+    Task slow(11, TaskPriority::HIGH, []() {}, 0);
+    slow.setType("mlfq_slow");
+    scheduler.submit(slow);
+    EXPECT_EQ(scheduler.getNextTask().getId(), 10);
+    EXPECT_EQ(scheduler.getNextTask().getId(), 11);
+
+    runOnce(0);
+    runOnce(0);
+    EXPECT_EQ(scheduler.getTypeDemotion("mlfq_slow"), 0);
+}
+
+// ============================================================================
+// RuntimeEstimator / SJFScheduler Tests
+// ============================================================================
+
+// Test RuntimeEstimator - EWMA Mean And Variance
+TEST_F(SchedulerTest, RuntimeEstimatorEwma) {
+    RuntimeEstimator& estimator = RuntimeEstimator::instance();
+    estimator.clear();
+    estimator.configure(0.5, false);
+
+    estimator.record("est_type", 0, std::chrono::milliseconds(10));
+    RuntimeEstimate est = estimator.getEstimate("est_type");
+    EXPECT_EQ(est.samples, 1u);
+    EXPECT_DOUBLE_EQ(est.meanMs, 10.0);
+    EXPECT_DOUBLE_EQ(est.varianceMs2, 0.0);
+
+    estimator.record("est_type", 0, std::chrono::milliseconds(30));
+    est = estimator.getEstimate("est_type");
+    EXPECT_DOUBLE_EQ(est.meanMs, 20.0);
+    EXPECT_GT(est.varianceMs2, 0.0);
+
+    EXPECT_EQ(estimator.getEstimate("unknown_type").samples, 0u);
+    estimator.clear();
+}
+
+// Test RuntimeEstimator - Per-Params Estimates Override Type Once Warm
+TEST_F(SchedulerTest, RuntimeEstimatorPerParams) {
+    RuntimeEstimator& estimator = RuntimeEstimator::instance();
+    estimator.clear();
+    estimator.configure(1.0, true);
+
+    Task task(1, TaskPriority::MEDIUM, []() {}, 0);
+    task.setType("est_params");
+    task.setParamsHash(42);
+
+    estimator.record("est_params", 7, std::chrono::milliseconds(100));
+    estimator.record("est_params", 42, std::chrono::milliseconds(5));
+    // Not enough samples for hash 42 yet: falls back to the type (last sample, alpha=1)
+    EXPECT_EQ(estimator.estimate(task), std::chrono::milliseconds(5));
+
+    estimator.record("est_params", 7, std::chrono::milliseconds(100));
+    EXPECT_EQ(estimator.estimate(task), std::chrono::milliseconds(100));
+
+    estimator.record("est_params", 42, std::chrono::milliseconds(5));
+    estimator.record("est_params", 42, std::chrono::milliseconds(5));
+    EXPECT_EQ(estimator.estimate(task), std::chrono::milliseconds(5));
+
+    estimator.configure(0.2, false);
+    estimator.clear();
+}
+
+// Test SJF Scheduler - Shorter Expected Job First
+TEST_F(SchedulerTest, SJFSchedulerShortestFirst) {
+    RuntimeEstimator& estimator = RuntimeEstimator::instance();
+    estimator.clear();
+    estimator.record("sjf_long", 0, std::chrono::seconds(5));
+    estimator.record("sjf_short", 0, std::chrono::milliseconds(5));
+
+    SJFScheduler scheduler(0.1);
+    Task longTask(1, TaskPriority::HIGH, []() {}, 0);
+    Task shortTask(2, TaskPriority::LOW, []() {}, 0);
+    longTask.setType("sjf_long");
+    shortTask.setType("sjf_short");
+
+    scheduler.submit(longTask);
+    scheduler.submit(shortTask);
+
+    EXPECT_EQ(scheduler.getNextTask().getId(), 2);
+    EXPECT_EQ(scheduler.getNextTask().getId(), 1);
+    EXPECT_TRUE(scheduler.empty());
+    estimator.clear();
+}
+
+// Test SJF Scheduler - Aging Lets A Long Job Run Eventually
+TEST_F(SchedulerTest, SJFSchedulerAging) {
+    RuntimeEstimator& estimator = RuntimeEstimator::instance();
+    estimator.clear();
+    estimator.record("sjf_long", 0, std::chrono::milliseconds(20));
+    estimator.record("sjf_short", 0, std::chrono::milliseconds(1));
+
+    // Rate 1.0: every ms waited forgives 1 ms of expected runtime
+    SJFScheduler scheduler(1.0);
+    Task longTask(1, TaskPriority::MEDIUM, []() {}, 0);
+    longTask.setType("sjf_long");
+    scheduler.submit(longTask);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    Task shortTask(2, TaskPriority::MEDIUM, []() {}, 0);
+    shortTask.setType("sjf_short");
+    scheduler.submit(shortTask);
+
+    EXPECT_EQ(scheduler.getNextTask().getId(), 1);
+    estimator.clear();
+}
+
+// ============================================================================
+// CoDelScheduler Tests
+// ============================================================================
+
+// Test CoDel Scheduler - No Shedding While Sojourn Is Under Target
+TEST_F(SchedulerTest, CoDelSchedulerPassThroughUnderTarget) {
+    CoDelScheduler scheduler(std::make_shared<RoundRobinScheduler>(),
+                             std::chrono::seconds(10), std::chrono::milliseconds(1));
+
+    for (int i = 1; i <= 3; i++) {
+        Task task(i, TaskPriority::LOW, []() {}, 0);
+        task.setSheddable(true);
+        task.markReady();
+        scheduler.submit(task);
+    }
+
+    for (int i = 1; i <= 3; i++) {
+        EXPECT_EQ(scheduler.getNextTask().getId(), i);
+    }
+    EXPECT_EQ(scheduler.getRejectedCount(), 0u);
+}
+
+// Test CoDel Scheduler - Sheds After Sojourn Stays Above Target For An Interval
+TEST_F(SchedulerTest, CoDelSchedulerShedsWhenOverloaded) {
+    CoDelScheduler scheduler(std::make_shared<RoundRobinScheduler>(),
+                             std::chrono::milliseconds(1), std::chrono::milliseconds(5));
+
+    for (int i = 1; i <= 4; i++) {
+        Task task(i, TaskPriority::LOW, []() {}, 0);
+        task.setSheddable(true);
+        task.markReady();
+        scheduler.submit(task);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    // First dequeue above target only starts the interval
+    EXPECT_EQ(scheduler.getNextTask().getId(), 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    // Interval elapsed: task 2 is shed, task 3 is served
+    std::optional<Task> next = scheduler.tryGetNextTask();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->getId(), 3);
+    EXPECT_EQ(scheduler.getRejectedCount(), 1u);
+}
+
+// Test CoDel Scheduler - Drain Guard Holds Off While The Queue Shrinks
+TEST_F(SchedulerTest, CoDelSchedulerDrainGuard) {
+    CoDelScheduler scheduler(std::make_shared<RoundRobinScheduler>(),
+                             std::chrono::milliseconds(1), std::chrono::milliseconds(5), true);
+
+    for (int i = 1; i <= 4; i++) {
+        Task task(i, TaskPriority::LOW, []() {}, 0);
+        task.setSheddable(true);
+        task.markReady();
+        scheduler.submit(task);
+    }
+    // Arrivals age out of the drain window; only departures remain in it
+    std::this_thread::sleep_for(std::chrono::milliseconds(5 * CoDelScheduler::DRAIN_WINDOW + 20));
+
+    EXPECT_EQ(scheduler.getNextTask().getId(), 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    // Where CoDelSchedulerShedsWhenOverloaded sheds task 2, it is served
+    std::optional<Task> next = scheduler.tryGetNextTask();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->getId(), 2);
+    EXPECT_EQ(scheduler.getRejectedCount(), 0u);
+}
+
+// Test CoDel Scheduler - Sheds The Lowest-Priority Sheddable Task, Not The Head
+TEST_F(SchedulerTest, CoDelSchedulerShedsLowestPriority) {
+    CoDelScheduler scheduler(std::make_shared<PriorityScheduler>(),
+                             std::chrono::milliseconds(1), std::chrono::milliseconds(5));
+
+    std::vector<Task> tasks;
+    const TaskPriority priorities[] = {TaskPriority::HIGH, TaskPriority::HIGH, TaskPriority::MEDIUM,
+                                       TaskPriority::LOW, TaskPriority::LOW};
+    for (int i = 1; i <= 5; i++) {
+        Task task(i, priorities[i - 1], []() {}, 0);
+        task.setSheddable(priorities[i - 1] != TaskPriority::HIGH);
+        task.markReady();
+        scheduler.submit(task);
+        tasks.push_back(task);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    EXPECT_EQ(scheduler.getNextTask().getId(), 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    // The head is not sheddable, yet the drop still happens: to the older LOW task
+    std::optional<Task> next = scheduler.tryGetNextTask();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->getId(), 2);
+    EXPECT_EQ(scheduler.getRejectedCount(), 1u);
+    EXPECT_EQ(tasks[3].getState(), TaskState::REJECTED);
+    EXPECT_EQ(tasks[2].getState(), TaskState::READY);
+    EXPECT_EQ(tasks[4].getState(), TaskState::READY);
+    EXPECT_EQ(scheduler.size(), 2u);
+}
+
+// Test CoDel Scheduler - Non-Sheddable Tasks Are Never Rejected
+TEST_F(SchedulerTest, CoDelSchedulerKeepsNonSheddable) {
+    CoDelScheduler scheduler(std::make_shared<RoundRobinScheduler>(),
+                             std::chrono::milliseconds(1), std::chrono::milliseconds(1));
+
+    for (int i = 1; i <= 5; i++) {
+        Task task(i, TaskPriority::HIGH, []() {}, 0);
+        task.markReady();
+        scheduler.submit(task);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    int served = 0;
+    while (scheduler.tryGetNextTask()) {
+        served++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    EXPECT_EQ(served, 5);
+    EXPECT_EQ(scheduler.getRejectedCount(), 0u);
+}
+
+// ============================================================================
+// RateLimitScheduler Tests
+// ============================================================================
+
+// Test Rate Limit - Over-Limit Tasks Are Parked, Other Types Pass
+TEST_F(SchedulerTest, RateLimitParksOverLimitType) {
+    RateLimitScheduler scheduler(std::make_shared<RoundRobinScheduler>(),
+                                 {{"api", RateLimit{10.0, 2.0}}});
+
+    for (int i = 1; i <= 4; i++) {
+        Task task(i, TaskPriority::MEDIUM, []() {}, 0);
+        task.setType("api");
+        task.markReady();
+        scheduler.submit(task);
+    }
+    Task other(10, TaskPriority::MEDIUM, []() {}, 0);
+    other.setType("local");
+    other.markReady();
+    scheduler.submit(other);
+
+    // Burst of 2 plus the unlimited type; the rest wait without being dequeued
+    std::vector<int> served;
+    while (auto next = scheduler.tryGetNextTask()) {
+        served.push_back(next->getId());
+    }
+    EXPECT_EQ(served, (std::vector<int>{1, 2, 10}));
+    EXPECT_EQ(scheduler.getParkedCount(), 2u);
+    EXPECT_EQ(scheduler.getThrottledCount(), 2u);
+    EXPECT_FALSE(scheduler.empty());
+
+    // 10/s refills one token per 100ms
+    std::this_thread::sleep_for(std::chrono::milliseconds(110));
+    auto next = scheduler.tryGetNextTask();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->getId(), 3);
+    EXPECT_FALSE(scheduler.tryGetNextTask().has_value());
+    EXPECT_EQ(scheduler.getParkedCount(), 1u);
+}
+
+// Test Rate Limit - Tenant Limits Apply Across Types
+TEST_F(SchedulerTest, RateLimitPerTenant) {
+    RateLimitScheduler scheduler(std::make_shared<RoundRobinScheduler>(), {},
+                                 {{"acme", RateLimit{1.0, 1.0}}});
+
+    for (int i = 1; i <= 3; i++) {
+        Task task(i, TaskPriority::MEDIUM, []() {}, 0);
+        task.setType(i % 2 ? "print" : "sleep");
+        task.setTenant(i == 3 ? "other" : "acme");
+        task.markReady();
+        scheduler.submit(task);
+    }
+
+    std::vector<int> served;
+    while (auto next = scheduler.tryGetNextTask()) {
+        served.push_back(next->getId());
+    }
+    EXPECT_EQ(served, (std::vector<int>{1, 3}));
+    EXPECT_EQ(scheduler.getParkedCount(), 1u);
+}
+
+// Test Rate Limit - A Fast Lane Is Released At Its Own Refill Time
+TEST_F(SchedulerTest, RateLimitLanesRefillIndependently) {
+    RateLimitScheduler scheduler(std::make_shared<RoundRobinScheduler>(),
+                                 {{"slow", RateLimit{0.5, 1.0}}, {"fast", RateLimit{20.0, 1.0}}});
+
+    auto submit = [&scheduler](int id, const std::string& type) {
+        Task task(id, TaskPriority::MEDIUM, []() {}, 0);
+        task.setType(type);
+        task.markReady();
+        scheduler.submit(task);
+    };
+
+    // The slow lane parks first, for two seconds
+    submit(1, "slow");
+    submit(2, "slow");
+    ASSERT_EQ(scheduler.tryGetNextTask()->getId(), 1);
+    EXPECT_FALSE(scheduler.tryGetNextTask().has_value());
+
+    submit(3, "fast");
+    submit(4, "fast");
+    ASSERT_EQ(scheduler.tryGetNextTask()->getId(), 3);
+    EXPECT_FALSE(scheduler.tryGetNextTask().has_value());
+
+    // 20/s refills in 50ms, long before the slow lane
+    std::this_thread::sleep_for(std::chrono::milliseconds(70));
+    auto next = scheduler.tryGetNextTask();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->getId(), 4);
+    EXPECT_EQ(scheduler.getParkedCount(), 1u);
+}
+
+// ============================================================================
+// ConcurrencyLimitScheduler Tests
+// ============================================================================
+
+// Test Concurrency Limit - Key Is Capped, Others Keep Flowing
+TEST_F(SchedulerTest, ConcurrencyLimitCapsKey) {
+    ConcurrencyLimitScheduler scheduler(std::make_shared<RoundRobinScheduler>());
+
+    for (int i = 1; i <= 4; i++) {
+        Task task(i, TaskPriority::MEDIUM, []() {}, 0);
+        task.setConcurrencyLimit("db_export", 2);
+        task.markReady();
+        scheduler.submit(task);
+    }
+    Task free(10, TaskPriority::MEDIUM, []() {}, 0);
+    free.markReady();
+    scheduler.submit(free);
+
+    std::vector<Task> running;
+    while (auto next = scheduler.tryGetNextTask()) {
+        running.push_back(*next);
+    }
+    ASSERT_EQ(running.size(), 3u);
+    EXPECT_EQ(running[2].getId(), 10);
+    EXPECT_EQ(scheduler.getRunning("db_export"), 2);
+    EXPECT_EQ(scheduler.getWaiting("db_export"), 2u);
+    EXPECT_TRUE(scheduler.empty());
+}
+
+// Test Concurrency Limit - Finished Slot Is Handed To The Next Waiter
+TEST_F(SchedulerTest, ConcurrencyLimitHandoff) {
+    ConcurrencyLimitScheduler scheduler(std::make_shared<RoundRobinScheduler>());
+
+    for (int i = 1; i <= 3; i++) {
+        Task task(i, TaskPriority::MEDIUM, []() {}, 0);
+        task.setConcurrencyLimit("customer-7", 1);
+        task.markReady();
+        scheduler.submit(task);
+    }
+
+    std::optional<Task> first = scheduler.tryGetNextTask();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->getId(), 1);
+    EXPECT_FALSE(scheduler.tryGetNextTask().has_value());
+
+    scheduler.onTaskFinished(*first);
+    std::optional<Task> second = scheduler.tryGetNextTask();
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(second->getId(), 2);
+    EXPECT_EQ(scheduler.getRunning("customer-7"), 1);
+
+    scheduler.onTaskFinished(*second);
+    std::optional<Task> third = scheduler.tryGetNextTask();
+    ASSERT_TRUE(third.has_value());
+    EXPECT_EQ(third->getId(), 3);
+
+    scheduler.onTaskFinished(*third);
+    EXPECT_EQ(scheduler.getRunning("customer-7"), 0);
+    EXPECT_TRUE(scheduler.empty());
+}
+
+// ============================================================================
+// CircuitBreakerScheduler Tests
+// ============================================================================
+
+// Runs a dispatched task to COMPLETED or FAILED and reports it
+static void finish(Scheduler& scheduler, Task task) {
+    try {
+        task.execute();
+    } catch (...) {
+    }
+    scheduler.onTaskFinished(task);
+}
+
+// Test Circuit Breaker - Opens On Failure Rate And Parks The Type
+TEST_F(SchedulerTest, CircuitBreakerOpensAndParks) {
+    CircuitBreakerConfig config;
+    config.enabled = true;
+    config.window = 4;
+    config.minCalls = 4;
+    config.failureRate = 0.5;
+    config.openMs = 60000;
+    CircuitBreakerRegistry::instance().configure(config);
+    CircuitBreakerScheduler scheduler(std::make_shared<RoundRobinScheduler>());
+
+    auto make = [](int id, const std::string& type, bool fails) {
+        Task task(id, TaskPriority::MEDIUM, [fails]() {
+            if (fails) throw std::runtime_error("downstream unavailable");
+        }, 0);
+        task.setType(type);
+        task.markReady();
+        return task;
+    };
+
+    // 2 of 4 fail: the breaker opens on the 4th outcome
+    for (int i = 1; i <= 4; i++) {
+        scheduler.submit(make(i, "api", i % 2 == 0));
+        auto next = scheduler.tryGetNextTask();
+        ASSERT_TRUE(next.has_value());
+        finish(scheduler, std::move(*next));
+    }
+    EXPECT_TRUE(CircuitBreakerRegistry::instance().isOpen("api"));
+    EXPECT_EQ(CircuitBreakerRegistry::instance().getStats()["api"].lastTransition, "closed->open");
+
+    // Open: api tasks wait without reaching a worker; other types still run
+    scheduler.submit(make(5, "api", false));
+    scheduler.submit(make(6, "local", false));
+    auto next = scheduler.tryGetNextTask();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->getId(), 6);
+    EXPECT_FALSE(scheduler.tryGetNextTask().has_value());
+    EXPECT_EQ(scheduler.getParkedCount(), 1u);
+    EXPECT_EQ(scheduler.size(), 1u);
+
+    CircuitBreakerRegistry::instance().configure(CircuitBreakerConfig());
+}
+
+// Test Circuit Breaker - Half-Open Probe Closes Or Re-Opens
+TEST_F(SchedulerTest, CircuitBreakerHalfOpenProbe) {
+    CircuitBreakerConfig config;
+    config.enabled = true;
+    config.window = 2;
+    config.minCalls = 2;
+    config.failureRate = 1.0;
+    config.openMs = 20;
+    config.probes = 1;
+    CircuitBreakerRegistry::instance().configure(config);
+    CircuitBreakerScheduler scheduler(std::make_shared<RoundRobinScheduler>());
+
+    std::atomic<bool> healthy{false};
+    auto make = [&healthy](int id) {
+        Task task(id, TaskPriority::MEDIUM, [&healthy]() {
+            if (!healthy) throw std::runtime_error("down");
+        }, 0);
+        task.setType("api");
+        task.markReady();
+        return task;
+    };
+
+    for (int i = 1; i <= 2; i++) {
+        scheduler.submit(make(i));
+        finish(scheduler, *scheduler.tryGetNextTask());
+    }
+    for (int i = 3; i <= 5; i++) {
+        scheduler.submit(make(i));
+    }
+    EXPECT_FALSE(scheduler.tryGetNextTask().has_value());
+
+    // After the cool-down exactly one probe is let through; it fails
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    auto probe = scheduler.tryGetNextTask();
+    ASSERT_TRUE(probe.has_value());
+    EXPECT_EQ(probe->getId(), 3);
+    EXPECT_FALSE(scheduler.tryGetNextTask().has_value());
+    finish(scheduler, std::move(*probe));
+    EXPECT_TRUE(CircuitBreakerRegistry::instance().isOpen("api"));
+
+    // Next probe succeeds: closed again, the rest drain in order
+    healthy = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    probe = scheduler.tryGetNextTask();
+    ASSERT_TRUE(probe.has_value());
+    EXPECT_EQ(probe->getId(), 4);
+    finish(scheduler, std::move(*probe));
+    auto stats = CircuitBreakerRegistry::instance().getStats()["api"];
+    EXPECT_EQ(stats.state, CircuitState::CLOSED);
+    EXPECT_EQ(stats.opened, 2u);
+    EXPECT_EQ(stats.closed, 1u);
+    auto last = scheduler.tryGetNextTask();
+    ASSERT_TRUE(last.has_value());
+    EXPECT_EQ(last->getId(), 5);
+    EXPECT_TRUE(scheduler.empty());
+
+    CircuitBreakerRegistry::instance().configure(CircuitBreakerConfig());
+}
+
+// Test Circuit Breaker - A Probe Cancelled Before Running Frees Its Slot
+TEST_F(SchedulerTest, CircuitBreakerCancelledProbeReleased) {
+    CircuitBreakerConfig config;
+    config.enabled = true;
+    config.window = 2;
+    config.minCalls = 2;
+    config.failureRate = 1.0;
+    config.openMs = 20;
+    config.probes = 1;
+    CircuitBreakerRegistry::instance().configure(config);
+    ConcurrencyLimitScheduler scheduler(
+        std::make_shared<CircuitBreakerScheduler>(std::make_shared<RoundRobinScheduler>()));
+
+    auto make = [](int id, const std::string& type, const std::string& key) {
+        Task task(id, TaskPriority::MEDIUM, []() { throw std::runtime_error("down"); }, 0);
+        task.setType(type);
+        if (!key.empty()) {
+            task.setConcurrencyLimit(key, 1);
+        }
+        task.markReady();
+        return task;
+    };
+
+    for (int i = 1; i <= 2; i++) {
+        scheduler.submit(make(i, "api", ""));
+        finish(scheduler, *scheduler.tryGetNextTask());
+    }
+    ASSERT_TRUE(CircuitBreakerRegistry::instance().isOpen("api"));
+
+    // Task 3 parks behind the breaker; the holder takes the only "db" slot
+    scheduler.submit(make(3, "api", "db"));
+    scheduler.submit(make(10, "local", "db"));
+    auto holder = scheduler.tryGetNextTask();
+    ASSERT_TRUE(holder.has_value());
+    EXPECT_EQ(holder->getId(), 10);
+
+    // Half-open: task 3 is let through as the probe, then waits on "db"
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_FALSE(scheduler.tryGetNextTask().has_value());
+    EXPECT_EQ(CircuitBreakerRegistry::instance().getStats()["api"].state, CircuitState::HALF_OPEN);
+
+    // Cancelled without a result: the next api task becomes the probe
+    EXPECT_TRUE(scheduler.cancel(3));
+    scheduler.submit(make(4, "api", ""));
+    auto probe = scheduler.tryGetNextTask();
+    ASSERT_TRUE(probe.has_value());
+    EXPECT_EQ(probe->getId(), 4);
+
+    CircuitBreakerRegistry::instance().configure(CircuitBreakerConfig());
+}
+
+// Test Circuit Breaker - Fail-Fast Mode Rejects Instead Of Parking
+TEST_F(SchedulerTest, CircuitBreakerFailFast) {
+    CircuitBreakerConfig config;
+    config.enabled = true;
+    config.window = 1;
+    config.minCalls = 1;
+    config.openMs = 60000;
+    config.failFast = true;
+    CircuitBreakerRegistry::instance().configure(config);
+    CircuitBreakerScheduler scheduler(std::make_shared<RoundRobinScheduler>());
+
+    Task failing(1, TaskPriority::MEDIUM, []() { throw std::runtime_error("down"); }, 0);
+    failing.setType("api");
+    failing.markReady();
+    scheduler.submit(failing);
+    finish(scheduler, *scheduler.tryGetNextTask());
+
+    for (int i = 2; i <= 3; i++) {
+        Task task(i, TaskPriority::MEDIUM, []() {}, 0);
+        task.setType("api");
+        task.markReady();
+        scheduler.submit(task);
+    }
+    EXPECT_FALSE(scheduler.tryGetNextTask().has_value());
+    EXPECT_EQ(scheduler.getRejectedCount(), 2u);
+    EXPECT_EQ(scheduler.getParkedCount(), 0u);
+    EXPECT_TRUE(scheduler.empty());
+
+    CircuitBreakerRegistry::instance().configure(CircuitBreakerConfig());
+}
+
+// Test Drain - Every Scheduler Hands Back All Queued Tasks
+TEST_F(SchedulerTest, DrainReturnsQueuedTasks) {
+    std::vector<std::shared_ptr<Scheduler>> schedulers = {
+        std::make_shared<PriorityScheduler>(),
+        std::make_shared<RoundRobinScheduler>(),
+        std::make_shared<EDFScheduler>(),
+        std::make_shared<MLFQScheduler>(),
+        std::make_shared<SJFScheduler>(),
+        std::make_shared<ConcurrencyLimitScheduler>(std::make_shared<RoundRobinScheduler>())
+    };
+
+    for (auto& scheduler : schedulers) {
+        for (int i = 1; i <= 3; i++) {
+            Task task(i, TaskPriority::MEDIUM, []() {}, 0);
+            task.markReady();
+            scheduler->submit(task);
+        }
+        auto drained = scheduler->drain();
+        EXPECT_EQ(drained.size(), 3u);
+        EXPECT_TRUE(scheduler->empty());
+    }
+}
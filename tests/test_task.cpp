@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "../src/core/Task.h"
+#include <atomic>
 #include <chrono>
 #include <thread>
 #include <stdexcept>
@@ -179,3 +180,96 @@ TEST_F(TaskTest, RetryStateMachine) {
         EXPECT_EQ(task.getRetryCount(), 1);
     }
 }
+
+// Test Task Rejection: READY -> REJECTED keeps the reason
+TEST_F(TaskTest, MarkRejected) {
+    Task task(1, TaskPriority::LOW, []() {}, 0);
+    EXPECT_FALSE(task.isSheddable());
+    
+    // Not queued yet: cannot be rejected
+    task.markRejected("too early");
+    EXPECT_EQ(task.getState(), TaskState::CREATED);
+    
+    task.markReady();
+    task.markRejected("overloaded");
+    EXPECT_EQ(task.getState(), TaskState::REJECTED);
+    EXPECT_EQ(task.getRejectReason(), "overloaded");
+    
+    // Terminal: cannot run afterwards
+    task.execute();
+    EXPECT_EQ(task.getState(), TaskState::REJECTED);
+}
+
+// Test Task Cancellation: only before it runs, and terminal
+TEST_F(TaskTest, MarkCancelled) {
+    Task queued(1, TaskPriority::LOW, []() {}, 0);
+    queued.markReady();
+    queued.markCancelled();
+    EXPECT_EQ(queued.getState(), TaskState::CANCELLED);
+    queued.execute();
+    EXPECT_EQ(queued.getState(), TaskState::CANCELLED);
+    
+    Task done(2, TaskPriority::LOW, []() {}, 0);
+    done.markReady();
+    done.execute();
+    done.markCancelled();
+    EXPECT_EQ(done.getState(), TaskState::COMPLETED);
+}
+
+// Test Task Drop: READY -> FAILED only, never over another final state
+TEST_F(TaskTest, MarkFailed) {
+    Task queued(1, TaskPriority::LOW, []() {}, 0);
+    queued.markFailed();
+    EXPECT_EQ(queued.getState(), TaskState::CREATED);
+    queued.markReady();
+    queued.markFailed();
+    EXPECT_EQ(queued.getState(), TaskState::FAILED);
+    EXPECT_GE(queued.getEndTime(), queued.getEnqueueTime());
+    
+    Task cancelled(2, TaskPriority::LOW, []() {}, 0);
+    cancelled.markReady();
+    cancelled.markCancelled();
+    cancelled.markFailed();
+    EXPECT_EQ(cancelled.getState(), TaskState::CANCELLED);
+    
+    Task done(3, TaskPriority::LOW, []() {}, 0);
+    done.markReady();
+    done.execute();
+    done.markFailed();
+    EXPECT_EQ(done.getState(), TaskState::COMPLETED);
+}
+
+// Test Copies Share One Control Block; Clone Does Not
+TEST_F(TaskTest, CopiesShareState) {
+    Task task(1, TaskPriority::LOW, []() {}, 0);
+    Task copy = task;
+    Task fresh = task.clone([]() {});
+    
+    copy.markReady();
+    copy.execute();
+    EXPECT_EQ(task.getState(), TaskState::COMPLETED);
+    EXPECT_EQ(fresh.getState(), TaskState::CREATED);
+    EXPECT_EQ(fresh.getId(), 1);
+}
+
+// Test Concurrent Transitions: Exactly One Wins The CAS
+TEST_F(TaskTest, ConcurrentTransitionsAreExclusive) {
+    for (int round = 0; round < 50; round++) {
+        std::atomic<int> ran{0};
+        Task runner(round, TaskPriority::LOW, [&ran]() { ran++; }, 0);
+        runner.markReady();
+        Task canceller = runner;
+        std::thread a([&runner]() { runner.execute(); });
+        std::thread b([&canceller]() { canceller.markCancelled(); });
+        a.join();
+        b.join();
+        
+        // Either it ran to completion or it was cancelled first, never both
+        if (runner.getState() == TaskState::CANCELLED) {
+            EXPECT_EQ(ran.load(), 0);
+        } else {
+            EXPECT_EQ(runner.getState(), TaskState::COMPLETED);
+            EXPECT_EQ(ran.load(), 1);
+        }
+    }
+}
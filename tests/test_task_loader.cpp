@@ -262,3 +262,233 @@ TEST_F(TaskLoaderTest, CreatePrintTask) {
     task.execute();
     EXPECT_EQ(task.getState(), TaskState::COMPLETED);
 }
+
+// Test Deadline Parsing
+TEST_F(TaskLoaderTest, DeadlineParsing) {
+    std::string jsonStr = R"({
+        "tasks": [
+            {
+                "id": 1,
+                "name": "Deadline Task",
+                "type": "print",
+                "deadline_ms": 250
+            },
+            {
+                "id": 2,
+                "name": "Bad Deadline",
+                "type": "print",
+                "deadline_ms": -5
+            }
+        ]
+    })";
+    
+    auto tasks = TaskLoader::loadFromJsonString(jsonStr);
+    ASSERT_EQ(tasks.size(), 2);
+    EXPECT_EQ(tasks[0].deadlineMs, 250);
+    EXPECT_EQ(tasks[1].deadlineMs, 0); // Invalid deadline ignored
+}
+
+// Test Create Task With Deadline
+TEST_F(TaskLoaderTest, CreateTaskWithDeadline) {
+    TaskDefinition def;
+    def.id = 1;
+    def.name = "Deadline Task";
+    def.type = "print";
+    def.deadlineMs = 1000;
+    
+    auto before = std::chrono::steady_clock::now();
+    Task task = TaskLoader::createTask(def);
+    
+    EXPECT_EQ(task.getType(), "print");
+    EXPECT_TRUE(task.hasDeadline());
+    EXPECT_GE(task.getDeadline(), before + std::chrono::milliseconds(1000));
+    
+    def.deadlineMs = 0;
+    EXPECT_FALSE(TaskLoader::createTask(def).hasDeadline());
+}
+
+// Test Params Hash Is Stable And Order Independent
+TEST_F(TaskLoaderTest, ParamsHashStable) {
+    TaskDefinition a;
+    a.params["duration_ms"] = "100";
+    a.params["message"] = "hi";
+    
+    TaskDefinition b;
+    b.params["message"] = "hi";
+    b.params["duration_ms"] = "100";
+    
+    TaskDefinition c;
+    c.params["duration_ms"] = "200";
+    
+    EXPECT_EQ(a.getParamsHash(), b.getParamsHash());
+    EXPECT_NE(a.getParamsHash(), c.getParamsHash());
+    EXPECT_EQ(TaskDefinition().getParamsHash(), 0u);
+    
+    a.id = 1;
+    a.type = "sleep";
+    EXPECT_EQ(TaskLoader::createTask(a).getParamsHash(), a.getParamsHash());
+}
+
+// Test Sheddable Defaults To Non-HIGH Priority
+TEST_F(TaskLoaderTest, SheddableParsing) {
+    std::string jsonStr = R"({
+        "tasks": [
+            {"id": 1, "name": "Low", "priority": "LOW"},
+            {"id": 2, "name": "High", "priority": "HIGH"},
+            {"id": 3, "name": "High Sheddable", "priority": "HIGH", "sheddable": true},
+            {"id": 4, "name": "Low Protected", "priority": "LOW", "sheddable": false}
+        ]
+    })";
+    
+    auto tasks = TaskLoader::loadFromJsonString(jsonStr);
+    ASSERT_EQ(tasks.size(), 4);
+    EXPECT_TRUE(tasks[0].sheddable);
+    EXPECT_FALSE(tasks[1].sheddable);
+    EXPECT_TRUE(tasks[2].sheddable);
+    EXPECT_FALSE(tasks[3].sheddable);
+    EXPECT_TRUE(TaskLoader::createTask(tasks[0]).isSheddable());
+}
+
+// Test Delay And Run At Parsing
+TEST_F(TaskLoaderTest, DelayParsing) {
+    std::string jsonStr = R"({
+        "tasks": [
+            {"id": 1, "name": "Delayed", "delay_ms": 600000},
+            {"id": 2, "name": "Scheduled", "run_at": 4102444800000},
+            {"id": 3, "name": "Immediate"}
+        ]
+    })";
+    
+    auto tasks = TaskLoader::loadFromJsonString(jsonStr);
+    ASSERT_EQ(tasks.size(), 3);
+    EXPECT_EQ(tasks[0].delayMs, 600000);
+    EXPECT_EQ(tasks[1].runAtMs, 4102444800000LL);
+    
+    auto now = std::chrono::steady_clock::now();
+    Task delayed = TaskLoader::createTask(tasks[0]);
+    EXPECT_GE(delayed.getRunAt(), now + std::chrono::minutes(9));
+    
+    Task scheduled = TaskLoader::createTask(tasks[1]);
+    EXPECT_GT(scheduled.getRunAt(), delayed.getRunAt());
+    
+    Task immediate = TaskLoader::createTask(tasks[2]);
+    EXPECT_EQ(immediate.getRunAt(), std::chrono::steady_clock::time_point());
+}
+
+// Test Schedule Parsing
+TEST_F(TaskLoaderTest, ScheduleParsing) {
+    std::string jsonStr = R"({
+        "tasks": [
+            {"id": 1, "name": "Every", "schedule": {"every": "30s", "overlap": "queue", "catch_up": "all"}},
+            {"id": 2, "name": "Cron", "schedule": {"cron": "*/5 * * * *"}},
+            {"id": 3, "name": "Bad", "schedule": {"every_ms": 1, "overlap": "sometimes"}},
+            {"id": 4, "name": "Once"}
+        ]
+    })";
+    
+    auto tasks = TaskLoader::loadFromJsonString(jsonStr);
+    ASSERT_EQ(tasks.size(), 4);
+    EXPECT_EQ(tasks[0].everyMs, 30000);
+    EXPECT_EQ(tasks[0].overlap, "queue");
+    EXPECT_EQ(tasks[0].catchUp, "all");
+    EXPECT_TRUE(tasks[0].isRecurring());
+    
+    EXPECT_EQ(tasks[1].cron, "*/5 * * * *");
+    EXPECT_EQ(tasks[1].overlap, "skip");
+    EXPECT_TRUE(tasks[1].isRecurring());
+    
+    EXPECT_FALSE(tasks[2].isRecurring());
+    EXPECT_EQ(tasks[2].overlap, "skip");
+    EXPECT_FALSE(tasks[3].isRecurring());
+}
+
+// Test Duration Strings
+TEST_F(TaskLoaderTest, ParseDuration) {
+    EXPECT_EQ(TaskLoader::parseDurationMs("250ms"), 250);
+    EXPECT_EQ(TaskLoader::parseDurationMs("30s"), 30000);
+    EXPECT_EQ(TaskLoader::parseDurationMs("5m"), 300000);
+    EXPECT_EQ(TaskLoader::parseDurationMs("1h"), 3600000);
+    EXPECT_EQ(TaskLoader::parseDurationMs("10"), 10000);
+    EXPECT_EQ(TaskLoader::parseDurationMs("soon"), -1);
+    EXPECT_EQ(TaskLoader::parseDurationMs("5d"), -1);
+}
+
+// Test Concurrency Key Parsing
+TEST_F(TaskLoaderTest, ConcurrencyParsing) {
+    std::string jsonStr = R"({
+        "tasks": [
+            {"id": 1, "name": "Export", "concurrency_key": "db_export", "max_concurrency": 3},
+            {"id": 2, "name": "Customer", "concurrency_key": "customer-42"},
+            {"id": 3, "name": "Free", "max_concurrency": 5}
+        ]
+    })";
+    
+    auto tasks = TaskLoader::loadFromJsonString(jsonStr);
+    ASSERT_EQ(tasks.size(), 3);
+    EXPECT_EQ(tasks[0].maxConcurrency, 3);
+    EXPECT_EQ(tasks[1].maxConcurrency, 1);
+    EXPECT_TRUE(tasks[2].concurrencyKey.empty());
+    EXPECT_EQ(tasks[2].maxConcurrency, 0);
+    
+    Task task = TaskLoader::createTask(tasks[0]);
+    EXPECT_EQ(task.getConcurrencyKey(), "db_export");
+    EXPECT_EQ(task.getMaxConcurrency(), 3);
+}
+
+// Test Queue Parsing
+TEST_F(TaskLoaderTest, QueueParsing) {
+    std::string jsonStr = R"({
+        "tasks": [
+            {"id": 1, "name": "Report", "queue": "reports"},
+            {"id": 2, "name": "Plain"}
+        ]
+    })";
+    
+    auto tasks = TaskLoader::loadFromJsonString(jsonStr);
+    ASSERT_EQ(tasks.size(), 2);
+    EXPECT_EQ(tasks[0].queue, "reports");
+    EXPECT_EQ(tasks[1].queue, "default");
+}
+
+// Test Dedup Key Parsing
+TEST_F(TaskLoaderTest, DedupParsing) {
+    std::string jsonStr = R"({
+        "tasks": [
+            {"id": 1, "name": "A", "type": "sleep", "params": {"duration_ms": "5"}, "dedup": true},
+            {"id": 2, "name": "B", "type": "sleep", "params": {"duration_ms": "5"}, "dedup": true},
+            {"id": 3, "name": "C", "type": "sleep", "params": {"duration_ms": "6"}, "dedup": true},
+            {"id": 4, "name": "D", "dedup_key": "report-2024"},
+            {"id": 5, "name": "E", "type": "sleep"}
+        ]
+    })";
+    
+    auto tasks = TaskLoader::loadFromJsonString(jsonStr);
+    ASSERT_EQ(tasks.size(), 5);
+    EXPECT_EQ(tasks[0].getDedupKey(), tasks[1].getDedupKey());
+    EXPECT_NE(tasks[0].getDedupKey(), tasks[2].getDedupKey());
+    EXPECT_EQ(TaskLoader::createTask(tasks[3]).getDedupKey(), "report-2024");
+    EXPECT_TRUE(tasks[4].getDedupKey().empty());
+}
+
+// Test Optional IDs For Server-Assigned Task IDs
+TEST_F(TaskLoaderTest, OptionalIdForServerAssignedIds) {
+    std::string jsonStr = R"({
+        "tasks": [
+            {"name": "No ID", "type": "print"},
+            {"id": 7, "name": "Client ID", "type": "print"}
+        ]
+    })";
+    
+    EXPECT_EQ(TaskLoader::loadFromJsonString(jsonStr).size(), 1);
+    
+    auto tasks = TaskLoader::loadFromJsonString(jsonStr, true);
+    ASSERT_EQ(tasks.size(), 2);
+    EXPECT_EQ(tasks[0].id, 0);
+    EXPECT_EQ(tasks[1].id, 7);
+    
+    tasks[1].externalId = tasks[1].id;
+    tasks[1].id = 1 << 30;
+    Task task = TaskLoader::createTask(tasks[1]);
+    EXPECT_EQ(task.getId(), 1 << 30);
+    EXPECT_EQ(task.getExternalId(), 7);
+}
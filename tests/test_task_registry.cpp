@@ -0,0 +1,379 @@
+#include <gtest/gtest.h>
+#include "../core/TaskRegistry.h"
+#include "../utils/Database.h"
+#include "../utils/Epoch.h"
+#include "../src/core/Task.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+class TaskRegistryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        TaskRegistry::instance().clear();
+    }
+    
+    void TearDown() override {
+        TaskRegistry::instance().setRetention(0);
+        TaskRegistry::instance().clear();
+    }
+    
+    static Task makeTask(int id) {
+        return Task(id, TaskPriority::MEDIUM, []() {}, 0);
+    }
+};
+
+// Test Insert-If-Absent Rejects Duplicate IDs
+TEST_F(TaskRegistryTest, RegisterIsInsertIfAbsent) {
+    TaskRegistry& registry = TaskRegistry::instance();
+    EXPECT_TRUE(registry.registerTask(makeTask(1)));
+    EXPECT_FALSE(registry.registerTask(makeTask(1)));
+    EXPECT_EQ(registry.size(), 1u);
+    
+    ASSERT_NE(registry.getTask(1), nullptr);
+    EXPECT_EQ(registry.getTask(2), nullptr);
+}
+
+// Test Growth, Removal And Tombstone Reuse Keep Lookups Correct
+TEST_F(TaskRegistryTest, GrowAndRemove) {
+    TaskRegistry& registry = TaskRegistry::instance();
+    for (int id = 0; id < 5000; id++) {
+        ASSERT_TRUE(registry.registerTask(makeTask(id)));
+    }
+    for (int id = 0; id < 5000; id += 2) {
+        EXPECT_TRUE(registry.removeTask(id));
+    }
+    EXPECT_FALSE(registry.removeTask(0));
+    EXPECT_EQ(registry.size(), 2500u);
+    
+    for (int id = 0; id < 5000; id++) {
+        auto task = registry.getTask(id);
+        if (id % 2 == 0) {
+            EXPECT_EQ(task, nullptr);
+        } else {
+            ASSERT_NE(task, nullptr);
+            EXPECT_EQ(task->getId(), id);
+        }
+    }
+    
+    // Removed IDs can be registered again
+    EXPECT_TRUE(registry.registerTask(makeTask(10)));
+    auto all = registry.getAllTasks();
+    ASSERT_EQ(all.size(), 2501u);
+    EXPECT_EQ(all.front()->getId(), 1);
+    EXPECT_EQ(all[4]->getId(), 9);
+    EXPECT_EQ(all[5]->getId(), 10);
+}
+
+// Test Concurrent Duplicate Registrations: Exactly One Wins Per ID
+TEST_F(TaskRegistryTest, ConcurrentRegisterDuplicates) {
+    TaskRegistry& registry = TaskRegistry::instance();
+    std::atomic<int> wins{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&registry, &wins]() {
+            for (int id = 0; id < 1000; id++) {
+                if (registry.registerTask(makeTask(id))) {
+                    wins++;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(wins.load(), 1000);
+    EXPECT_EQ(registry.size(), 1000u);
+}
+
+// Test Readers Keep Working While Writers Grow, Remove And Clear
+TEST_F(TaskRegistryTest, ReadersDuringWrites) {
+    TaskRegistry& registry = TaskRegistry::instance();
+    std::atomic<bool> done{false};
+    std::atomic<int> mismatches{0};
+    
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; r++) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                for (int id = 0; id < 2000; id += 37) {
+                    auto task = registry.getTask(id);
+                    if (task && task->getId() != id) {
+                        mismatches++;
+                    }
+                }
+                registry.getAllTasks();
+            }
+        });
+    }
+    
+    for (int round = 0; round < 5; round++) {
+        for (int id = 0; id < 2000; id++) {
+            registry.registerTask(makeTask(id));
+        }
+        for (int id = 0; id < 2000; id += 3) {
+            registry.removeTask(id);
+        }
+        registry.clear();
+    }
+    done = true;
+    for (auto& t : readers) {
+        t.join();
+    }
+    EXPECT_EQ(mismatches.load(), 0);
+}
+
+// Test Epoch - Retired Memory Waits For Pinned Readers
+TEST_F(TaskRegistryTest, EpochDefersReclamation) {
+    Epoch& epoch = Epoch::instance();
+    epoch.collect();
+    
+    std::atomic<bool> freed{false};
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> release{false};
+    std::thread reader([&]() {
+        Epoch::Guard guard;
+        pinned = true;
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+    while (!pinned) {
+        std::this_thread::yield();
+    }
+    
+    epoch.retire([&freed]() { freed = true; });
+    epoch.collect();
+    EXPECT_FALSE(freed.load());
+    
+    release = true;
+    reader.join();
+    epoch.collect();
+    EXPECT_TRUE(freed.load());
+}
+
+// Test Retention - Oldest Finished Tasks Spill To The Database
+TEST_F(TaskRegistryTest, RetentionSpillsOldestFinished) {
+    ASSERT_TRUE(Database::instance().initialize(":memory:"));
+    TaskRegistry& registry = TaskRegistry::instance();
+    
+    for (int id = 0; id < 10; id++) {
+        Task task = makeTask(id);
+        ASSERT_TRUE(registry.registerTask(task));
+        task.markReady();
+        task.execute();
+    }
+    Task active = makeTask(10);
+    active.markReady();
+    ASSERT_TRUE(registry.registerTask(active));
+    
+    registry.setRetention(4);
+    registry.enforceRetention();
+    
+    // The active task and the four most recently finished stay in memory
+    EXPECT_EQ(registry.size(), 5u);
+    EXPECT_NE(registry.getTask(10), nullptr);
+    for (int id = 6; id < 10; id++) {
+        EXPECT_NE(registry.getTask(id), nullptr) << "task " << id;
+    }
+    
+    TaskRecord record;
+    EXPECT_EQ(registry.getTask(0), nullptr);
+    ASSERT_TRUE(registry.getArchivedTask(0, record));
+    EXPECT_EQ(record.state, static_cast<int>(TaskState::COMPLETED));
+    EXPECT_FALSE(record.completed_at.empty());
+    EXPECT_FALSE(registry.getArchivedTask(42, record));
+    
+    RegistryStats stats = registry.getStats();
+    EXPECT_EQ(stats.spilled, 6u);
+    EXPECT_EQ(stats.hot, 5u);
+    EXPECT_DOUBLE_EQ(stats.coldHitRatio(), 0.5);
+}
+
+// Test Retention - Registrations Wake A Background Pass
+TEST_F(TaskRegistryTest, RetentionRunsInBackground) {
+    ASSERT_TRUE(Database::instance().initialize(":memory:"));
+    TaskRegistry& registry = TaskRegistry::instance();
+    registry.setRetention(2);
+    
+    for (int id = 0; id < 8; id++) {
+        Task task = makeTask(id);
+        task.markReady();
+        task.execute();
+        ASSERT_TRUE(registry.registerTask(task));
+    }
+    
+    // The pass runs off the registering thread; wait for it to catch up
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (registry.size() > 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(registry.size(), 2u);
+    EXPECT_NE(registry.getTask(7), nullptr);
+    TaskRecord record;
+    EXPECT_TRUE(registry.getArchivedTask(0, record));
+}
+
+// Test State Index - A Task With Another Hook Is Indexed, Both Hooks Fire
+TEST_F(TaskRegistryTest, StateIndexCoexistsWithSourceHook) {
+    struct Counter : TaskStateHook {
+        explicit Counter(std::atomic<int>& calls) : calls(calls) {}
+        void onStateChange(const Task&) override { calls++; }
+        std::atomic<int>& calls;
+    };
+    std::atomic<int> calls{0};
+    
+    TaskRegistry& registry = TaskRegistry::instance();
+    Task task = makeTask(1);
+    task.attachStateHook(TaskHookSlot::SOURCE, std::make_unique<Counter>(calls));
+    ASSERT_TRUE(registry.registerTask(task));
+    
+    task.markReady();
+    task.execute();
+    EXPECT_EQ(calls.load(), 3);  // READY, RUNNING, COMPLETED
+    EXPECT_EQ(registry.countByState(TaskState::COMPLETED), 1u);
+    EXPECT_EQ(registry.countByState(TaskState::CREATED), 0u);
+}
+
+// Test State Index - Counts And Lists Follow Every Transition
+TEST_F(TaskRegistryTest, StateIndexFollowsTransitions) {
+    TaskRegistry& registry = TaskRegistry::instance();
+    std::vector<Task> tasks;
+    for (int id = 0; id < 6; id++) {
+        tasks.push_back(makeTask(id));
+        ASSERT_TRUE(registry.registerTask(tasks.back()));
+    }
+    EXPECT_EQ(registry.countByState(TaskState::CREATED), 6u);
+    
+    for (int id = 0; id < 4; id++) {
+        tasks[id].markReady();
+    }
+    tasks[0].execute();
+    tasks[1].markCancelled();
+    tasks[4].markCancelled();
+    
+    EXPECT_EQ(registry.countByState(TaskState::CREATED), 1u);
+    EXPECT_EQ(registry.countByState(TaskState::READY), 2u);
+    EXPECT_EQ(registry.countByState(TaskState::COMPLETED), 1u);
+    EXPECT_EQ(registry.countByState(TaskState::CANCELLED), 2u);
+    
+    auto cancelled = registry.getTasksByState(TaskState::CANCELLED);
+    ASSERT_EQ(cancelled.size(), 2u);
+    EXPECT_EQ(cancelled[0]->getId(), 1);
+    EXPECT_EQ(cancelled[1]->getId(), 4);
+    
+    // Removed tasks leave the index; re-registering puts them back
+    EXPECT_TRUE(registry.removeTask(4));
+    tasks[2].execute();
+    EXPECT_EQ(registry.countByState(TaskState::CANCELLED), 1u);
+    EXPECT_EQ(registry.countByState(TaskState::COMPLETED), 2u);
+    EXPECT_TRUE(registry.registerTask(tasks[4]));
+    EXPECT_EQ(registry.countByState(TaskState::CANCELLED), 2u);
+    
+    registry.clear();
+    tasks[3].execute();
+    EXPECT_EQ(registry.countByState(TaskState::COMPLETED), 0u);
+    EXPECT_EQ(registry.countByState(TaskState::READY), 0u);
+}
+
+// Test State Index Under Concurrent Transitions
+TEST_F(TaskRegistryTest, StateIndexConcurrentTransitions) {
+    TaskRegistry& registry = TaskRegistry::instance();
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 500;
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&registry, t]() {
+            for (int i = 0; i < PER_THREAD; i++) {
+                Task task = makeTask(t * PER_THREAD + i);
+                registry.registerTask(task);
+                task.markReady();
+                if (i % 2 == 0) {
+                    task.execute();
+                } else {
+                    task.markCancelled();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    EXPECT_EQ(registry.countByState(TaskState::COMPLETED), THREADS * PER_THREAD / 2u);
+    EXPECT_EQ(registry.countByState(TaskState::CANCELLED), THREADS * PER_THREAD / 2u);
+    EXPECT_EQ(registry.countByState(TaskState::READY), 0u);
+    EXPECT_EQ(registry.getTasksByState(TaskState::COMPLETED).size(), THREADS * PER_THREAD / 2u);
+}
+
+// Test Server-Assigned IDs Are Dense And Stored By Index
+TEST_F(TaskRegistryTest, DenseServerAssignedIds) {
+    TaskRegistry& registry = TaskRegistry::instance();
+    
+    // Span a few segments, interleaved with client-chosen IDs
+    std::vector<int> ids;
+    for (int i = 0; i < 10000; i++) {
+        int id = registry.allocateId();
+        ASSERT_GE(id, TaskRegistry::DENSE_BASE);
+        if (!ids.empty()) {
+            ASSERT_EQ(id, ids.back() + 1);
+        }
+        ids.push_back(id);
+        ASSERT_TRUE(registry.registerTask(makeTask(id)));
+        ASSERT_TRUE(registry.registerTask(makeTask(i + 1)));
+    }
+    EXPECT_EQ(registry.size(), 20000u);
+    EXPECT_FALSE(registry.registerTask(makeTask(ids[123])));
+    ASSERT_NE(registry.getTask(ids[5000]), nullptr);
+    EXPECT_EQ(registry.getTask(ids[5000])->getId(), ids[5000]);
+    EXPECT_EQ(registry.getTask(ids.back() + 1), nullptr);
+    EXPECT_EQ(registry.countByState(TaskState::CREATED), 20000u);
+    
+    auto all = registry.getAllTasks();
+    ASSERT_EQ(all.size(), 20000u);
+    EXPECT_EQ(all.back()->getId(), ids.back());
+    
+    // Draining whole segments frees them; their IDs can still be registered
+    for (int id : ids) {
+        ASSERT_TRUE(registry.removeTask(id));
+    }
+    EXPECT_EQ(registry.size(), 10000u);
+    EXPECT_EQ(registry.getTask(ids[0]), nullptr);
+    EXPECT_FALSE(registry.removeTask(ids[0]));
+    EXPECT_TRUE(registry.registerTask(makeTask(ids[0])));
+    EXPECT_NE(registry.getTask(ids[0]), nullptr);
+}
+
+// Test Snapshot - Reused While Fresh, Rebuilt Only After Membership Changes
+TEST_F(TaskRegistryTest, SnapshotRebuiltOnChange) {
+    TaskRegistry& registry = TaskRegistry::instance();
+    registry.setSnapshotInterval(std::chrono::milliseconds(20));
+    for (int id = 3; id >= 1; id--) {
+        ASSERT_TRUE(registry.registerTask(makeTask(id)));
+    }
+    
+    auto first = registry.getSnapshot();
+    ASSERT_EQ(first->tasks.size(), 3u);
+    EXPECT_EQ(first->tasks[0]->getId(), 1);
+    
+    // Within the interval the same snapshot is served, even after a change
+    ASSERT_TRUE(registry.registerTask(makeTask(4)));
+    EXPECT_EQ(registry.getSnapshot(), first);
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    auto second = registry.getSnapshot();
+    EXPECT_NE(second, first);
+    EXPECT_EQ(second->tasks.size(), 4u);
+    EXPECT_GT(second->version, first->version);
+    
+    // Fields are live; an unchanged membership keeps the snapshot
+    registry.getTask(2)->markReady();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    auto third = registry.getSnapshot();
+    EXPECT_EQ(third, second);
+    EXPECT_EQ(third->tasks[1]->getState(), TaskState::READY);
+    
+    registry.setSnapshotInterval(std::chrono::milliseconds(100));
+}
@@ -0,0 +1,470 @@
+#include <gtest/gtest.h>
+#include "../src/executor/ThreadPool.h"
+#include "../src/executor/QueueRegistry.h"
+#include "../src/scheduler/PriorityScheduler.h"
+#include "../src/scheduler/RoundRobinScheduler.h"
+#include "../src/scheduler/ConcurrencyLimitScheduler.h"
+#include "../src/core/Task.h"
+#include "../utils/Metrics.h"
+#include "../utils/ResultCache.h"
+#include "../utils/TraceRecorder.h"
+#include "../core/TaskRegistry.h"
+#include "../api/ApiServer.h"
+#include "../utils/Config.h"
+#include "../utils/RuntimeEstimator.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+using namespace std::chrono;
+
+class ThreadPoolTest : public ::testing::Test {
+protected:
+    // Task that blocks its worker until released
+    Task blocker(int id) {
+        return Task(id, TaskPriority::MEDIUM, [this]() {
+            while (!released.load()) {
+                std::this_thread::sleep_for(milliseconds(1));
+            }
+        });
+    }
+    
+    std::atomic<bool> released{false};
+};
+
+// Test Scheduler Swap Migrates Queued Tasks
+TEST_F(ThreadPoolTest, SwapSchedulerMigratesQueued) {
+    auto first = std::make_shared<RoundRobinScheduler>();
+    ThreadPool pool(1, first);
+    
+    std::atomic<int> ran{0};
+    pool.submit(blocker(1));
+    for (int i = 2; i <= 6; i++) {
+        pool.submit(Task(i, TaskPriority::LOW, [&ran]() { ran++; }));
+    }
+    std::this_thread::sleep_for(milliseconds(20));
+    
+    auto second = std::make_shared<PriorityScheduler>();
+    pool.setScheduler(second);
+    EXPECT_EQ(pool.getScheduler(), second);
+    EXPECT_TRUE(first->empty());
+    EXPECT_FALSE(second->empty());
+    
+    // New work goes to the new scheduler; nothing queued is lost
+    pool.submit(Task(7, TaskPriority::HIGH, [&ran]() { ran++; }));
+    released = true;
+    pool.shutdown();
+    EXPECT_EQ(ran.load(), 6);
+}
+
+// Test Scheduler Swap Keeps A Saturated Concurrency Key At Its Limit
+TEST_F(ThreadPoolTest, SwapSchedulerKeepsConcurrencySlots) {
+    auto first = std::make_shared<ConcurrencyLimitScheduler>(std::make_shared<RoundRobinScheduler>());
+    ThreadPool pool(3, first);
+    
+    std::atomic<int> active{0};
+    std::atomic<int> peak{0};
+    auto limited = [&](int id) {
+        Task task(id, TaskPriority::MEDIUM, [&]() {
+            int now = ++active;
+            int seen = peak.load();
+            while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+            }
+            while (!released.load()) {
+                std::this_thread::sleep_for(milliseconds(1));
+            }
+            --active;
+        });
+        task.setConcurrencyLimit("export", 1);
+        return task;
+    };
+    
+    pool.submit(limited(1));
+    pool.submit(limited(2));
+    std::this_thread::sleep_for(milliseconds(30));
+    EXPECT_EQ(first->getRunning("export"), 1);
+    EXPECT_EQ(first->getWaiting("export"), 1u);
+    
+    // Task 1 still holds the slot and reports back to the old instance
+    auto second = std::make_shared<ConcurrencyLimitScheduler>(std::make_shared<PriorityScheduler>());
+    pool.setScheduler(second);
+    pool.submit(limited(3));
+    std::this_thread::sleep_for(milliseconds(30));
+    EXPECT_EQ(active.load(), 1);
+    EXPECT_EQ(second->getRunning("export"), 1);
+    EXPECT_EQ(second->getWaiting("export"), 2u);
+    
+    released = true;
+    pool.shutdown();
+    EXPECT_EQ(peak.load(), 1);
+    EXPECT_EQ(second->getRunning("export"), 0);
+}
+
+// Test Resize Grows And Shrinks The Worker Set
+TEST_F(ThreadPoolTest, ResizeLive) {
+    ThreadPool pool(1);
+    EXPECT_EQ(pool.getSize(), 1u);
+    
+    std::mutex mtx;
+    std::set<std::thread::id> threads;
+    auto record = [&]() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            threads.insert(std::this_thread::get_id());
+        }
+        std::this_thread::sleep_for(milliseconds(20));
+    };
+    
+    pool.resize(4);
+    EXPECT_EQ(pool.getSize(), 4u);
+    for (int i = 0; i < 8; i++) {
+        pool.submit(Task(i, TaskPriority::MEDIUM, record));
+    }
+    std::this_thread::sleep_for(milliseconds(100));
+    EXPECT_GT(threads.size(), 1u);
+    
+    pool.resize(1);
+    EXPECT_EQ(pool.getSize(), 1u);
+    std::this_thread::sleep_for(milliseconds(100));
+    
+    // Work still completes on the remaining worker
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 5; i++) {
+        pool.submit(Task(100 + i, TaskPriority::MEDIUM, [&ran]() { ran++; }));
+    }
+    pool.shutdown();
+    EXPECT_EQ(ran.load(), 5);
+}
+
+// Test Named Queues Run On Their Own Pools With Separate Stats
+TEST_F(ThreadPoolTest, QueueRegistryIsolatesQueues) {
+    auto registry = std::make_shared<QueueRegistry>(std::make_shared<ThreadPool>(1));
+    EXPECT_TRUE(registry->add("reports", std::make_shared<ThreadPool>(1)));
+    EXPECT_FALSE(registry->add("reports", std::make_shared<ThreadPool>(1)));
+    EXPECT_EQ(registry->get(""), registry->getDefault());
+    EXPECT_EQ(registry->get("missing"), nullptr);
+    
+    // A blocked report queue does not hold up the default queue
+    registry->get("reports")->submit(blocker(1));
+    registry->get("reports")->submit(Task(2, TaskPriority::MEDIUM, []() {}));
+    std::atomic<int> ran{0};
+    for (int i = 10; i < 15; i++) {
+        registry->getDefault()->submit(Task(i, TaskPriority::MEDIUM, [&ran]() { ran++; }));
+    }
+    std::this_thread::sleep_for(milliseconds(50));
+    EXPECT_EQ(ran.load(), 5);
+    
+    auto reports = registry->get("reports")->getStats();
+    EXPECT_EQ(reports.submitted, 2u);
+    EXPECT_EQ(reports.queued, 1u);
+    EXPECT_EQ(reports.completed, 0u);
+    EXPECT_EQ(registry->getDefault()->getStats().completed, 5u);
+    
+    released = true;
+    registry->shutdownAll();
+    EXPECT_EQ(registry->get("reports")->getStats().completed, 2u);
+}
+
+// Test Identical Pending Tasks Are Coalesced Until Dispatch
+TEST_F(ThreadPoolTest, DedupCoalescesPending) {
+    ThreadPool pool(1);
+    pool.submit(blocker(1));
+    std::this_thread::sleep_for(milliseconds(20));
+    
+    std::atomic<int> ran{0};
+    auto copy = [&ran](int id) {
+        Task task(id, TaskPriority::MEDIUM, [&ran]() { ran++; });
+        task.setDedupKey("export#42");
+        return task;
+    };
+    EXPECT_EQ(pool.submit(copy(2)), 2);
+    EXPECT_EQ(pool.submit(copy(3)), 2);
+    EXPECT_EQ(pool.submit(copy(4)), 2);
+    EXPECT_EQ(pool.getStats().coalesced, 2u);
+    
+    released = true;
+    std::this_thread::sleep_for(milliseconds(50));
+    EXPECT_EQ(ran.load(), 1);
+    
+    // Dispatched: the key is free again
+    EXPECT_EQ(pool.submit(copy(5)), 5);
+    pool.shutdown();
+    EXPECT_EQ(ran.load(), 2);
+}
+
+// Test A Dropped Pending Task Frees Its Dedup Key
+TEST_F(ThreadPoolTest, DedupKeyExpiresWithTask) {
+    DedupIndex index;
+    {
+        Task first(1, TaskPriority::MEDIUM, []() {});
+        first.setDedupKey("k");
+        EXPECT_FALSE(index.claim(first).has_value());
+        
+        Task second(2, TaskPriority::MEDIUM, []() {});
+        second.setDedupKey("k");
+        EXPECT_EQ(index.claim(second).value_or(0), 1);
+    }
+    
+    Task third(3, TaskPriority::MEDIUM, []() {});
+    third.setDedupKey("k");
+    EXPECT_FALSE(index.claim(third).has_value());
+    index.release(third);
+    EXPECT_EQ(index.size(), 0u);
+}
+
+// Test Claims Ended Without Dispatch Leave No Index Entry Behind
+TEST_F(ThreadPoolTest, DedupEntriesErasedWhenClaimEnds) {
+    DedupIndex index;
+    std::vector<Task> tasks;
+    for (int id = 1; id <= 3; id++) {
+        Task task(id, TaskPriority::MEDIUM, []() {});
+        task.setDedupKey("unique#" + std::to_string(id));
+        task.markReady();
+        EXPECT_FALSE(index.claim(task).has_value());
+        tasks.push_back(task);
+    }
+    EXPECT_EQ(index.size(), 3u);
+    
+    tasks[0].markRejected("shed");
+    tasks[1].markCancelled();
+    tasks[2].markFailed();
+    EXPECT_EQ(index.size(), 0u);
+}
+
+// Test A Cancelled Pending Task Frees Its Dedup Key While Still Registered
+TEST_F(ThreadPoolTest, DedupKeyFreedOnCancel) {
+    TaskRegistry::instance().clear();
+    ThreadPool pool(1);
+    pool.submit(blocker(1));
+    std::this_thread::sleep_for(milliseconds(20));
+    
+    auto copy = [](int id) {
+        Task task(id, TaskPriority::MEDIUM, []() {});
+        task.setDedupKey("report#7");
+        return task;
+    };
+    Task first = copy(2);
+    TaskRegistry::instance().registerTask(first);
+    EXPECT_EQ(pool.submit(first), 2);
+    EXPECT_EQ(pool.submit(copy(3)), 2);
+    
+    // The registry still shares task 2's control block, claim included
+    EXPECT_TRUE(pool.cancel(2));
+    EXPECT_EQ(TaskRegistry::instance().getTask(2)->getState(), TaskState::CANCELLED);
+    EXPECT_EQ(pool.submit(copy(4)), 4);
+    
+    released = true;
+    pool.shutdown();
+    EXPECT_EQ(pool.getStats().coalesced, 1u);
+    TaskRegistry::instance().clear();
+}
+
+// Test A Result Cache Hit Completes Without A Worker
+TEST_F(ThreadPoolTest, ResultCacheSkipsWorker) {
+    ResultCache& cache = ResultCache::instance();
+    cache.clear();
+    cache.configure(16, milliseconds(60000), {"hash"});
+    
+    std::atomic<int> ran{0};
+    auto make = [&ran](int id, std::size_t params) {
+        Task task(id, TaskPriority::MEDIUM, [&ran]() { ran++; });
+        task.setType("hash");
+        task.setParamsHash(params);
+        return task;
+    };
+    
+    ThreadPool pool(1);
+    pool.submit(make(1, 7));
+    std::this_thread::sleep_for(milliseconds(50));
+    EXPECT_EQ(ran.load(), 1);
+    
+    // Same type + params: served from the cache; other params still run
+    pool.submit(make(2, 7));
+    pool.submit(make(3, 8));
+    pool.shutdown();
+    EXPECT_EQ(ran.load(), 2);
+    EXPECT_EQ(pool.getStats().cached, 1u);
+    EXPECT_EQ(cache.getStats().hits, 1u);
+    EXPECT_GT(cache.getStats().bytes, 0u);
+    
+    cache.configure(0, milliseconds(60000), {});
+    cache.clear();
+}
+
+// Test A Cache Hit Frees Its Dedup Key
+TEST_F(ThreadPoolTest, ResultCacheHitFreesDedupKey) {
+    ResultCache& cache = ResultCache::instance();
+    cache.clear();
+    cache.configure(16, milliseconds(60000), {"hash"});
+    TaskRegistry::instance().clear();
+    
+    std::atomic<int> ran{0};
+    auto make = [&ran](int id) {
+        Task task(id, TaskPriority::MEDIUM, [&ran]() { ran++; });
+        task.setType("hash");
+        task.setParamsHash(7);
+        task.setDedupKey("hash#7");
+        TaskRegistry::instance().registerTask(task);
+        return task;
+    };
+    
+    ThreadPool pool(1);
+    EXPECT_EQ(pool.submit(make(1)), 1);
+    std::this_thread::sleep_for(milliseconds(50));
+    
+    // Each repeat is answered by the cache, never coalesced into a finished task
+    EXPECT_EQ(pool.submit(make(2)), 2);
+    EXPECT_EQ(pool.submit(make(3)), 3);
+    pool.shutdown();
+    EXPECT_EQ(ran.load(), 1);
+    EXPECT_EQ(pool.getStats().cached, 2u);
+    EXPECT_EQ(pool.getStats().coalesced, 0u);
+    
+    TaskRegistry::instance().clear();
+    cache.configure(0, milliseconds(60000), {});
+    cache.clear();
+}
+
+// Test Result Cache TTL And Frequency-Based Admission
+TEST_F(ThreadPoolTest, ResultCacheTtlAndAdmission) {
+    ResultCache& cache = ResultCache::instance();
+    cache.clear();
+    cache.configure(2, milliseconds(30), {"t"});
+    
+    cache.put("a", "1");
+    EXPECT_EQ(cache.get("a").value_or(""), "1");
+    std::this_thread::sleep_for(milliseconds(40));
+    EXPECT_FALSE(cache.get("a").has_value());
+    EXPECT_EQ(cache.getStats().entries, 0u);
+    
+    // Full of popular keys: a one-off key is refused, a frequent one gets in
+    cache.configure(2, milliseconds(60000), {"t"});
+    cache.put("hot1", "");
+    cache.put("hot2", "");
+    for (int i = 0; i < 3; i++) {
+        cache.get("hot1");
+        cache.get("hot2");
+    }
+    cache.put("once", "");
+    EXPECT_FALSE(cache.get("once").has_value());
+    EXPECT_EQ(cache.getStats().rejections, 1u);
+    
+    for (int i = 0; i < 6; i++) {
+        cache.get("popular");
+    }
+    cache.put("popular", "");
+    EXPECT_TRUE(cache.get("popular").has_value());
+    EXPECT_EQ(cache.getStats().evictions, 1u);
+    EXPECT_EQ(cache.getStats().entries, 2u);
+    
+    cache.configure(0, milliseconds(60000), {});
+    cache.clear();
+}
+
+// Test The Registry Sees The Executor's State Without Copies
+TEST_F(ThreadPoolTest, RegistrySeesLiveState) {
+    TaskRegistry::instance().clear();
+    ThreadPool pool(1);
+    
+    Task task = blocker(1);
+    pool.submit(task);
+    TaskRegistry::instance().registerTask(task);
+    std::this_thread::sleep_for(milliseconds(20));
+    EXPECT_EQ(TaskRegistry::instance().getTask(1)->getState(), TaskState::RUNNING);
+    
+    released = true;
+    pool.shutdown();
+    EXPECT_EQ(TaskRegistry::instance().getTask(1)->getState(), TaskState::COMPLETED);
+    TaskRegistry::instance().clear();
+}
+
+// Test Trace Recorder - Attempts Land In The Worker's Bounded Ring
+TEST_F(ThreadPoolTest, TraceRecordsAttempts) {
+    TraceRecorder& recorder = TraceRecorder::instance();
+    auto eventsOf = [&recorder](int taskId) {
+        std::vector<TraceEvent> found;
+        for (const auto& thread : recorder.collect(seconds(60))) {
+            for (const auto& event : thread.events) {
+                if (event.taskId == taskId) {
+                    found.push_back(event);
+                }
+            }
+        }
+        return found;
+    };
+    
+    recorder.configure(true, 16);
+    {
+        ThreadPool pool(1);
+        Task flaky(901, TaskPriority::HIGH, []() { throw std::runtime_error("flaky"); }, 1);
+        flaky.setType("trace-flaky");
+        pool.submit(flaky);
+        pool.shutdown();
+    }
+    // The worker has exited; its ring is retired but still collected
+    std::vector<TraceEvent> attempts = eventsOf(901);
+    ASSERT_EQ(attempts.size(), 2u);
+    EXPECT_EQ(attempts[0].attempt, 1);
+    EXPECT_EQ(attempts[0].outcome, TraceOutcome::RETRIED);
+    EXPECT_EQ(attempts[1].attempt, 2);
+    EXPECT_EQ(attempts[1].outcome, TraceOutcome::FAILED);
+    ASSERT_NE(attempts[1].key, nullptr);
+    EXPECT_EQ(attempts[1].key->type, "trace-flaky");
+    for (const auto& event : attempts) {
+        EXPECT_LE(event.enqueueUs, event.startUs);
+        EXPECT_LE(event.startUs, event.endUs);
+    }
+    EXPECT_GE(attempts[1].enqueueUs, attempts[0].endUs);
+    
+    // A ring keeps only its newest events
+    recorder.configure(true, 2);
+    {
+        ThreadPool pool(1);
+        for (int i = 911; i <= 915; i++) {
+            pool.submit(Task(i, TaskPriority::LOW, []() {}));
+        }
+        pool.shutdown();
+    }
+    recorder.configure(false, 16384);
+    EXPECT_TRUE(eventsOf(911).empty());
+    EXPECT_EQ(eventsOf(915).size(), 1u);
+    for (const auto& thread : recorder.collect(seconds(60))) {
+        EXPECT_LE(thread.events.size(), 16u);
+    }
+}
+
+// Test A Config Reload Applies The Estimator Section
+TEST_F(ThreadPoolTest, ReloadAppliesEstimatorConfig) {
+    const std::string path = "test_reload_estimator.conf";
+    auto write = [&path](const std::string& perParams) {
+        std::ofstream file(path);
+        file << "estimator_alpha=1.0\n";
+        file << "estimator_per_params=" << perParams << "\n";
+    };
+    write("false");
+    Config::instance().loadFromFile(path);
+    RuntimeEstimator& estimator = RuntimeEstimator::instance();
+    estimator.clear();
+    
+    auto queues = std::make_shared<QueueRegistry>(std::make_shared<ThreadPool>(1));
+    ApiServer server(queues, 0);
+    write("true");
+    server.reloadConfig();
+    
+    // Per-params estimates are only kept once the reload turned them on
+    estimator.record("reload_type", 9, milliseconds(40));
+    EXPECT_EQ(estimator.getEstimate("reload_type", 9).samples, 1u);
+    
+    write("false");
+    server.reloadConfig();
+    queues->shutdownAll();
+    estimator.configure(0.2, false);
+    estimator.clear();
+    std::remove(path.c_str());
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "../src/executor/TimerWheel.h"
+#include "../src/executor/ThreadPool.h"
+#include "../src/core/Task.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+class TimerWheelTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        start = steady_clock::now();
+    }
+    
+    // Advance the wheel and run everything that became due
+    int fire(TimerWheel& wheel, milliseconds at) {
+        auto due = wheel.advance(start + at);
+        for (auto& cb : due) {
+            cb();
+        }
+        return static_cast<int>(due.size());
+    }
+    
+    steady_clock::time_point start;
+};
+
+// Test Timers Fire At Their Due Tick, Not Before
+TEST_F(TimerWheelTest, FiresWhenDue) {
+    TimerWheel wheel(start);
+    std::vector<int> fired;
+    
+    wheel.schedule(start + milliseconds(10), [&fired]() { fired.push_back(10); });
+    wheel.schedule(start + milliseconds(5), [&fired]() { fired.push_back(5); });
+    EXPECT_EQ(wheel.size(), 2u);
+    
+    EXPECT_EQ(fire(wheel, milliseconds(4)), 0);
+    EXPECT_EQ(fire(wheel, milliseconds(5)), 1);
+    EXPECT_EQ(fire(wheel, milliseconds(9)), 0);
+    EXPECT_EQ(fire(wheel, milliseconds(10)), 1);
+    
+    EXPECT_EQ(fired, (std::vector<int>{5, 10}));
+    EXPECT_TRUE(wheel.empty());
+}
+
+// Test Timers Beyond The Root Level Cascade Down With Millisecond Precision
+TEST_F(TimerWheelTest, CascadesAcrossLevels) {
+    TimerWheel wheel(start);
+    std::vector<long long> dues = {255, 256, 300, 16383, 16384, 70000, 1048576 + 3};
+    int firedCount = 0;
+    
+    for (long long due : dues) {
+        wheel.schedule(start + milliseconds(due), [&firedCount]() { firedCount++; });
+    }
+    
+    for (long long due : dues) {
+        EXPECT_EQ(fire(wheel, milliseconds(due - 1)), 0) << "fired early at " << due;
+        EXPECT_EQ(fire(wheel, milliseconds(due)), 1) << "did not fire at " << due;
+    }
+    EXPECT_EQ(firedCount, static_cast<int>(dues.size()));
+    EXPECT_TRUE(wheel.empty());
+}
+
+// Test Next Expiry Is Exact At The Root Level And Never Late Above It
+TEST_F(TimerWheelTest, NextExpiry) {
+    TimerWheel wheel(start);
+    EXPECT_EQ(wheel.nextExpiry(), steady_clock::time_point::max());
+
+    wheel.schedule(start + milliseconds(70000), []() {});
+    wheel.schedule(start + milliseconds(40), []() {});
+    EXPECT_EQ(wheel.nextExpiry(), start + milliseconds(40));
+    EXPECT_EQ(fire(wheel, milliseconds(40)), 1);
+
+    // Waking only at each expiry reaches the far timer in a few cascades
+    int wakeups = 0;
+    int fired = 0;
+    while (!wheel.empty()) {
+        auto next = wheel.nextExpiry();
+        ASSERT_LE(next, start + milliseconds(70000));
+        fired += fire(wheel, duration_cast<milliseconds>(next - start));
+        wakeups++;
+    }
+    EXPECT_EQ(fired, 1);
+    EXPECT_LE(wakeups, 4);
+}
+
+// Test Past Due Times Fire On The Next Tick
+TEST_F(TimerWheelTest, PastDueFiresNextTick) {
+    TimerWheel wheel(start);
+    fire(wheel, milliseconds(100));
+    
+    wheel.schedule(start + milliseconds(50), []() {});
+    EXPECT_EQ(fire(wheel, milliseconds(101)), 1);
+}
+
+// Test Many Timers In The Same Slot
+TEST_F(TimerWheelTest, ManyTimersSameTick) {
+    TimerWheel wheel(start);
+    for (int i = 0; i < 1000; i++) {
+        wheel.schedule(start + milliseconds(2000), []() {});
+    }
+    EXPECT_EQ(fire(wheel, milliseconds(1999)), 0);
+    EXPECT_EQ(fire(wheel, milliseconds(2000)), 1000);
+}
+
+// Test ThreadPool Holds Delayed Tasks Until Their Start Time
+TEST_F(TimerWheelTest, ThreadPoolDelayedSubmit) {
+    ThreadPool pool(2);
+    std::atomic<bool> ran{false};
+    
+    Task task(1, TaskPriority::MEDIUM, [&ran]() { ran = true; }, 0);
+    task.setRunAt(steady_clock::now() + milliseconds(100));
+    pool.submit(task);
+    
+    std::this_thread::sleep_for(milliseconds(30));
+    EXPECT_FALSE(ran.load());
+    EXPECT_EQ(pool.getPendingTimers(), 1u);
+    
+    auto deadline = steady_clock::now() + seconds(2);
+    while (!ran.load() && steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(milliseconds(5));
+    }
+    EXPECT_TRUE(ran.load());
+    EXPECT_EQ(pool.getPendingTimers(), 0u);
+    pool.shutdown();
+}
@@ -55,11 +55,20 @@ void Config::validateAndSetMaxRetries(int value) {
     }
 }
 
+bool Config::isKnownScheduler(const std::string& value) {
+    std::string lower = value;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    return lower == "priority" || lower == "edf" || lower == "mlfq" || lower == "sjf" ||
+           lower == "roundrobin" || lower == "round-robin";
+}
+
 void Config::validateAndSetScheduler(const std::string& value) {
     std::string lower = value;
     std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-    if (lower == "priority" || lower == "roundrobin" || lower == "round-robin") {
-        scheduler = (lower == "priority") ? "priority" : "roundrobin";
+    if (lower == "roundrobin" || lower == "round-robin") {
+        scheduler = "roundrobin";
+    } else if (isKnownScheduler(lower)) {
+        scheduler = lower;
     } else {
         Logger::warn("Invalid scheduler: " + value + ". Using default: roundrobin");
         scheduler = "roundrobin";
@@ -77,6 +86,115 @@ void Config::validateAndSetMode(const std::string& value) {
     }
 }
 
+void Config::validateAndSetEdfMissPolicy(const std::string& value) {
+    std::string lower = value;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    if (lower == "demote" || lower == "drop") {
+        edfMissPolicy = lower;
+    } else {
+        Logger::warn("Invalid edf_miss_policy: " + value + ". Using default: demote");
+        edfMissPolicy = "demote";
+    }
+}
+
+void Config::validateAndSetMillis(const std::string& key, int value, int& target, int defaultValue) {
+    if (value < 1 || value > 24 * 60 * 60 * 1000) {
+        Logger::warn("Invalid " + key + ": " + std::to_string(value) +
+                     ". Using default: " + std::to_string(defaultValue));
+        target = defaultValue;
+    } else {
+        target = value;
+    }
+}
+
+void Config::validateAndSetCircuitBreaker(const std::string& key, const std::string& value) {
+    auto rangeInt = [&](int& target, int lo, int hi, int defaultValue) {
+        int parsed = std::stoi(value);
+        if (parsed >= lo && parsed <= hi) {
+            target = parsed;
+        } else {
+            Logger::warn("Invalid " + key + ": " + value + ". Using default: " + std::to_string(defaultValue));
+            target = defaultValue;
+        }
+    };
+
+    if (key == "circuit_breaker_enabled") {
+        circuitBreaker.enabled = (value == "true" || value == "1");
+    } else if (key == "circuit_breaker_window") {
+        rangeInt(circuitBreaker.window, 1, 10000, 20);
+    } else if (key == "circuit_breaker_min_calls") {
+        rangeInt(circuitBreaker.minCalls, 1, 10000, 10);
+    } else if (key == "circuit_breaker_probes") {
+        rangeInt(circuitBreaker.probes, 1, 1000, 1);
+    } else if (key == "circuit_breaker_open_ms") {
+        validateAndSetMillis(key, std::stoi(value), circuitBreaker.openMs, 5000);
+    } else if (key == "circuit_breaker_failure_rate") {
+        double rate = std::stod(value);
+        if (rate > 0.0 && rate <= 1.0) {
+            circuitBreaker.failureRate = rate;
+        } else {
+            Logger::warn("Invalid " + key + ": " + value + ". Using default: 0.5");
+            circuitBreaker.failureRate = 0.5;
+        }
+    } else if (key == "circuit_breaker_mode") {
+        if (value == "park" || value == "fail") {
+            circuitBreaker.failFast = (value == "fail");
+        } else {
+            Logger::warn("Invalid " + key + ": " + value + ". Must be 'park' or 'fail'. Using default: park");
+            circuitBreaker.failFast = false;
+        }
+    } else {
+        Logger::warn("Unknown config key: " + key);
+    }
+}
+
+// Value is "<rate>" or "<rate>,<burst>"; burst defaults to max(1, rate)
+void Config::validateAndSetRateLimit(const std::string& key, const std::string& value,
+                                     std::map<std::string, RateLimit>& target) {
+    std::string name = key.substr(key.find('.', std::string("rate_limit.").size()) + 1);
+    RateLimit limit;
+    std::size_t comma = value.find(',');
+    limit.rate = std::stod(value.substr(0, comma));
+    limit.burst = comma == std::string::npos ? (limit.rate < 1.0 ? 1.0 : limit.rate)
+                                             : std::stod(value.substr(comma + 1));
+
+    if (name.empty() || limit.rate <= 0.0 || limit.burst < 1.0) {
+        Logger::warn("Invalid " + key + ": " + value + ". Ignoring");
+        return;
+    }
+    target[name] = limit;
+}
+
+// queue.<name>.threads=N or queue.<name>.scheduler=TYPE
+void Config::validateAndSetQueueSetting(const std::string& key, const std::string& value) {
+    std::size_t dot = key.rfind('.');
+    std::string name = key.substr(6, dot - 6);
+    std::string setting = key.substr(dot + 1);
+
+    if (name.empty() || name == "default") {
+        Logger::warn("Invalid queue name in " + key + ". The default queue uses threads/scheduler");
+        return;
+    }
+    if (setting == "threads") {
+        int count = std::stoi(value);
+        if (count < 1 || count > 128) {
+            Logger::warn("Invalid " + key + ": " + value + ". Must be between 1 and 128");
+            return;
+        }
+        queues[name].threads = count;
+    } else if (setting == "scheduler") {
+        if (!isKnownScheduler(value)) {
+            Logger::warn("Invalid " + key + ": " + value + ". Inheriting scheduler");
+            return;
+        }
+        std::string lower = value;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        queues[name].scheduler = lower == "round-robin" ? "roundrobin" : lower;
+    } else {
+        Logger::warn("Unknown queue setting: " + key);
+    }
+}
+
 void Config::loadFromEnvironment() {
     std::string envThreads = getEnvVar("TASKWEAVE_THREADS");
     if (!envThreads.empty()) {
@@ -134,6 +252,7 @@ void Config::loadFromEnvironment() {
 }
 
 void Config::loadFromFile(const std::string& path) {
+    configPath = path;
     std::ifstream file(path);
     if (!file.is_open()) {
         Logger::warn("Config file not found: " + path + ". Using defaults.");
@@ -187,6 +306,95 @@ void Config::loadFromFile(const std::string& path) {
                         }
                     } else if (key == "cors_origin") {
                         corsOrigin = value;
+                    } else if (key == "edf_miss_policy") {
+                        validateAndSetEdfMissPolicy(value);
+                    } else if (key == "mlfq_aging_ms") {
+                        validateAndSetMillis(key, std::stoi(value), mlfqAgingMs, 1000);
+                    } else if (key == "mlfq_long_run_ms") {
+                        validateAndSetMillis(key, std::stoi(value), mlfqLongRunMs, 500);
+                    } else if (key == "sjf_aging_rate") {
+                        double rate = std::stod(value);
+                        if (rate > 0.0 && rate <= 1000.0) {
+                            sjfAgingRate = rate;
+                        } else {
+                            Logger::warn("Invalid sjf_aging_rate: " + value + ". Using default: 0.1");
+                        }
+                    } else if (key == "estimator_alpha") {
+                        double alpha = std::stod(value);
+                        if (alpha > 0.0 && alpha <= 1.0) {
+                            estimatorAlpha = alpha;
+                        } else {
+                            Logger::warn("Invalid estimator_alpha: " + value + ". Using default: 0.2");
+                        }
+                    } else if (key == "estimator_per_params") {
+                        estimatorPerParams = (value == "true" || value == "1");
+                    } else if (key == "codel_enabled") {
+                        codelEnabled = (value == "true" || value == "1");
+                    } else if (key == "codel_drain_guard") {
+                        codelDrainGuard = (value == "true" || value == "1");
+                    } else if (key == "codel_target_ms") {
+                        validateAndSetMillis(key, std::stoi(value), codelTargetMs, 100);
+                    } else if (key == "codel_interval_ms") {
+                        validateAndSetMillis(key, std::stoi(value), codelIntervalMs, 1000);
+                    } else if (key.rfind("circuit_breaker_", 0) == 0) {
+                        validateAndSetCircuitBreaker(key, value);
+                    } else if (key == "result_cache_types") {
+                        resultCacheTypes.clear();
+                        std::stringstream types(value);
+                        std::string type;
+                        while (std::getline(types, type, ',')) {
+                            type.erase(0, type.find_first_not_of(" \t"));
+                            type.erase(type.find_last_not_of(" \t") + 1);
+                            if (!type.empty()) {
+                                resultCacheTypes.insert(type);
+                            }
+                        }
+                    } else if (key == "result_cache_capacity") {
+                        int capacity = std::stoi(value);
+                        if (capacity >= 0 && capacity <= 10000000) {
+                            resultCacheCapacity = capacity;
+                        } else {
+                            Logger::warn("Invalid result_cache_capacity: " + value + ". Using default: 1024");
+                        }
+                    } else if (key == "result_cache_ttl_ms") {
+                        validateAndSetMillis(key, std::stoi(value), resultCacheTtlMs, 60000);
+                    } else if (key == "task_ids") {
+                        if (value == "client" || value == "server") {
+                            serverAssignedIds = value == "server";
+                        } else {
+                            Logger::warn("Invalid task_ids: " + value + ". Using default: client");
+                        }
+                    } else if (key == "snapshot_interval_ms") {
+                        validateAndSetMillis(key, std::stoi(value), snapshotIntervalMs, 100);
+                    } else if (key == "registry_max_finished") {
+                        int limit = std::stoi(value);
+                        if (limit >= 0) {
+                            registryMaxFinished = limit;
+                        } else {
+                            Logger::warn("Invalid registry_max_finished: " + value + ". Using default: 10000");
+                        }
+                    } else if (key == "metrics_max_keys") {
+                        int limit = std::stoi(value);
+                        if (limit >= 0) {
+                            metricsMaxKeys = limit;
+                        } else {
+                            Logger::warn("Invalid metrics_max_keys: " + value + ". Using default: 1000");
+                        }
+                    } else if (key == "trace_enabled") {
+                        traceEnabled = (value == "true" || value == "1");
+                    } else if (key == "trace_events_per_thread") {
+                        int events = std::stoi(value);
+                        if (events > 0) {
+                            traceEventsPerThread = events;
+                        } else {
+                            Logger::warn("Invalid trace_events_per_thread: " + value + ". Using default: 16384");
+                        }
+                    } else if (key.rfind("queue.", 0) == 0 && key.rfind('.') > 6) {
+                        validateAndSetQueueSetting(key, value);
+                    } else if (key.rfind("rate_limit.type.", 0) == 0) {
+                        validateAndSetRateLimit(key, value, typeRateLimits);
+                    } else if (key.rfind("rate_limit.tenant.", 0) == 0) {
+                        validateAndSetRateLimit(key, value, tenantRateLimits);
                     } else {
                         Logger::warn("Unknown config key: " + key + " at line " + std::to_string(lineNum));
                     }
@@ -199,8 +407,8 @@ void Config::loadFromFile(const std::string& path) {
 }
 
 void Config::loadFromArgs(int argc, char* argv[]) {
-    for (int i = 1; i < argc; ++i) {
-        std::string arg(argv[i]);
+    args.assign(argv + (argc > 0 ? 1 : 0), argv + argc);
+    for (const auto& arg : args) {
 
         try {
             if (arg.find("--threads=") == 0)
@@ -220,15 +428,18 @@ void Config::loadFromArgs(int argc, char* argv[]) {
                 }
             } else if (arg.find("--cors-origin=") == 0) {
                 corsOrigin = arg.substr(14);
+            } else if (arg.find("--edf-miss-policy=") == 0) {
+                validateAndSetEdfMissPolicy(arg.substr(18));
             } else if (arg == "--help" || arg == "-h") {
                 std::cout << "TaskWeave Configuration Options:\n"
                           << "  --threads=N              Number of worker threads (1-128)\n"
-                          << "  --scheduler=TYPE         Scheduler type (priority|roundrobin)\n"
+                          << "  --scheduler=TYPE         Scheduler type (priority|roundrobin|edf|mlfq|sjf)\n"
                           << "  --max-retries=N          Maximum retry attempts (0-100)\n"
                           << "  --api-port=N             API server port (1024-65535)\n"
                           << "  --mode=MODE              Mode (demo|api)\n"
                           << "  --max-request-size=N     Max request size in bytes\n"
                           << "  --cors-origin=ORIGIN     CORS origin (default: *)\n"
+                          << "  --edf-miss-policy=P      EDF late-task policy (demote|drop)\n"
                           << "\nEnvironment Variables:\n"
                           << "  TASKWEAVE_THREADS, TASKWEAVE_API_PORT, TASKWEAVE_SCHEDULER,\n"
                           << "  TASKWEAVE_MODE, TASKWEAVE_MAX_RETRIES, TASKWEAVE_CORS_ORIGIN\n";
@@ -239,6 +450,34 @@ void Config::loadFromArgs(int argc, char* argv[]) {
     }
 }
 
+void Config::reload() {
+    // Rate limits, queues and cache types exist only in the file; a removed line removes them
+    typeRateLimits.clear();
+    tenantRateLimits.clear();
+    queues.clear();
+    resultCacheTypes.clear();
+
+    std::vector<std::string> savedArgs = args;
+    std::vector<char*> argv{const_cast<char*>("taskweave")};
+    for (auto& arg : savedArgs) {
+        argv.push_back(&arg[0]);
+    }
+
+    if (!configPath.empty()) {
+        loadFromFile(configPath);
+    }
+    loadFromEnvironment();
+    loadFromArgs(static_cast<int>(argv.size()), argv.data());
+}
+
+void Config::setThreads(int value) {
+    validateAndSetThreads(value);
+}
+
+void Config::setScheduler(const std::string& value) {
+    validateAndSetScheduler(value);
+}
+
 int Config::getThreads() const {
     return threads;
 }
@@ -275,6 +514,108 @@ bool Config::isValidationEnabled() const {
     return validationEnabled;
 }
 
+std::string Config::getEdfMissPolicy() const {
+    return edfMissPolicy;
+}
+
+int Config::getMlfqAgingMs() const {
+    return mlfqAgingMs;
+}
+
+int Config::getMlfqLongRunMs() const {
+    return mlfqLongRunMs;
+}
+
+double Config::getSjfAgingRate() const {
+    return sjfAgingRate;
+}
+
+double Config::getEstimatorAlpha() const {
+    return estimatorAlpha;
+}
+
+bool Config::isEstimatorPerParams() const {
+    return estimatorPerParams;
+}
+
+const std::set<std::string>& Config::getResultCacheTypes() const {
+    return resultCacheTypes;
+}
+
+int Config::getSnapshotIntervalMs() const {
+    return snapshotIntervalMs;
+}
+
+bool Config::isServerAssignedIds() const {
+    return serverAssignedIds;
+}
+
+int Config::getRegistryMaxFinished() const {
+    return registryMaxFinished;
+}
+
+int Config::getMetricsMaxKeys() const {
+    return metricsMaxKeys;
+}
+
+bool Config::isTraceEnabled() const {
+    return traceEnabled;
+}
+
+int Config::getTraceEventsPerThread() const {
+    return traceEventsPerThread;
+}
+
+int Config::getResultCacheCapacity() const {
+    return resultCacheCapacity;
+}
+
+int Config::getResultCacheTtlMs() const {
+    return resultCacheTtlMs;
+}
+
+bool Config::isCodelEnabled() const {
+    return codelEnabled;
+}
+
+bool Config::isCodelDrainGuard() const {
+    return codelDrainGuard;
+}
+
+int Config::getCodelTargetMs() const {
+    return codelTargetMs;
+}
+
+int Config::getCodelIntervalMs() const {
+    return codelIntervalMs;
+}
+
+const CircuitBreakerConfig& Config::getCircuitBreaker() const {
+    return circuitBreaker;
+}
+
+const std::map<std::string, RateLimit>& Config::getTypeRateLimits() const {
+    return typeRateLimits;
+}
+
+const std::map<std::string, RateLimit>& Config::getTenantRateLimits() const {
+    return tenantRateLimits;
+}
+
+const std::map<std::string, QueueConfig>& Config::getQueues() const {
+    return queues;
+}
+
+int Config::getQueueThreads(const std::string& queue) const {
+    auto it = queues.find(queue);
+    return it != queues.end() && it->second.threads > 0 ? it->second.threads : threads;
+}
+
+std::string Config::getQueueScheduler(const std::string& queue) const {
+    auto it = queues.find(queue);
+    return it != queues.end() && !it->second.scheduler.empty() ? it->second.scheduler : scheduler;
+}
+
 bool Config::validate() const {
     bool valid = true;
     
@@ -295,7 +636,8 @@ bool Config::validate() const {
     
     std::string lowerSched = scheduler;
     std::transform(lowerSched.begin(), lowerSched.end(), lowerSched.begin(), ::tolower);
-    if (lowerSched != "priority" && lowerSched != "roundrobin" && lowerSched != "round-robin") {
+    if (lowerSched != "priority" && lowerSched != "roundrobin" && lowerSched != "round-robin" &&
+        lowerSched != "edf" && lowerSched != "mlfq" && lowerSched != "sjf") {
         Logger::error("Invalid scheduler: " + scheduler);
         valid = false;
     }
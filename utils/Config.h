@@ -1,5 +1,32 @@
 #pragma once
+#include <map>
+#include <set>
 #include <string>
+#include <vector>
+
+// Token bucket limit: `rate` tasks per second with bursts of up to `burst`
+struct RateLimit {
+    double rate = 0.0;
+    double burst = 1.0;
+};
+
+// A named queue with its own pool; 0 / empty inherit threads / scheduler
+struct QueueConfig {
+    int threads = 0;
+    std::string scheduler;
+};
+
+// Per-type circuit breaker: opens when at least `failureRate` of the last
+// `window` outcomes (and at least `minCalls`) failed
+struct CircuitBreakerConfig {
+    bool enabled = false;
+    int window = 20;
+    int minCalls = 10;
+    double failureRate = 0.5;
+    int openMs = 5000;     // cool-down before probing
+    int probes = 1;        // successful probes needed to close again
+    bool failFast = false; // reject instead of park while open
+};
 
 class Config {
 public:
@@ -9,6 +36,15 @@ public:
     void loadFromArgs(int argc, char* argv[]);
     void loadFromEnvironment();
 
+    // Re-read the last config file, then environment and arguments again (in
+    // that order). Keys removed from the file keep their current value.
+    void reload();
+
+    // Runtime overrides (admin API); invalid values fall back as on load
+    void setThreads(int value);
+    void setScheduler(const std::string& value);
+    static bool isKnownScheduler(const std::string& value);
+
     int getThreads() const;
     std::string getScheduler() const;
     int getMaxRetries() const;
@@ -18,6 +54,31 @@ public:
     int getMaxConnections() const;
     std::string getCorsOrigin() const;
     bool isValidationEnabled() const;
+    std::string getEdfMissPolicy() const;  // "demote" or "drop"
+    int getMlfqAgingMs() const;
+    int getMlfqLongRunMs() const;
+    double getSjfAgingRate() const;
+    double getEstimatorAlpha() const;
+    bool isEstimatorPerParams() const;
+    bool isCodelEnabled() const;
+    bool isCodelDrainGuard() const;  // don't start shedding while the queue drains
+    int getCodelTargetMs() const;
+    int getCodelIntervalMs() const;
+    const CircuitBreakerConfig& getCircuitBreaker() const;
+    const std::set<std::string>& getResultCacheTypes() const;  // deterministic types
+    int getResultCacheCapacity() const;
+    int getResultCacheTtlMs() const;
+    int getRegistryMaxFinished() const;  // 0 = keep every finished task in memory
+    bool isServerAssignedIds() const;    // task_ids=server: the API allocates task IDs
+    int getSnapshotIntervalMs() const;   // max age of the GET /tasks listing
+    int getMetricsMaxKeys() const;       // distinct (type, tenant) metric keys; 0 = no cap
+    bool isTraceEnabled() const;         // record task attempts for GET /debug/trace
+    int getTraceEventsPerThread() const;
+    const std::map<std::string, RateLimit>& getTypeRateLimits() const;
+    const std::map<std::string, RateLimit>& getTenantRateLimits() const;
+    const std::map<std::string, QueueConfig>& getQueues() const;  // besides "default"
+    int getQueueThreads(const std::string& queue) const;
+    std::string getQueueScheduler(const std::string& queue) const;
 
     // Validation
     bool validate() const;
@@ -29,8 +90,17 @@ private:
     void validateAndSetMaxRetries(int value);
     void validateAndSetScheduler(const std::string& value);
     void validateAndSetMode(const std::string& value);
+    void validateAndSetEdfMissPolicy(const std::string& value);
+    void validateAndSetCircuitBreaker(const std::string& key, const std::string& value);
+    void validateAndSetMillis(const std::string& key, int value, int& target, int defaultValue);
+    void validateAndSetQueueSetting(const std::string& key, const std::string& value);
+    void validateAndSetRateLimit(const std::string& key, const std::string& value,
+                                 std::map<std::string, RateLimit>& target);
     std::string getEnvVar(const std::string& name, const std::string& defaultValue = "") const;
 
+    std::string configPath;
+    std::vector<std::string> args;
+
     int threads = 2;
     std::string scheduler = "roundrobin";
     int maxRetries = 0;
@@ -40,4 +110,27 @@ private:
     int maxConnections = 100;
     std::string corsOrigin = "*";
     bool validationEnabled = true;
+    std::string edfMissPolicy = "demote";
+    int mlfqAgingMs = 1000;
+    int mlfqLongRunMs = 500;
+    double sjfAgingRate = 0.1;
+    double estimatorAlpha = 0.2;
+    bool estimatorPerParams = false;
+    bool codelEnabled = false;
+    bool codelDrainGuard = false;
+    int codelTargetMs = 100;
+    int codelIntervalMs = 1000;
+    CircuitBreakerConfig circuitBreaker;
+    std::set<std::string> resultCacheTypes;
+    int resultCacheCapacity = 1024;
+    int resultCacheTtlMs = 60000;
+    int registryMaxFinished = 10000;
+    bool serverAssignedIds = false;
+    int snapshotIntervalMs = 100;
+    int metricsMaxKeys = 1000;
+    bool traceEnabled = false;
+    int traceEventsPerThread = 16384;
+    std::map<std::string, RateLimit> typeRateLimits;    // rate_limit.type.<type>
+    std::map<std::string, RateLimit> tenantRateLimits;  // rate_limit.tenant.<tenant>
+    std::map<std::string, QueueConfig> queues;          // queue.<name>.threads / .scheduler
 };
@@ -331,6 +331,50 @@ std::vector<TaskRecord> Database::getTasksByDateRange(const std::string& /* star
     return getAllTasks(); // Simplified for now
 }
 
+bool Database::saveTasks(const std::vector<TaskRecord>& tasks) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!db) return false;
+    
+    std::string query = R"(
+        INSERT OR REPLACE INTO tasks (id, name, priority, max_retries, retry_count, state, type,
+                                      params_json, created_at, started_at, completed_at, thread_id,
+                                      error_message)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+    )";
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        return false;
+    }
+    
+    bool ok = executeQuery("BEGIN TRANSACTION");
+    for (const auto& task : tasks) {
+        if (!ok) break;
+        sqlite3_bind_int(stmt, 1, task.id);
+        sqlite3_bind_text(stmt, 2, task.name.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 3, task.priority.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_int(stmt, 4, task.max_retries);
+        sqlite3_bind_int(stmt, 5, task.retry_count);
+        sqlite3_bind_int(stmt, 6, task.state);
+        sqlite3_bind_text(stmt, 7, task.type.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 8, task.params_json.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 9, task.created_at.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 10, task.started_at.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 11, task.completed_at.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 12, task.thread_id.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 13, task.error_message.c_str(), -1, SQLITE_STATIC);
+        ok = sqlite3_step(stmt) == SQLITE_DONE;
+        sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+    
+    if (!ok) {
+        executeQuery("ROLLBACK");
+        return false;
+    }
+    return executeQuery("COMMIT");
+}
+
 bool Database::deleteTask(int id) {
     std::lock_guard<std::mutex> lock(mtx);
     if (!db) return false;
@@ -39,6 +39,8 @@ public:
     // Task operations
     bool createTask(const TaskRecord& task);
     bool updateTask(const TaskRecord& task);
+    // Insert or replace full records in one transaction
+    bool saveTasks(const std::vector<TaskRecord>& tasks);
     TaskRecord getTask(int id);
     std::vector<TaskRecord> getAllTasks();
     std::vector<TaskRecord> getTasksByState(int state);
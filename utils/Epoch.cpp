@@ -0,0 +1,107 @@
+#include "Epoch.h"
+
+Epoch& Epoch::instance() {
+    static Epoch epoch;
+    return epoch;
+}
+
+Epoch::~Epoch() {
+    // Process exit: no reader is left
+    for (auto& entry : retired) {
+        entry.second();
+    }
+}
+
+Epoch::SlotOwner::~SlotOwner() {
+    if (slot) {
+        slot->epoch.store(0);
+        slot->inUse.store(false);
+    }
+}
+
+Epoch::Slot& Epoch::localSlot() {
+    thread_local SlotOwner owner;
+    if (owner.slot) {
+        return *owner.slot;
+    }
+
+    // Reuse a slot left by an exited thread, else push a new one. Slots are
+    // never freed, so the list can be walked without protection.
+    for (Slot* slot = slots.load(); slot; slot = slot->next) {
+        bool expected = false;
+        if (!slot->inUse.load() && slot->inUse.compare_exchange_strong(expected, true)) {
+            owner.slot = slot;
+            return *slot;
+        }
+    }
+    Slot* slot = new Slot();
+    slot->inUse.store(true);
+    slot->next = slots.load();
+    while (!slots.compare_exchange_weak(slot->next, slot)) {
+    }
+    owner.slot = slot;
+    return *slot;
+}
+
+Epoch::Guard::Guard() : slot(&Epoch::instance().localSlot()) {
+    if (slot->depth++ == 0) {
+        slot->epoch.store(Epoch::instance().globalEpoch.load());
+        // Order the pin before this thread's reads of shared pointers
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+Epoch::Guard::~Guard() {
+    if (--slot->depth == 0) {
+        slot->epoch.store(0, std::memory_order_release);
+    }
+}
+
+void Epoch::retire(std::function<void()> deleter) {
+    {
+        std::lock_guard<std::mutex> lock(retireMtx);
+        retired.emplace_back(globalEpoch.load(), std::move(deleter));
+    }
+    collect();
+}
+
+std::size_t Epoch::collect() {
+    std::vector<std::function<void()>> freeing;
+    {
+        std::lock_guard<std::mutex> lock(retireMtx);
+        if (retired.empty()) {
+            return 0;
+        }
+
+        // Readers pinned from now on cannot see anything retired so far
+        std::uint64_t oldest = globalEpoch.fetch_add(1) + 1;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (Slot* slot = slots.load(); slot; slot = slot->next) {
+            std::uint64_t pinned = slot->epoch.load();
+            if (pinned != 0 && pinned < oldest) {
+                oldest = pinned;
+            }
+        }
+
+        // Anything retired before the oldest pinned epoch is unreachable
+        auto keep = retired.begin();
+        for (auto it = retired.begin(); it != retired.end(); ++it) {
+            if (it->first < oldest) {
+                freeing.push_back(std::move(it->second));
+            } else {
+                *keep++ = std::move(*it);
+            }
+        }
+        retired.erase(keep, retired.end());
+    }
+
+    for (auto& deleter : freeing) {
+        deleter();
+    }
+    return freeing.size();
+}
+
+std::size_t Epoch::pending() const {
+    std::lock_guard<std::mutex> lock(retireMtx);
+    return retired.size();
+}
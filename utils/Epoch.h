@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Epoch-based memory reclamation for lock-free readers. A reader pins the
+// current epoch with an Epoch::Guard for the length of one lookup; memory a
+// writer unlinks is retired, and only freed once every reader pinned at the
+// time has let go. Readers never block and never touch a lock; writers pay
+// for the bookkeeping.
+class Epoch {
+    struct Slot;
+
+public:
+    static Epoch& instance();
+
+    // Pins the calling thread for its scope; nests cheaply
+    class Guard {
+    public:
+        Guard();
+        ~Guard();
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        Slot* slot;
+    };
+
+    // Free `deleter`'s memory once no pinned reader can still see it. The
+    // memory must already be unreachable for new readers.
+    void retire(std::function<void()> deleter);
+
+    // Advance the epoch and free what is now safe; returns how many
+    std::size_t collect();
+
+    std::size_t pending() const;
+
+    ~Epoch();
+
+private:
+    Epoch() = default;
+
+    // One per thread that has ever pinned; reused after the thread exits
+    struct Slot {
+        std::atomic<std::uint64_t> epoch{0};  // 0 = not pinned
+        std::atomic<bool> inUse{false};
+        int depth = 0;                        // owner thread only
+        Slot* next = nullptr;
+    };
+
+    struct SlotOwner {
+        Slot* slot = nullptr;
+        ~SlotOwner();
+    };
+
+    Slot& localSlot();
+
+    std::atomic<std::uint64_t> globalEpoch{1};
+    std::atomic<Slot*> slots{nullptr};
+
+    mutable std::mutex retireMtx;
+    std::vector<std::pair<std::uint64_t, std::function<void()>>> retired;
+};
@@ -0,0 +1,124 @@
+#include "Histogram.h"
+
+#include <cmath>
+
+// Index of the highest set bit (value > 0), without compiler intrinsics
+static int highestBit(std::uint64_t value) {
+    int bit = 0;
+    for (int step = 32; step > 0; step >>= 1) {
+        if (value >> step) {
+            value >>= step;
+            bit += step;
+        }
+    }
+    return bit;
+}
+
+std::size_t Histogram::bucketFor(std::uint64_t value) {
+    if (value > MAX_VALUE) {
+        value = MAX_VALUE;
+    }
+    if (value < 2 * SUB_BUCKETS) {
+        return static_cast<std::size_t>(value);
+    }
+    // Keep the top SUB_BUCKET_BITS + 1 bits; each power of two gets SUB_BUCKETS slots
+    const int shift = highestBit(value) - SUB_BUCKET_BITS;
+    return static_cast<std::size_t>(shift + 1) * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS);
+}
+
+std::uint64_t Histogram::bucketUpperBound(std::size_t index) {
+    if (index < 2 * SUB_BUCKETS) {
+        return index;
+    }
+    const int shift = static_cast<int>(index / SUB_BUCKETS) - 1;
+    const std::uint64_t low = (index % SUB_BUCKETS + SUB_BUCKETS) << shift;
+    return low + (1ULL << shift) - 1;
+}
+
+void Histogram::record(std::uint64_t micros) {
+    counts[bucketFor(micros)].fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(micros, std::memory_order_relaxed);
+    std::uint64_t seen = max.load(std::memory_order_relaxed);
+    while (micros > seen && !max.compare_exchange_weak(seen, micros, std::memory_order_relaxed)) {
+    }
+}
+
+void Histogram::add(const HistogramSnapshot& other) {
+    for (std::size_t i = 0; i < other.counts.size() && i < BUCKETS; ++i) {
+        if (other.counts[i] > 0) {
+            counts[i].fetch_add(other.counts[i], std::memory_order_relaxed);
+        }
+    }
+    sum.fetch_add(other.sum, std::memory_order_relaxed);
+    std::uint64_t seen = max.load(std::memory_order_relaxed);
+    while (other.max > seen && !max.compare_exchange_weak(seen, other.max, std::memory_order_relaxed)) {
+    }
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+    HistogramSnapshot result;
+    result.counts.resize(BUCKETS);
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+        result.counts[i] = counts[i].load(std::memory_order_relaxed);
+        result.count += result.counts[i];
+    }
+    result.sum = sum.load(std::memory_order_relaxed);
+    result.max = max.load(std::memory_order_relaxed);
+    return result;
+}
+
+void Histogram::accumulate(const std::uint64_t* bounds, std::size_t n, std::uint64_t* perBound,
+                           std::uint64_t& count, std::uint64_t& total) const {
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+        const std::uint64_t c = counts[i].load(std::memory_order_relaxed);
+        if (c == 0) {
+            continue;
+        }
+        // A bucket straddling a bound is reported above it, never below
+        const std::uint64_t upper = bucketUpperBound(i);
+        while (j < n && upper > bounds[j]) {
+            ++j;
+        }
+        perBound[j] += c;
+        count += c;
+    }
+    total += sum.load(std::memory_order_relaxed);
+}
+
+void HistogramSnapshot::merge(const HistogramSnapshot& other) {
+    if (counts.size() < other.counts.size()) {
+        counts.resize(other.counts.size());
+    }
+    for (std::size_t i = 0; i < other.counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+    sum += other.sum;
+    if (other.max > max) {
+        max = other.max;
+    }
+}
+
+std::uint64_t HistogramSnapshot::percentile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    auto rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count)));
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            std::uint64_t upper = Histogram::bucketUpperBound(i);
+            return upper < max ? upper : max;
+        }
+    }
+    return max;
+}
+
+double HistogramSnapshot::mean() const {
+    return count > 0 ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Point-in-time copy of a Histogram; copies from several shards merge into one
+struct HistogramSnapshot {
+    std::vector<std::uint64_t> counts;
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;  // microseconds
+    std::uint64_t max = 0;
+
+    void merge(const HistogramSnapshot& other);
+    // Value at quantile q (0..1), in microseconds: the upper edge of its
+    // bucket, capped at the largest value recorded
+    std::uint64_t percentile(double q) const;
+    double mean() const;
+};
+
+// Log-linear (HDR-style) histogram of microsecond values: exact below 64,
+// then 32 linear sub-buckets per power of two, so any value is reported
+// within about 3%. Fixed size, no allocation after construction; recording
+// is a handful of relaxed atomic adds, and snapshot() may run concurrently.
+class Histogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr std::uint64_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+    static constexpr int MAX_BITS = 40;  // values above ~12.7 days are clamped
+    static constexpr std::uint64_t MAX_VALUE = (1ULL << MAX_BITS) - 1;
+    static constexpr std::size_t BUCKETS = (MAX_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    void record(std::uint64_t micros);
+    // Add recorded counts (e.g. of a retired shard) to this histogram
+    void add(const HistogramSnapshot& other);
+    HistogramSnapshot snapshot() const;
+
+    // Add this histogram's counts into fixed, ascending buckets without
+    // copying it: perBound[j] gets values whose bucket fits under bounds[j],
+    // perBound[n] the rest. Non-cumulative, so shards can be summed.
+    void accumulate(const std::uint64_t* bounds, std::size_t n, std::uint64_t* perBound,
+                    std::uint64_t& count, std::uint64_t& sum) const;
+
+    static std::size_t bucketFor(std::uint64_t value);
+    static std::uint64_t bucketUpperBound(std::size_t index);
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKETS> counts{};
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> max{0};
+};
@@ -1,5 +1,6 @@
 #include "Metrics.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "Logger.h"
@@ -9,6 +10,169 @@ Metrics& Metrics::instance() {
     return instance;
 }
 
+void LatencyHistograms::merge(const LatencyHistograms& other) {
+    wait.merge(other.wait);
+    exec.merge(other.exec);
+    endToEnd.merge(other.endToEnd);
+}
+
+static const char* priorityName(int priority) {
+    switch (priority) {
+        case static_cast<int>(TaskPriority::HIGH): return "HIGH";
+        case static_cast<int>(TaskPriority::LOW): return "LOW";
+        default: return "MEDIUM";
+    }
+}
+
+static std::uint64_t toMicros(std::chrono::steady_clock::duration d) {
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    return micros > 0 ? static_cast<std::uint64_t>(micros) : 0;
+}
+
+Metrics::LatencyShard& Metrics::localShard() {
+    // Registered on the thread's first recording; folded into retiredShard
+    // when the thread exits so shards of finished pools don't pile up
+    struct Owner {
+        std::shared_ptr<LatencyShard> shard = std::make_shared<LatencyShard>();
+        Owner() {
+            std::lock_guard<std::mutex> lock(Metrics::instance().shardsMtx);
+            Metrics::instance().shards.push_back(shard);
+        }
+        ~Owner() { Metrics::instance().retireShard(shard); }
+    };
+    thread_local Owner owner;
+    return *owner.shard;
+}
+
+// Sums other into this; callers keep either side from changing meanwhile
+void Metrics::DurationTotals::merge(const DurationTotals& other) {
+    const auto relaxed = std::memory_order_relaxed;
+    const std::uint64_t otherExec = other.execSamples.load(relaxed);
+    if (otherExec > 0) {
+        const bool first = execSamples.load(relaxed) == 0;
+        minExecNs.store(first ? other.minExecNs.load(relaxed)
+                              : std::min(minExecNs.load(relaxed), other.minExecNs.load(relaxed)), relaxed);
+        maxExecNs.store(first ? other.maxExecNs.load(relaxed)
+                              : std::max(maxExecNs.load(relaxed), other.maxExecNs.load(relaxed)), relaxed);
+        execSamples.fetch_add(otherExec, relaxed);
+        waitNs.fetch_add(other.waitNs.load(relaxed), relaxed);
+        execNs.fetch_add(other.execNs.load(relaxed), relaxed);
+    }
+    const std::uint64_t otherDeadlines = other.deadlineTasks.load(relaxed);
+    if (otherDeadlines > 0) {
+        const bool first = deadlineTasks.load(relaxed) == 0;
+        minSlackNs.store(first ? other.minSlackNs.load(relaxed)
+                               : std::min(minSlackNs.load(relaxed), other.minSlackNs.load(relaxed)), relaxed);
+        deadlineTasks.fetch_add(otherDeadlines, relaxed);
+        slackNs.fetch_add(other.slackNs.load(relaxed), relaxed);
+    }
+}
+
+void Metrics::retireShard(const std::shared_ptr<LatencyShard>& shard) {
+    std::lock_guard<std::mutex> lock(shardsMtx);
+    shards.erase(std::remove(shards.begin(), shards.end(), shard), shards.end());
+
+    std::lock_guard<std::mutex> shardLock(shard->mtx);
+    retiredShard.totals.merge(shard->totals);
+    if (retiredShard.byKey.size() < shard->byKey.size()) {
+        retiredShard.byKey.resize(shard->byKey.size());
+    }
+    for (std::size_t i = 0; i < shard->byKey.size(); ++i) {
+        for (std::size_t p = 0; p < shard->byKey[i].size(); ++p) {
+            const MetricsSeries* series = shard->byKey[i][p].get();
+            if (!series) {
+                continue;
+            }
+            auto& retired = retiredShard.byKey[i][p];
+            if (!retired) {
+                retired = std::make_unique<MetricsSeries>(series->key);
+            }
+            retired->wait.add(series->wait.snapshot());
+            retired->exec.add(series->exec.snapshot());
+            retired->endToEnd.add(series->endToEnd.snapshot());
+            retired->completed += series->completed.load(std::memory_order_relaxed);
+            retired->failed += series->failed.load(std::memory_order_relaxed);
+            retired->retries += series->retries.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+static LatencyHistograms latencyOf(const MetricsSeries& series) {
+    LatencyHistograms slice;
+    slice.wait = series.wait.snapshot();
+    slice.exec = series.exec.snapshot();
+    slice.endToEnd = series.endToEnd.snapshot();
+    return slice;
+}
+
+LatencyReport Metrics::getLatencyReport() const {
+    LatencyReport report;
+    forEachSeries([&report](const MetricsSeries& series, TaskPriority priority) {
+        const LatencyHistograms slice = latencyOf(series);
+        const std::string& type = series.key->type;
+        report.byType[type.empty() ? "untyped" : type].merge(slice);
+        report.byPriority[priorityName(static_cast<int>(priority))].merge(slice);
+        report.overall.merge(slice);
+    });
+    return report;
+}
+
+KeyBreakdown Metrics::getKeyBreakdown() const {
+    // One slot per key index and priority, summed over the shards
+    std::vector<KeyMetrics> slots;
+    forEachSeries([&slots](const MetricsSeries& series, TaskPriority priority) {
+        const std::size_t slot = series.key->index * 3 + static_cast<std::size_t>(priority);
+        if (slots.size() <= slot) {
+            slots.resize(slot + 1);
+        }
+        KeyMetrics& metrics = slots[slot];
+        metrics.type = series.key->type;
+        metrics.tenant = series.key->tenant;
+        metrics.priority = priority;
+        metrics.completed += series.completed.load(std::memory_order_relaxed);
+        metrics.failed += series.failed.load(std::memory_order_relaxed);
+        metrics.retries += series.retries.load(std::memory_order_relaxed);
+        metrics.latency.merge(latencyOf(series));
+    });
+
+    KeyBreakdown breakdown;
+    for (auto& metrics : slots) {
+        if (metrics.latency.exec.count > 0) {
+            breakdown.keys.push_back(std::move(metrics));
+        }
+    }
+    std::lock_guard<std::mutex> lock(keysMtx);
+    breakdown.distinctKeys = keys.size();
+    breakdown.maxKeys = maxKeys;
+    breakdown.overflowed = overflowedKeys;
+    return breakdown;
+}
+
+const MetricsKey* Metrics::resolveKey(const std::string& type, const std::string& tenant) {
+    std::lock_guard<std::mutex> lock(keysMtx);
+    auto found = keys.find({type, tenant});
+    if (found != keys.end()) {
+        return found->second.get();
+    }
+    if (maxKeys > 0 && keys.size() >= maxKeys) {
+        // Unbounded labels (e.g. a type per customer) must not grow memory
+        // or scrape size without limit; the excess is reported as one key
+        ++overflowedKeys;
+        if (!overflowKey) {
+            overflowKey.reset(new MetricsKey{nextKeyIndex++, OVERFLOW_LABEL, OVERFLOW_LABEL});
+        }
+        return overflowKey.get();
+    }
+    auto& key = keys[{type, tenant}];
+    key.reset(new MetricsKey{nextKeyIndex++, type, tenant});
+    return key.get();
+}
+
+void Metrics::setMaxKeys(std::size_t limit) {
+    std::lock_guard<std::mutex> lock(keysMtx);
+    maxKeys = limit;
+}
+
 void Metrics::recordTask(const Task& task) {
     using namespace std::chrono;
 
@@ -24,70 +188,218 @@ void Metrics::recordTask(const Task& task) {
 
     const auto waitTime = startTime - enqueueTime;
     const auto execTime = endTime - startTime;
+    const auto readyTime = task.getReadyTime();
 
-    std::lock_guard<std::mutex> lock(mtx);
+    // Series go to this thread's shard, indexed by the pre-resolved key;
+    // no string hashing and no shared lock on this path
+    const MetricsKey* key = task.getMetricsKey();
+    if (!key) {
+        key = resolveKey(task.getType(), task.getTenant());
+    }
+    LatencyShard& shard = localShard();
+    const auto priority = static_cast<std::size_t>(task.getPriority());
+    MetricsSeries* series = key->index < shard.byKey.size() ? shard.byKey[key->index][priority].get() : nullptr;
+    if (!series) {
+        std::lock_guard<std::mutex> shardLock(shard.mtx);
+        if (shard.byKey.size() <= key->index) {
+            shard.byKey.resize(key->index + 1);
+        }
+        auto& slot = shard.byKey[key->index][priority];
+        slot = std::make_unique<MetricsSeries>(key);
+        series = slot.get();
+    }
+    series->wait.record(toMicros(waitTime));
+    series->exec.record(toMicros(execTime));
+    series->endToEnd.record(toMicros(endTime - (readyTime != steady_clock::time_point() ? readyTime : enqueueTime)));
+    series->retries.fetch_add(static_cast<std::uint64_t>(task.getRetryCount()), std::memory_order_relaxed);
+    if (task.getState() == TaskState::COMPLETED) {
+        series->completed.fetch_add(1, std::memory_order_relaxed);
+    } else if (task.getState() == TaskState::FAILED) {
+        series->failed.fetch_add(1, std::memory_order_relaxed);
+    }
 
-    ++totalTasks;
-    totalRetries += static_cast<std::uint64_t>(task.getRetryCount());
+    totalTasks.fetch_add(1, std::memory_order_relaxed);
+    totalRetries.fetch_add(static_cast<std::uint64_t>(task.getRetryCount()), std::memory_order_relaxed);
     if (task.getState() == TaskState::COMPLETED) {
-        ++completedTasks;
+        completedTasks.fetch_add(1, std::memory_order_relaxed);
+        completedWindow.add();
     } else if (task.getState() == TaskState::FAILED) {
-        ++failedTasks;
-        ++failedFinalTasks;
+        failedTasks.fetch_add(1, std::memory_order_relaxed);
+        failedWindow.add();
     }
 
-    totalWaitTime += waitTime;
-    totalExecTime += execTime;
+    // Duration aggregates too: only this thread writes its shard's totals
+    const auto relaxed = std::memory_order_relaxed;
+    DurationTotals& totals = shard.totals;
+    const std::int64_t execNs = duration_cast<nanoseconds>(execTime).count();
+    totals.waitNs.store(totals.waitNs.load(relaxed) + duration_cast<nanoseconds>(waitTime).count(), relaxed);
+    totals.execNs.store(totals.execNs.load(relaxed) + execNs, relaxed);
+    const bool firstExec = totals.execSamples.load(relaxed) == 0;
+    if (firstExec || execNs < totals.minExecNs.load(relaxed)) totals.minExecNs.store(execNs, relaxed);
+    if (firstExec || execNs > totals.maxExecNs.load(relaxed)) totals.maxExecNs.store(execNs, relaxed);
+    totals.execSamples.store(totals.execSamples.load(relaxed) + 1, relaxed);
 
-    if (!hasExecSamples) {
-        maxExecTime = minExecTime = execTime;
-        hasExecSamples = true;
-    } else {
-        if (execTime > maxExecTime) maxExecTime = execTime;
-        if (execTime < minExecTime) minExecTime = execTime;
+    if (task.hasDeadline()) {
+        // Slack is how early the task finished; negative slack is a miss
+        const std::int64_t slackNs = duration_cast<nanoseconds>(task.getDeadline() - endTime).count();
+        const bool firstDeadline = totals.deadlineTasks.load(relaxed) == 0;
+        if (firstDeadline || slackNs < totals.minSlackNs.load(relaxed)) totals.minSlackNs.store(slackNs, relaxed);
+        totals.slackNs.store(totals.slackNs.load(relaxed) + slackNs, relaxed);
+        totals.deadlineTasks.store(totals.deadlineTasks.load(relaxed) + 1, relaxed);
+        if (slackNs < 0) {
+            deadlineMisses.fetch_add(1, relaxed);
+        }
     }
 }
 
+void Metrics::recordRejected() {
+    rejectedTasks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordThrottled() {
+    throttledTasks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordCoalesced() {
+    coalescedTasks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordCacheHit() {
+    cacheHitTasks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordCancelled() {
+    cancelledTasks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordDeadlineDemoted() {
+    deadlineDemoted.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordDeadlineDropped() {
+    deadlineDropped.fetch_add(1, std::memory_order_relaxed);
+    deadlineMisses.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordSubmitted() {
+    submittedWindow.add();
+}
+
+void Metrics::recordStarted() {
+    startedWindow.add();
+}
+
+void Metrics::recordRetry() {
+    retriedWindow.add();
+}
+
+static WindowRates ratesOf(const RateWindow& window, RateWindow::Clock::time_point now) {
+    using std::chrono::minutes;
+    WindowRates rates;
+    rates.oneMinute = window.rate(minutes(1), now);
+    rates.fiveMinutes = window.rate(minutes(5), now);
+    rates.fifteenMinutes = window.rate(minutes(15), now);
+    return rates;
+}
+
+ThroughputRates Metrics::getRates() const {
+    const auto now = RateWindow::Clock::now();
+    ThroughputRates rates;
+    rates.submitted = ratesOf(submittedWindow, now);
+    rates.started = ratesOf(startedWindow, now);
+    rates.completed = ratesOf(completedWindow, now);
+    rates.failed = ratesOf(failedWindow, now);
+    rates.retried = ratesOf(retriedWindow, now);
+    return rates;
+}
+
+MetricsCounters Metrics::getCounters() const {
+    MetricsCounters c;
+    c.executed = totalTasks.load(std::memory_order_relaxed);
+    c.completed = completedTasks.load(std::memory_order_relaxed);
+    c.failed = failedTasks.load(std::memory_order_relaxed);
+    c.retries = totalRetries.load(std::memory_order_relaxed);
+    c.rejected = rejectedTasks.load(std::memory_order_relaxed);
+    c.throttled = throttledTasks.load(std::memory_order_relaxed);
+    c.coalesced = coalescedTasks.load(std::memory_order_relaxed);
+    c.cacheHits = cacheHitTasks.load(std::memory_order_relaxed);
+    c.cancelled = cancelledTasks.load(std::memory_order_relaxed);
+    c.deadlineMisses = deadlineMisses.load(std::memory_order_relaxed);
+    c.deadlineDemoted = deadlineDemoted.load(std::memory_order_relaxed);
+    c.deadlineDropped = deadlineDropped.load(std::memory_order_relaxed);
+    return c;
+}
+
 void Metrics::printSummary() const {
     using namespace std::chrono;
 
-    std::lock_guard<std::mutex> lock(mtx);
+    const MetricsCounters counters = getCounters();
+    DurationTotals totals;
+    {
+        std::lock_guard<std::mutex> lock(shardsMtx);
+        for (const auto& shard : shards) {
+            totals.merge(shard->totals);
+        }
+        totals.merge(retiredShard.totals);
+    }
 
-    if (totalTasks == 0) {
+    if (counters.executed == 0) {
         Logger::info("===== METRICS SUMMARY =====");
         Logger::info("No tasks were executed.");
         Logger::info("===========================");
         return;
     }
 
-    const auto avgWaitMs =
-        duration_cast<microseconds>(totalWaitTime).count() /
-        (1000.0 * static_cast<double>(totalTasks));
-
-    const auto avgExecMs =
-        duration_cast<microseconds>(totalExecTime).count() /
-        (1000.0 * static_cast<double>(totalTasks));
-
-    const auto maxExecMs =
-        hasExecSamples
-            ? duration_cast<microseconds>(maxExecTime).count() / 1000.0
-            : 0.0;
-
-    const auto minExecMs =
-        hasExecSamples
-            ? duration_cast<microseconds>(minExecTime).count() / 1000.0
-            : 0.0;
+    const auto toMs = [](std::int64_t ns) { return static_cast<double>(ns) / 1e6; };
+    const std::uint64_t execSamples = totals.execSamples.load();
+    const auto avgWaitMs = toMs(totals.waitNs.load()) / static_cast<double>(counters.executed);
+    const auto avgExecMs = toMs(totals.execNs.load()) / static_cast<double>(counters.executed);
+    const auto maxExecMs = execSamples > 0 ? toMs(totals.maxExecNs.load()) : 0.0;
+    const auto minExecMs = execSamples > 0 ? toMs(totals.minExecNs.load()) : 0.0;
 
     std::cout << "===== METRICS SUMMARY =====\n";
-    std::cout << "Tasks Executed   : " << totalTasks << "\n";
-    std::cout << "Completed        : " << completedTasks << "\n";
-    std::cout << "Failed           : " << failedTasks << "\n";
-    std::cout << "Total Retries    : " << totalRetries << "\n\n";
+    std::cout << "Tasks Executed   : " << counters.executed << "\n";
+    std::cout << "Completed        : " << counters.completed << "\n";
+    std::cout << "Failed           : " << counters.failed << "\n";
+    std::cout << "Rejected         : " << counters.rejected << "\n";
+    std::cout << "Throttled        : " << counters.throttled << "\n";
+    std::cout << "Coalesced        : " << counters.coalesced << "\n";
+    std::cout << "Cache hits       : " << counters.cacheHits << "\n";
+    std::cout << "Cancelled        : " << counters.cancelled << "\n";
+    std::cout << "Total Retries    : " << counters.retries << "\n\n";
 
     std::cout << "Avg Wait Time    : " << avgWaitMs << " ms\n";
     std::cout << "Avg Exec Time    : " << avgExecMs << " ms\n";
     std::cout << "Max Exec Time    : " << maxExecMs << " ms\n";
     std::cout << "Min Exec Time    : " << minExecMs << " ms\n";
+
+    // Averages hide the tail; percentiles come from the latency histograms
+    const LatencyReport latency = getLatencyReport();
+    auto printPercentiles = [](const char* label, const HistogramSnapshot& h) {
+        std::cout << label << "p50 " << h.percentile(0.50) / 1000.0
+                  << " / p90 " << h.percentile(0.90) / 1000.0
+                  << " / p99 " << h.percentile(0.99) / 1000.0
+                  << " / p99.9 " << h.percentile(0.999) / 1000.0 << " ms\n";
+    };
+    std::cout << "\n";
+    printPercentiles("Wait Latency     : ", latency.overall.wait);
+    printPercentiles("Exec Latency     : ", latency.overall.exec);
+    printPercentiles("End-to-End       : ", latency.overall.endToEnd);
+
+    const std::uint64_t deadlineTasks = totals.deadlineTasks.load();
+    if (deadlineTasks > 0 || counters.deadlineDropped > 0) {
+        const auto avgSlackMs =
+            deadlineTasks > 0 ? toMs(totals.slackNs.load()) / static_cast<double>(deadlineTasks) : 0.0;
+        const auto minSlackMs = toMs(totals.minSlackNs.load());
+
+        std::cout << "\n";
+        std::cout << "Deadline Tasks   : " << deadlineTasks << "\n";
+        std::cout << "Deadline Misses  : " << counters.deadlineMisses << "\n";
+        std::cout << "Demoted (late)   : " << counters.deadlineDemoted << "\n";
+        std::cout << "Dropped (late)   : " << counters.deadlineDropped << "\n";
+        std::cout << "Avg Slack        : " << avgSlackMs << " ms\n";
+        std::cout << "Min Slack        : " << minSlackMs << " ms\n";
+    }
     std::cout << "===========================\n";
 }
 
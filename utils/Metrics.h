@@ -1,34 +1,239 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <mutex>
 #include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "../src/core/Task.h"
+#include "Histogram.h"
+#include "RateWindow.h"
+
+// Merged latency histograms for one slice of tasks
+struct LatencyHistograms {
+    HistogramSnapshot wait;      // READY -> started (last attempt)
+    HistogramSnapshot exec;      // started -> finished
+    HistogramSnapshot endToEnd;  // first READY -> finished, across retries
+
+    void merge(const LatencyHistograms& other);
+};
+
+struct LatencyReport {
+    LatencyHistograms overall;
+    std::map<std::string, LatencyHistograms> byPriority;  // "HIGH", "MEDIUM", "LOW"
+    std::map<std::string, LatencyHistograms> byType;
+};
+
+// (type, tenant) pair that metrics are broken down by, resolved once per
+// task so recording indexes by number instead of hashing strings. Keys are
+// never freed: a handle stays valid for the life of the process.
+struct MetricsKey {
+    std::size_t index;
+    std::string type;
+    std::string tenant;
+};
+
+// Histograms and outcome counters of one key and priority, as recorded by
+// one thread. Relaxed atomics: readable while the owner records.
+struct MetricsSeries {
+    explicit MetricsSeries(const MetricsKey* key) : key(key) {}
+
+    const MetricsKey* key;
+    Histogram wait;      // READY -> started (last attempt)
+    Histogram exec;      // started -> finished
+    Histogram endToEnd;  // first READY -> finished, across retries
+    std::atomic<std::uint64_t> completed{0};
+    std::atomic<std::uint64_t> failed{0};   // after the last retry
+    std::atomic<std::uint64_t> retries{0};
+};
+
+// Merged metrics of one (type, tenant, priority)
+struct KeyMetrics {
+    std::string type;
+    std::string tenant;
+    TaskPriority priority = TaskPriority::MEDIUM;
+    std::uint64_t completed = 0;
+    std::uint64_t failed = 0;
+    std::uint64_t retries = 0;
+    LatencyHistograms latency;
+};
+
+struct KeyBreakdown {
+    std::vector<KeyMetrics> keys;  // by key, then priority; only keys with samples
+    std::size_t distinctKeys = 0;  // resolved (type, tenant) pairs, overflow key excluded
+    std::size_t maxKeys = 0;
+    std::uint64_t overflowed = 0;  // resolutions folded into the overflow key
+};
+
+// Point-in-time values of the monotonic task counters
+struct MetricsCounters {
+    std::uint64_t executed = 0;
+    std::uint64_t completed = 0;
+    std::uint64_t failed = 0;
+    std::uint64_t retries = 0;
+    std::uint64_t rejected = 0;
+    std::uint64_t throttled = 0;
+    std::uint64_t coalesced = 0;
+    std::uint64_t cacheHits = 0;
+    std::uint64_t cancelled = 0;
+    std::uint64_t deadlineMisses = 0;
+    std::uint64_t deadlineDemoted = 0;
+    std::uint64_t deadlineDropped = 0;
+};
+
+// Events per second over the trailing 1, 5 and 15 minutes
+struct WindowRates {
+    double oneMinute = 0.0;
+    double fiveMinutes = 0.0;
+    double fifteenMinutes = 0.0;
+};
+
+struct ThroughputRates {
+    WindowRates submitted;
+    WindowRates started;    // attempts, retries included
+    WindowRates completed;
+    WindowRates failed;     // after the last retry
+    WindowRates retried;
+};
 
 class Metrics {
 public:
     static Metrics& instance();
 
+    // Type and tenant past this many distinct pairs share one overflow key
+    static constexpr const char* OVERFLOW_LABEL = "__other__";
+
+    // Handle for a task's (type, tenant); the same pointer for the same pair.
+    // Hashes and may lock: call at submission, not per recording.
+    const MetricsKey* resolveKey(const std::string& type, const std::string& tenant);
+    // Cap on distinct keys (0 = no cap); keys already resolved are kept
+    void setMaxKeys(std::size_t maxKeys);
+
+    // Uses the task's pre-resolved key, resolving it here only if unset
     void recordTask(const Task& task);
     void printSummary() const;
 
+    // Latency percentiles, merged from every recording thread's shard
+    LatencyReport getLatencyReport() const;
+
+    // Counts, failures, retries and latency per (type, tenant, priority)
+    KeyBreakdown getKeyBreakdown() const;
+
+    // Lock-free read of the counters, for scrapers that poll often
+    MetricsCounters getCounters() const;
+
+    // Visit the live series of every shard without copying them:
+    // visit(series, priority). A key and priority can be visited once per
+    // recording thread; callers sum the visits. Shard locks are held during
+    // the visit, so keep it short.
+    template <typename Visit>
+    void forEachSeries(Visit&& visit) const {
+        auto visitShard = [&visit](const LatencyShard& shard) {
+            for (const auto& perPriority : shard.byKey) {
+                for (std::size_t p = 0; p < perPriority.size(); ++p) {
+                    if (perPriority[p]) {
+                        visit(*perPriority[p], static_cast<TaskPriority>(p));
+                    }
+                }
+            }
+        };
+        std::lock_guard<std::mutex> lock(shardsMtx);
+        for (const auto& shard : shards) {
+            std::lock_guard<std::mutex> shardLock(shard->mtx);
+            visitShard(*shard);
+        }
+        visitShard(retiredShard);
+    }
+
+    // Deadline accounting for tasks the scheduler gave up on before running
+    void recordDeadlineDemoted();
+    void recordDeadlineDropped();
+
+    // Windowed only: submissions, attempts started and retries scheduled
+    void recordSubmitted();
+    void recordStarted();
+    void recordRetry();
+    // Current throughput, unlike the lifetime totals
+    ThroughputRates getRates() const;
+
+    // Tasks shed by overload control (state REJECTED)
+    void recordRejected();
+
+    // Tasks parked by a rate limit before being queued
+    void recordThrottled();
+
+    // Submits coalesced into an identical pending task
+    void recordCoalesced();
+    // Submits completed from the result cache without running
+    void recordCacheHit();
+    // Queued tasks withdrawn before running
+    void recordCancelled();
+
 private:
     Metrics() = default;
 
-    mutable std::mutex mtx;
+    // Duration aggregates in nanoseconds. A shard's are written only by its
+    // owner (relaxed, no lock); printSummary sums them across shards
+    struct DurationTotals {
+        std::atomic<std::int64_t> waitNs{0};
+        std::atomic<std::int64_t> execNs{0};
+        std::atomic<std::uint64_t> execSamples{0};
+        std::atomic<std::int64_t> minExecNs{0};
+        std::atomic<std::int64_t> maxExecNs{0};
+        std::atomic<std::uint64_t> deadlineTasks{0};
+        std::atomic<std::int64_t> slackNs{0};
+        std::atomic<std::int64_t> minSlackNs{0};
+
+        void merge(const DurationTotals& other);
+    };
+
+    // Series of one recording thread, by MetricsKey::index then priority.
+    // Only the owner records and adds series (adding under mtx); readers lock mtx
+    struct LatencyShard {
+        std::mutex mtx;
+        std::vector<std::array<std::unique_ptr<MetricsSeries>, 3>> byKey;
+        DurationTotals totals;
+    };
+
+    LatencyShard& localShard();
+    // Fold an exiting thread's shard into retiredShard
+    void retireShard(const std::shared_ptr<LatencyShard>& shard);
+
+    mutable std::mutex shardsMtx;
+    std::vector<std::shared_ptr<LatencyShard>> shards;
+    LatencyShard retiredShard;  // under shardsMtx
 
-    std::uint64_t totalTasks = 0;
-    std::uint64_t completedTasks = 0;
-    std::uint64_t failedTasks = 0;
-    std::uint64_t totalRetries = 0;
-    std::uint64_t failedFinalTasks = 0;
+    mutable std::mutex keysMtx;
+    std::map<std::pair<std::string, std::string>, std::unique_ptr<MetricsKey>> keys;
+    std::unique_ptr<MetricsKey> overflowKey;  // created on the first overflow
+    std::size_t nextKeyIndex = 0;
+    std::size_t maxKeys = 1000;
+    std::uint64_t overflowedKeys = 0;
 
-    std::chrono::steady_clock::duration totalWaitTime{};
-    std::chrono::steady_clock::duration totalExecTime{};
+    // Counters are bumped without a lock so scrapes never wait on recording
+    std::atomic<std::uint64_t> totalTasks{0};
+    std::atomic<std::uint64_t> completedTasks{0};
+    std::atomic<std::uint64_t> failedTasks{0};
+    std::atomic<std::uint64_t> totalRetries{0};
+    std::atomic<std::uint64_t> rejectedTasks{0};
+    std::atomic<std::uint64_t> throttledTasks{0};
+    std::atomic<std::uint64_t> coalescedTasks{0};
+    std::atomic<std::uint64_t> cacheHitTasks{0};
+    std::atomic<std::uint64_t> cancelledTasks{0};
+    std::atomic<std::uint64_t> deadlineMisses{0};
+    std::atomic<std::uint64_t> deadlineDemoted{0};
+    std::atomic<std::uint64_t> deadlineDropped{0};
 
-    std::chrono::steady_clock::duration maxExecTime{};
-    std::chrono::steady_clock::duration minExecTime{};
-    bool hasExecSamples = false;
+    // 1-second buckets covering the longest (15 minute) window
+    RateWindow submittedWindow;
+    RateWindow startedWindow;
+    RateWindow completedWindow;
+    RateWindow failedWindow;
+    RateWindow retriedWindow;
 };
 
 
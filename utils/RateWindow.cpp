@@ -0,0 +1,61 @@
+#include "RateWindow.h"
+
+RateWindow::RateWindow(Clock::duration bucketWidth, std::size_t buckets, Clock::time_point origin)
+    : width(bucketWidth > Clock::duration::zero() ? bucketWidth : std::chrono::seconds(1)),
+      origin(origin),
+      slots(buckets > 0 ? buckets : 1) {}
+
+std::uint64_t RateWindow::epochAt(Clock::time_point now) const {
+    return now > origin ? static_cast<std::uint64_t>((now - origin) / width) : 0;
+}
+
+std::uint64_t RateWindow::bucketsIn(Clock::duration window) const {
+    auto buckets = static_cast<std::uint64_t>((window + width - Clock::duration(1)) / width);
+    if (buckets < 1) buckets = 1;
+    if (buckets > slots.size()) buckets = slots.size();
+    return buckets;
+}
+
+void RateWindow::add(std::uint64_t n, Clock::time_point now) {
+    const std::uint64_t epoch = epochAt(now) & EPOCH_MASK;
+    std::atomic<std::uint64_t>& slot = slots[epoch % slots.size()];
+    std::uint64_t seen = slot.load(std::memory_order_relaxed);
+    std::uint64_t next;
+    do {
+        const std::uint64_t seenEpoch = seen >> COUNT_BITS;
+        // A bucket already moved on by a slightly later clock reading keeps
+        // its epoch; only a bucket from an earlier lap is restarted
+        const std::uint64_t ahead = (seenEpoch - epoch) & EPOCH_MASK;
+        if (seenEpoch == epoch || ahead < slots.size()) {
+            next = seen + n;
+        } else {
+            next = (epoch << COUNT_BITS) | (n & COUNT_MASK);
+        }
+    } while (!slot.compare_exchange_weak(seen, next, std::memory_order_relaxed));
+}
+
+std::uint64_t RateWindow::count(Clock::duration window, Clock::time_point now) const {
+    const std::uint64_t current = epochAt(now);
+    const std::uint64_t buckets = bucketsIn(window);
+    std::uint64_t total = 0;
+    for (std::uint64_t i = 0; i < buckets && i <= current; ++i) {
+        const std::uint64_t epoch = (current - i) & EPOCH_MASK;
+        const std::uint64_t value = slots[epoch % slots.size()].load(std::memory_order_relaxed);
+        if ((value >> COUNT_BITS) == epoch) {
+            total += value & COUNT_MASK;
+        }
+    }
+    return total;
+}
+
+double RateWindow::rate(Clock::duration window, Clock::time_point now) const {
+    // Whole buckets before the current one, plus the current one so far
+    const std::uint64_t buckets = bucketsIn(window);
+    Clock::duration covered = width * static_cast<Clock::rep>(buckets - 1) +
+                              (now > origin ? (now - origin) % width : Clock::duration::zero());
+    if (now - origin < covered) {
+        covered = now - origin;
+    }
+    const double seconds = std::chrono::duration<double>(covered).count();
+    return seconds > 0.0 ? static_cast<double>(count(window, now)) / seconds : 0.0;
+}
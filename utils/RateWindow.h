@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Event counter over a sliding window: a ring of fixed-width buckets, each
+// one atomic word holding the bucket's epoch (high bits) and its count (low
+// bits). add() is a CAS that restarts a bucket left over from an earlier lap,
+// so there is no lock and no background rotation. Reads sum the buckets of
+// the window, the current partial one included.
+class RateWindow {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RateWindow(Clock::duration bucketWidth = std::chrono::seconds(1),
+                        std::size_t buckets = 900,
+                        Clock::time_point origin = Clock::now());
+
+    void add(std::uint64_t n = 1, Clock::time_point now = Clock::now());
+
+    // Events in the last `window`, rounded up to whole buckets
+    std::uint64_t count(Clock::duration window, Clock::time_point now = Clock::now()) const;
+    // Events per second over the last `window`; right after creation only
+    // the time elapsed so far counts, so early rates are not diluted
+    double rate(Clock::duration window, Clock::time_point now = Clock::now()) const;
+
+private:
+    static constexpr int COUNT_BITS = 40;
+    static constexpr std::uint64_t COUNT_MASK = (1ULL << COUNT_BITS) - 1;
+    static constexpr std::uint64_t EPOCH_MASK = (1ULL << (64 - COUNT_BITS)) - 1;
+
+    std::uint64_t epochAt(Clock::time_point now) const;
+    std::uint64_t bucketsIn(Clock::duration window) const;
+
+    Clock::duration width;
+    Clock::time_point origin;
+    std::vector<std::atomic<std::uint64_t>> slots;
+};
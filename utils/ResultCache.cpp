@@ -0,0 +1,178 @@
+#include "ResultCache.h"
+
+#include <algorithm>
+#include <functional>
+
+ResultCache& ResultCache::instance() {
+    static ResultCache cache;
+    return cache;
+}
+
+void ResultCache::FrequencySketch::resize(std::size_t capacity) {
+    std::size_t width = 16;
+    while (width < capacity * 2) {
+        width <<= 1;
+    }
+    for (auto& row : rows) {
+        row.assign(width, 0);
+    }
+    mask = width - 1;
+    additions = 0;
+    sampleSize = std::max<std::size_t>(capacity * 10, 16);
+}
+
+std::size_t ResultCache::FrequencySketch::indexOf(std::size_t hash, int row) const {
+    // Derive each row's slot from one hash with a per-row odd multiplier
+    static const std::uint64_t seeds[4] = {
+        0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL,
+        0x165667B19E3779F9ULL, 0x27D4EB2F165667C5ULL};
+    std::uint64_t h = (static_cast<std::uint64_t>(hash) + seeds[row]) * seeds[(row + 1) % 4];
+    return static_cast<std::size_t>(h >> 32) & mask;
+}
+
+void ResultCache::FrequencySketch::increment(const std::string& key) {
+    if (mask == 0) {
+        return;
+    }
+    std::size_t hash = std::hash<std::string>()(key);
+    for (int row = 0; row < 4; ++row) {
+        auto& counter = rows[row][indexOf(hash, row)];
+        if (counter < 15) {
+            ++counter;
+        }
+    }
+    // Aging: halve everything periodically so old popularity fades
+    if (++additions >= sampleSize) {
+        for (auto& r : rows) {
+            for (auto& counter : r) {
+                counter >>= 1;
+            }
+        }
+        additions /= 2;
+    }
+}
+
+int ResultCache::FrequencySketch::estimate(const std::string& key) const {
+    if (mask == 0) {
+        return 0;
+    }
+    std::size_t hash = std::hash<std::string>()(key);
+    int lowest = 15;
+    for (int row = 0; row < 4; ++row) {
+        lowest = std::min<int>(lowest, rows[row][indexOf(hash, row)]);
+    }
+    return lowest;
+}
+
+void ResultCache::FrequencySketch::clear() {
+    for (auto& row : rows) {
+        std::fill(row.begin(), row.end(), 0);
+    }
+    additions = 0;
+}
+
+void ResultCache::configure(std::size_t capacity, std::chrono::milliseconds ttl,
+                            const std::set<std::string>& deterministicTypes) {
+    std::lock_guard<std::mutex> lock(mtx);
+    this->capacity = capacity;
+    this->ttl = ttl;
+    this->deterministicTypes = deterministicTypes;
+    while (lru.size() > capacity) {
+        evict(std::prev(lru.end()));
+    }
+    sketch.resize(capacity);
+}
+
+bool ResultCache::isCacheable(const Task& task) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return capacity > 0 && deterministicTypes.count(task.getType()) > 0;
+}
+
+std::string ResultCache::keyFor(const Task& task) {
+    return task.getType() + "#" + std::to_string(task.getParamsHash());
+}
+
+std::size_t ResultCache::entryBytes(const Entry& entry) {
+    // Key is stored twice (list entry and index)
+    return 2 * entry.key.size() + entry.value.size() + sizeof(Entry) +
+           sizeof(std::list<Entry>::iterator);
+}
+
+// Caller must hold mtx
+void ResultCache::evict(std::list<Entry>::iterator it) {
+    stats.bytes -= entryBytes(*it);
+    index.erase(it->key);
+    lru.erase(it);
+    stats.entries = lru.size();
+}
+
+std::optional<std::string> ResultCache::get(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (capacity == 0) {
+        return std::nullopt;
+    }
+    sketch.increment(key);
+
+    auto it = index.find(key);
+    if (it == index.end()) {
+        ++stats.misses;
+        return std::nullopt;
+    }
+    if (Clock::now() >= it->second->expiresAt) {
+        evict(it->second);
+        ++stats.misses;
+        return std::nullopt;
+    }
+
+    lru.splice(lru.begin(), lru, it->second);
+    ++stats.hits;
+    return it->second->value;
+}
+
+void ResultCache::put(const std::string& key, const std::string& value) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (capacity == 0) {
+        return;
+    }
+
+    auto expiresAt = Clock::now() + ttl;
+    auto it = index.find(key);
+    if (it != index.end()) {
+        stats.bytes -= entryBytes(*it->second);
+        it->second->value = value;
+        it->second->expiresAt = expiresAt;
+        stats.bytes += entryBytes(*it->second);
+        lru.splice(lru.begin(), lru, it->second);
+        return;
+    }
+
+    if (lru.size() >= capacity) {
+        auto victim = std::prev(lru.end());
+        // An expired victim always goes; otherwise TinyLFU decides
+        if (Clock::now() < victim->expiresAt &&
+            sketch.estimate(key) <= sketch.estimate(victim->key)) {
+            ++stats.rejections;
+            return;
+        }
+        evict(victim);
+        ++stats.evictions;
+    }
+
+    lru.push_front(Entry{key, value, expiresAt});
+    index[key] = lru.begin();
+    stats.bytes += entryBytes(lru.front());
+    stats.entries = lru.size();
+}
+
+ResultCacheStats ResultCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return stats;
+}
+
+void ResultCache::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    lru.clear();
+    index.clear();
+    sketch.clear();
+    stats = ResultCacheStats();
+}
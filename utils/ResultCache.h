@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../src/core/Task.h"
+
+struct ResultCacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::uint64_t rejections = 0;  // candidates TinyLFU refused to admit
+    std::size_t entries = 0;
+    std::size_t bytes = 0;         // keys + values + per-entry overhead
+
+    double hitRatio() const {
+        auto lookups = hits + misses;
+        return lookups > 0 ? static_cast<double>(hits) / lookups : 0.0;
+    }
+};
+
+// Bounded memo cache for deterministic task types, keyed by type + params
+// hash. Entries expire after a TTL. Eviction is LRU, with TinyLFU admission:
+// when full, a new key only displaces the LRU victim if a count-min sketch
+// says it has been requested more often, so one-off keys cannot flush the
+// hot set. Values are opaque strings (task bodies in this tree return
+// nothing, so the cached value is the successful completion itself).
+class ResultCache {
+public:
+    static ResultCache& instance();
+
+    // capacity 0 disables the cache
+    void configure(std::size_t capacity, std::chrono::milliseconds ttl,
+                   const std::set<std::string>& deterministicTypes);
+
+    bool isCacheable(const Task& task) const;
+    static std::string keyFor(const Task& task);
+
+    std::optional<std::string> get(const std::string& key);
+    void put(const std::string& key, const std::string& value);
+
+    ResultCacheStats getStats() const;
+
+    // Clear entries and counters (for testing)
+    void clear();
+
+private:
+    ResultCache() = default;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::string key;
+        std::string value;
+        Clock::time_point expiresAt;
+    };
+
+    // 4-bit count-min sketch; counters halve every `sampleSize` increments
+    class FrequencySketch {
+    public:
+        void resize(std::size_t capacity);
+        void increment(const std::string& key);
+        int estimate(const std::string& key) const;
+        void clear();
+
+    private:
+        std::size_t indexOf(std::size_t hash, int row) const;
+
+        std::array<std::vector<std::uint8_t>, 4> rows;
+        std::size_t mask = 0;
+        std::size_t additions = 0;
+        std::size_t sampleSize = 0;
+    };
+
+    static std::size_t entryBytes(const Entry& entry);
+    void evict(std::list<Entry>::iterator it);
+
+    mutable std::mutex mtx;
+    std::size_t capacity = 0;
+    std::chrono::milliseconds ttl{60000};
+    std::set<std::string> deterministicTypes;
+
+    std::list<Entry> lru;  // front = most recently used
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    FrequencySketch sketch;
+    ResultCacheStats stats;
+};
@@ -0,0 +1,89 @@
+#include "RuntimeEstimator.h"
+
+#include <mutex>
+
+RuntimeEstimator& RuntimeEstimator::instance() {
+    static RuntimeEstimator estimator;
+    return estimator;
+}
+
+void RuntimeEstimator::configure(double alpha, bool perParams) {
+    std::unique_lock<std::shared_mutex> lock(mtx);
+    if (alpha > 0.0 && alpha <= 1.0) {
+        this->alpha = alpha;
+    }
+    this->perParams = perParams;
+}
+
+void RuntimeEstimator::record(const Task& task) {
+    if (task.getType().empty())
+        return;
+    if (task.getStartTime() == std::chrono::steady_clock::time_point() ||
+        task.getEndTime() == std::chrono::steady_clock::time_point())
+        return;
+
+    record(task.getType(), task.getParamsHash(), task.getEndTime() - task.getStartTime());
+}
+
+void RuntimeEstimator::record(const std::string& type, std::size_t paramsHash,
+                              std::chrono::steady_clock::duration execTime) {
+    const double sampleMs =
+        std::chrono::duration_cast<std::chrono::microseconds>(execTime).count() / 1000.0;
+
+    std::unique_lock<std::shared_mutex> lock(mtx);
+    update(byType[type], sampleMs);
+    if (perParams && paramsHash != 0) {
+        update(byParams[ParamsKey{type, paramsHash}], sampleMs);
+    }
+}
+
+// Incremental EWMA mean/variance (West, 1979)
+void RuntimeEstimator::update(RuntimeEstimate& est, double sampleMs) const {
+    if (est.samples == 0) {
+        est.meanMs = sampleMs;
+        est.varianceMs2 = 0.0;
+    } else {
+        const double diff = sampleMs - est.meanMs;
+        const double incr = alpha * diff;
+        est.meanMs += incr;
+        est.varianceMs2 = (1.0 - alpha) * (est.varianceMs2 + diff * incr);
+    }
+    ++est.samples;
+}
+
+std::chrono::steady_clock::duration RuntimeEstimator::estimate(const Task& task) const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    double meanMs = 0.0;
+
+    auto typeIt = byType.find(task.getType());
+    if (typeIt != byType.end()) {
+        meanMs = typeIt->second.meanMs;
+    }
+
+    // A specific parameter set overrides the type once it has enough history
+    if (perParams && task.getParamsHash() != 0) {
+        auto it = byParams.find(ParamsKey{task.getType(), task.getParamsHash()});
+        if (it != byParams.end() && it->second.samples >= MIN_PARAMS_SAMPLES) {
+            meanMs = it->second.meanMs;
+        }
+    }
+
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(meanMs));
+}
+
+RuntimeEstimate RuntimeEstimator::getEstimate(const std::string& type, std::size_t paramsHash) const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    if (paramsHash != 0) {
+        auto it = byParams.find(ParamsKey{type, paramsHash});
+        return it == byParams.end() ? RuntimeEstimate{} : it->second;
+    }
+    auto it = byType.find(type);
+    return it == byType.end() ? RuntimeEstimate{} : it->second;
+}
+
+void RuntimeEstimator::clear() {
+    std::unique_lock<std::shared_mutex> lock(mtx);
+    byType.clear();
+    byParams.clear();
+}
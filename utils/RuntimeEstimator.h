@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "../src/core/Task.h"
+
+// Online execution-time estimate for one task type (or type + params)
+struct RuntimeEstimate {
+    double meanMs = 0.0;      // EWMA of exec time
+    double varianceMs2 = 0.0; // exponentially weighted variance
+    std::uint64_t samples = 0;
+};
+
+// Learns per-type execution times from completed tasks.
+// Estimates are exponentially weighted so they follow workload drift.
+// Optionally also keeps estimates per (type, params hash), used once a
+// specific parameter set has enough samples of its own.
+class RuntimeEstimator {
+public:
+    static RuntimeEstimator& instance();
+
+    void configure(double alpha, bool perParams);
+
+    void record(const Task& task);
+    void record(const std::string& type, std::size_t paramsHash,
+                std::chrono::steady_clock::duration execTime);
+
+    // Best available mean for the task; zero if the type has never run
+    std::chrono::steady_clock::duration estimate(const Task& task) const;
+    RuntimeEstimate getEstimate(const std::string& type, std::size_t paramsHash = 0) const;
+
+    // Clear all estimates (for testing)
+    void clear();
+
+    static constexpr std::uint64_t MIN_PARAMS_SAMPLES = 3;
+
+private:
+    RuntimeEstimator() = default;
+
+    struct ParamsKey {
+        std::string type;
+        std::size_t paramsHash;
+        bool operator==(const ParamsKey& other) const {
+            return paramsHash == other.paramsHash && type == other.type;
+        }
+    };
+
+    struct ParamsKeyHash {
+        std::size_t operator()(const ParamsKey& key) const {
+            return std::hash<std::string>()(key.type) ^ (key.paramsHash * 0x9e3779b97f4a7c15ULL);
+        }
+    };
+
+    void update(RuntimeEstimate& est, double sampleMs) const;
+
+    mutable std::shared_mutex mtx;
+    double alpha = 0.2;
+    bool perParams = false;
+    std::unordered_map<std::string, RuntimeEstimate> byType;
+    std::unordered_map<ParamsKey, RuntimeEstimate, ParamsKeyHash> byParams;
+};
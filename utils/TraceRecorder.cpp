@@ -0,0 +1,129 @@
+#include "TraceRecorder.h"
+
+#include <algorithm>
+
+TraceRecorder& TraceRecorder::instance() {
+    static TraceRecorder instance;
+    return instance;
+}
+
+void TraceRecorder::configure(bool enable, std::size_t eventsPerThread) {
+    ringCapacity.store(eventsPerThread > 0 ? eventsPerThread : 1, std::memory_order_relaxed);
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+std::int64_t TraceRecorder::toMicros(std::chrono::steady_clock::time_point time) const {
+    if (time <= origin) {
+        return 0;
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(time - origin).count();
+}
+
+TraceRecorder::Ring& TraceRecorder::localRing() {
+    // Registered on the thread's first record; retired when the thread exits
+    struct Owner {
+        std::shared_ptr<Ring> ring;
+        Owner() {
+            TraceRecorder& recorder = TraceRecorder::instance();
+            std::lock_guard<std::mutex> lock(recorder.ringsMtx);
+            ring = std::make_shared<Ring>(recorder.nextTid++,
+                                          recorder.ringCapacity.load(std::memory_order_relaxed));
+            recorder.rings.push_back(ring);
+        }
+        ~Owner() { TraceRecorder::instance().retireRing(ring); }
+    };
+    thread_local Owner owner;
+    return *owner.ring;
+}
+
+void TraceRecorder::retireRing(const std::shared_ptr<Ring>& ring) {
+    std::lock_guard<std::mutex> lock(ringsMtx);
+    rings.erase(std::remove(rings.begin(), rings.end(), ring), rings.end());
+    retired.push_back(ring);
+    if (retired.size() > MAX_RETIRED_RINGS) {
+        retired.pop_front();
+    }
+}
+
+void TraceRecorder::recordAttempt(const Task& task, TraceOutcome outcome) {
+    if (!isEnabled()) {
+        return;
+    }
+    TraceEvent event;
+    event.taskId = task.getId();
+    event.attempt = task.getRetryCount() + 1;
+    event.priority = task.getPriority();
+    event.outcome = outcome;
+    event.key = task.getMetricsKey();
+    event.enqueueUs = toMicros(task.getEnqueueTime());
+    event.startUs = toMicros(task.getStartTime());
+    event.endUs = toMicros(task.getEndTime());
+    localRing().push(event);
+}
+
+void TraceRecorder::Ring::push(const TraceEvent& event) {
+    const std::uint64_t position = head.load(std::memory_order_relaxed);
+    Slot& slot = slots[position % capacity];
+    slot.seq.store(2 * position + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.taskId.store(event.taskId, std::memory_order_relaxed);
+    slot.attempt.store(event.attempt, std::memory_order_relaxed);
+    slot.priority.store(static_cast<std::uint8_t>(event.priority), std::memory_order_relaxed);
+    slot.outcome.store(static_cast<std::uint8_t>(event.outcome), std::memory_order_relaxed);
+    slot.key.store(event.key, std::memory_order_relaxed);
+    slot.enqueueUs.store(event.enqueueUs, std::memory_order_relaxed);
+    slot.startUs.store(event.startUs, std::memory_order_relaxed);
+    slot.endUs.store(event.endUs, std::memory_order_relaxed);
+    slot.seq.store(2 * position + 2, std::memory_order_release);
+    head.store(position + 1, std::memory_order_release);
+}
+
+void TraceRecorder::Ring::read(std::int64_t sinceUs, std::vector<TraceEvent>& out) const {
+    const std::uint64_t end = head.load(std::memory_order_acquire);
+    const std::uint64_t begin = end > capacity ? end - capacity : 0;
+    for (std::uint64_t position = begin; position < end; ++position) {
+        const Slot& slot = slots[position % capacity];
+        const std::uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq != 2 * position + 2) {
+            continue;  // overwritten by a newer lap
+        }
+        TraceEvent event;
+        event.taskId = slot.taskId.load(std::memory_order_relaxed);
+        event.attempt = slot.attempt.load(std::memory_order_relaxed);
+        event.priority = static_cast<TaskPriority>(slot.priority.load(std::memory_order_relaxed));
+        event.outcome = static_cast<TraceOutcome>(slot.outcome.load(std::memory_order_relaxed));
+        event.key = slot.key.load(std::memory_order_relaxed);
+        event.enqueueUs = slot.enqueueUs.load(std::memory_order_relaxed);
+        event.startUs = slot.startUs.load(std::memory_order_relaxed);
+        event.endUs = slot.endUs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq) {
+            continue;  // the writer lapped us mid-copy
+        }
+        if (event.endUs >= sinceUs) {
+            out.push_back(event);
+        }
+    }
+}
+
+std::vector<TraceThread> TraceRecorder::collect(std::chrono::steady_clock::duration window) const {
+    const std::int64_t sinceUs = toMicros(std::chrono::steady_clock::now() - window);
+    std::vector<TraceThread> threads;
+    auto collectRing = [&threads, sinceUs](const Ring& ring) {
+        TraceThread thread{ring.tid, {}};
+        ring.read(sinceUs, thread.events);
+        if (!thread.events.empty()) {
+            threads.push_back(std::move(thread));
+        }
+    };
+    std::lock_guard<std::mutex> lock(ringsMtx);
+    for (const auto& ring : retired) {
+        collectRing(*ring);
+    }
+    for (const auto& ring : rings) {
+        collectRing(*ring);
+    }
+    std::sort(threads.begin(), threads.end(),
+              [](const TraceThread& a, const TraceThread& b) { return a.tid < b.tid; });
+    return threads;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../src/core/Task.h"
+
+struct MetricsKey;
+
+enum class TraceOutcome : std::uint8_t { COMPLETED, FAILED, RETRIED };
+
+// One attempt of a task, as run by one worker. Times are microseconds
+// since the recorder was created.
+struct TraceEvent {
+    int taskId = 0;
+    int attempt = 1;
+    TaskPriority priority = TaskPriority::MEDIUM;
+    TraceOutcome outcome = TraceOutcome::COMPLETED;
+    const MetricsKey* key = nullptr;  // type and tenant; null if unresolved
+    std::int64_t enqueueUs = 0;
+    std::int64_t startUs = 0;
+    std::int64_t endUs = 0;
+};
+
+struct TraceThread {
+    std::uint32_t tid;  // small per-thread number, in order of first record
+    std::vector<TraceEvent> events;
+};
+
+// Opt-in execution tracing. Each recording thread owns a fixed-size ring
+// that it alone writes; readers copy it concurrently, using a per-slot
+// sequence number to skip slots being overwritten. Nothing is locked on the
+// recording path, and when tracing is off a record is one relaxed load.
+// Rings of exited threads are kept (the newest MAX_RETIRED_RINGS) so a
+// dump still shows pools that were resized or shut down.
+class TraceRecorder {
+public:
+    static constexpr std::size_t MAX_RETIRED_RINGS = 32;
+
+    static TraceRecorder& instance();
+
+    // eventsPerThread applies to threads that start recording afterwards
+    void configure(bool enabled, std::size_t eventsPerThread);
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Record the attempt that just ended on this thread, from the task's own
+    // enqueue/start/end times; call before markRetry() resets them
+    void recordAttempt(const Task& task, TraceOutcome outcome);
+
+    // Attempts that ended within the last `window`, per recording thread
+    std::vector<TraceThread> collect(std::chrono::steady_clock::duration window) const;
+
+    std::int64_t toMicros(std::chrono::steady_clock::time_point time) const;
+
+private:
+    TraceRecorder() = default;
+
+    struct Slot {
+        // 2 * position + 1 while being written, 2 * position + 2 once written
+        std::atomic<std::uint64_t> seq{0};
+        std::atomic<int> taskId{0};
+        std::atomic<int> attempt{0};
+        std::atomic<std::uint8_t> priority{0};
+        std::atomic<std::uint8_t> outcome{0};
+        std::atomic<const MetricsKey*> key{nullptr};
+        std::atomic<std::int64_t> enqueueUs{0};
+        std::atomic<std::int64_t> startUs{0};
+        std::atomic<std::int64_t> endUs{0};
+    };
+
+    struct Ring {
+        Ring(std::uint32_t tid, std::size_t capacity)
+            : tid(tid), capacity(capacity), slots(new Slot[capacity]) {}
+
+        void push(const TraceEvent& event);
+        void read(std::int64_t sinceUs, std::vector<TraceEvent>& out) const;
+
+        const std::uint32_t tid;
+        const std::size_t capacity;
+        std::unique_ptr<Slot[]> slots;
+        std::atomic<std::uint64_t> head{0};  // events ever written
+    };
+
+    Ring& localRing();
+    void retireRing(const std::shared_ptr<Ring>& ring);
+
+    const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    std::atomic<bool> enabled{false};
+    std::atomic<std::size_t> ringCapacity{16384};
+
+    mutable std::mutex ringsMtx;
+    std::vector<std::shared_ptr<Ring>> rings;
+    std::deque<std::shared_ptr<Ring>> retired;
+    std::uint32_t nextTid = 1;
+};